@@ -0,0 +1,29 @@
+#
+# Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+# Official repository: https://github.com/boostorg/url
+#
+
+# Concatenate the seed files of each grammar
+# into a single file with one URL per line.
+#
+# cmake -DSEEDS_DIR=<dir> -DCORPUS_DIR=<dir> -P corpus.cmake
+
+file(MAKE_DIRECTORY ${CORPUS_DIR})
+file(GLOB GRAMMARS RELATIVE ${SEEDS_DIR} ${SEEDS_DIR}/*)
+foreach (GRAMMAR ${GRAMMARS})
+    if (NOT IS_DIRECTORY ${SEEDS_DIR}/${GRAMMAR})
+        continue()
+    endif ()
+    set(OUT ${CORPUS_DIR}/${GRAMMAR}.txt)
+    file(WRITE ${OUT} "")
+    file(GLOB SEEDS ${SEEDS_DIR}/${GRAMMAR}/*)
+    list(SORT SEEDS)
+    foreach (SEED ${SEEDS})
+        file(READ ${SEED} CONTENTS)
+        file(APPEND ${OUT} "${CONTENTS}\n")
+    endforeach ()
+endforeach ()
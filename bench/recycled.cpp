@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+/*
+    Contention benchmark for grammar::recycled.
+
+    Usage:
+        boost_url_bench_recycled [<iterations per thread>]
+
+    Every thread repeatedly acquires a string
+    from a shared recycle bin, writes to it and
+    releases it. The library's bin is compared
+    with a list guarded by a mutex, which is how
+    recycled<T> used to be implemented, for an
+    increasing number of threads.
+*/
+
+#include <boost/url/grammar/recycled.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace grammar = boost::urls::grammar;
+
+namespace {
+
+// A recycle bin guarded by a mutex
+class mutex_bin
+{
+    struct U
+    {
+        std::string t;
+        U* next = nullptr;
+    };
+
+    std::mutex m_;
+    U* head_ = nullptr;
+
+public:
+    ~mutex_bin()
+    {
+        while(head_)
+        {
+            auto next = head_->next;
+            delete head_;
+            head_ = next;
+        }
+    }
+
+    std::string*
+    acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            if(head_)
+            {
+                U* p = head_;
+                head_ = p->next;
+                return &p->t;
+            }
+        }
+        return &(new U)->t;
+    }
+
+    void
+    release(std::string* s) noexcept
+    {
+        // t is the first member
+        U* p = reinterpret_cast<U*>(s);
+        std::lock_guard<std::mutex> lock(m_);
+        p->next = head_;
+        head_ = p;
+    }
+};
+
+volatile std::size_t sink = 0;
+
+template<class F>
+double
+run(
+    unsigned threads,
+    std::size_t iterations,
+    F const& f)
+{
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> v;
+    for(unsigned i = 0; i < threads; ++i)
+    {
+        v.emplace_back([&]
+        {
+            ++ready;
+            while(! go.load())
+                std::this_thread::yield();
+            std::size_t n = 0;
+            for(std::size_t j = 0; j < iterations; ++j)
+                n += f();
+            sink = sink + n;
+        });
+    }
+    while(ready.load() != threads)
+        std::this_thread::yield();
+    auto const start =
+        std::chrono::steady_clock::now();
+    go = true;
+    for(auto& t : v)
+        t.join();
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() -
+            start).count();
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    std::size_t iterations = 1000000;
+    if(argc > 1)
+        iterations = std::strtoul(
+            argv[1], nullptr, 10);
+    unsigned const hw = (std::max)(
+        std::thread::hardware_concurrency(), 1u);
+
+    std::printf("%-8s %14s %14s %14s %14s\n",
+        "threads", "recycled ns", "recycled Mop/s",
+        "mutex ns", "mutex Mop/s");
+
+    for(unsigned n = 1;; n *= 2)
+    {
+        if(n > hw)
+            n = hw;
+
+        static grammar::recycled<std::string> bin;
+        double const t0 = run(n, iterations,
+            []
+            {
+                grammar::recycled_ptr<std::string> p(bin);
+                p->assign("recycled");
+                return p->size();
+            });
+
+        mutex_bin mbin;
+        double const t1 = run(n, iterations,
+            [&mbin]
+            {
+                std::string* p = mbin.acquire();
+                p->assign("recycled");
+                auto const size = p->size();
+                mbin.release(p);
+                return size;
+            });
+
+        double const ops =
+            double(n) * double(iterations);
+        std::printf("%-8u %14.1f %14.1f %14.1f %14.1f\n",
+            n,
+            t0 * 1e9 * n / ops, ops / t0 / 1e6,
+            t1 * 1e9 * n / ops, ops / t1 / 1e6);
+
+        if(n == hw)
+            break;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+/*
+    Benchmark for the router in example/router.
+
+    Usage:
+        boost_url_bench_router [<resources>]
+
+    Each resource contributes four path
+    templates: a literal path, a path with
+    one and with two replacement fields, and
+    a path ending in a plus segment. The
+    requests are a shuffled mix which match
+    each kind of template, plus requests
+    which match nothing.
+*/
+
+#ifndef BOOST_URL_SOURCE
+#define BOOST_URL_SOURCE
+#endif
+
+#include "router.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace urls = boost::urls;
+
+namespace {
+
+volatile std::size_t sink = 0;
+
+double
+seconds_since(
+    std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() -
+            t0).count();
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    std::size_t resources = 1000;
+    if(argc > 1)
+        resources = std::strtoul(
+            argv[1], nullptr, 10);
+
+    std::vector<std::string> templates;
+    std::vector<std::string> requests;
+    for(std::size_t i = 0; i < resources; ++i)
+    {
+        auto const r = "res" + std::to_string(i);
+        templates.push_back("api/" + r);
+        templates.push_back("api/" + r + "/{id}");
+        templates.push_back("api/" + r + "/{id}/items/{item}");
+        templates.push_back("files/" + r + "/{path+}");
+
+        requests.push_back("/api/" + r);
+        requests.push_back("/api/" + r + "/42");
+        requests.push_back("/api/" + r + "/42/items/7");
+        requests.push_back("/files/" + r + "/a/b/c.txt");
+        requests.push_back("/api/" + r + "/42/missing");
+    }
+    std::mt19937 rng(1);
+    std::shuffle(requests.begin(), requests.end(), rng);
+
+    std::vector<urls::segments_encoded_view> paths;
+    for(auto const& s : requests)
+        paths.push_back(urls::parse_path(s).value());
+
+    urls::router<std::size_t> r;
+    auto t0 = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < templates.size(); ++i)
+        r.insert(templates[i], i);
+    double const insert_time = seconds_since(t0);
+
+    // first lookup includes any
+    // deferred preparation
+    urls::matches m;
+    t0 = std::chrono::steady_clock::now();
+    sink = sink + (r.find(paths.front(), m) != nullptr);
+    double const first_time = seconds_since(t0);
+
+    std::size_t found = 0;
+    std::size_t iters = 0;
+    t0 = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    while(elapsed < 0.5)
+    {
+        for(auto const& p : paths)
+        {
+            auto const v = r.find(p, m);
+            if(v)
+                found += *v + m.size();
+        }
+        ++iters;
+        elapsed = seconds_since(t0);
+    }
+    sink = sink + found;
+
+    std::printf("templates:    %zu\n", templates.size());
+    std::printf("insert:       %.1f ms\n", insert_time * 1e3);
+    std::printf("first lookup: %.1f us\n", first_time * 1e6);
+    std::printf("lookup:       %.1f ns\n",
+        elapsed * 1e9 / (double(iters) * double(paths.size())));
+    return EXIT_SUCCESS;
+}
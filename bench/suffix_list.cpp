@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+/*
+    Benchmark for the public suffix list
+    in example/suffix_list.
+
+    Usage:
+        boost_url_bench_suffix_list [<public_suffix_list.dat>]
+
+    The hosts are built from the rules of
+    the list, with one or two labels added
+    to the left of each rule, plus hosts
+    under unlisted suffixes. The compiled
+    list is compared with a scan of every
+    rule for each host, which is what the
+    example did before.
+
+    Loading the list from text is compared
+    with loading its binary image, as a
+    program would after mapping the file
+    written by compile_suffix_list.
+*/
+
+#include "public_suffix_list.hpp"
+
+#include <boost/url/parse.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef BOOST_URL_BENCH_PSL_FILE
+#define BOOST_URL_BENCH_PSL_FILE "public_suffix_list.dat"
+#endif
+
+namespace urls = boost::urls;
+
+namespace {
+
+volatile std::size_t sink = 0;
+
+double
+seconds_since(
+    std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() -
+            t0).count();
+}
+
+// the longest rule which is a suffix
+// of the host, ignoring wildcard and
+// exception rules
+std::size_t
+scan(
+    std::vector<std::string> const& rules,
+    boost::core::string_view host)
+{
+    std::size_t best = 0;
+    for(auto const& r : rules)
+    {
+        if( r.size() > best &&
+            host.ends_with(r) && (
+                host.size() == r.size() ||
+                host[host.size() - r.size() - 1] == '.'))
+            best = r.size();
+    }
+    return best;
+}
+
+template<class F>
+double
+measure(
+    std::vector<urls::url_view> const& hosts,
+    F const& f)
+{
+    std::size_t iters = 0;
+    auto const t0 = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    while(elapsed < 0.5)
+    {
+        for(auto const& u : hosts)
+            sink = sink + f(u);
+        ++iters;
+        elapsed = seconds_since(t0);
+    }
+    return elapsed * 1e9 /
+        (double(iters) * double(hosts.size()));
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    char const* filename = argc > 1 ?
+        argv[1] : BOOST_URL_BENCH_PSL_FILE;
+    std::ifstream fin(filename);
+    if(! fin)
+    {
+        std::fprintf(stderr, "Cannot open %s\n", filename);
+        return EXIT_FAILURE;
+    }
+    std::string const text(
+        (std::istreambuf_iterator<char>(fin)),
+        std::istreambuf_iterator<char>());
+
+    std::vector<std::string> rules;
+    std::vector<std::string> requests;
+    {
+        boost::core::string_view s = text;
+        while(! s.empty())
+        {
+            auto n = s.find('\n');
+            if(n == boost::core::string_view::npos)
+                n = s.size();
+            auto line = s.substr(0, n);
+            s.remove_prefix((std::min)(n + 1, s.size()));
+            line = line.substr(0, line.find_first_of(" \t\r"));
+            if( line.empty() ||
+                line.starts_with("//"))
+                continue;
+            if(line.starts_with('!'))
+                line.remove_prefix(1);
+            else if(line.starts_with("*."))
+                line.remove_prefix(2);
+            rules.emplace_back(line);
+        }
+    }
+    for(std::size_t i = 0; i < rules.size(); ++i)
+    {
+        auto const& r = rules[i];
+        requests.push_back("https://example." + r + "/");
+        requests.push_back("https://www.example." + r + "/index.htm");
+        requests.push_back("https://www.example" +
+            std::to_string(i) + ".unlisted/");
+    }
+    std::mt19937 rng(1);
+    std::shuffle(requests.begin(), requests.end(), rng);
+
+    std::vector<urls::url_view> hosts;
+    for(auto const& s : requests)
+        hosts.push_back(urls::parse_uri(s).value());
+
+    auto t0 = std::chrono::steady_clock::now();
+    urls::public_suffix_list const psl0(text);
+    double const load_time = seconds_since(t0);
+
+    auto const image = psl0.image();
+    std::vector<std::uint32_t> buf(
+        (image.size() + 3) / 4);
+    std::memcpy(buf.data(), image.data(), image.size());
+    t0 = std::chrono::steady_clock::now();
+    auto const psl = urls::public_suffix_list::load(
+        buf.data(), image.size()).value();
+    double const image_time = seconds_since(t0);
+
+    double const suffix_time = measure(hosts,
+        [&psl](urls::url_view const& u)
+        {
+            return psl.public_suffix(u).size();
+        });
+    double const domain_time = measure(hosts,
+        [&psl](urls::url_view const& u)
+        {
+            return psl.registrable_domain(u).size();
+        });
+
+    // the scan is slow, so it only
+    // sees a sample of the hosts
+    std::vector<urls::url_view> sample(
+        hosts.begin(), hosts.begin() +
+            (std::min)(hosts.size(), std::size_t(1000)));
+    double const scan_time = measure(sample,
+        [&rules](urls::url_view const& u)
+        {
+            return scan(rules, u.encoded_host());
+        });
+
+    std::printf("rules:              %zu\n", psl.size());
+    std::printf("hosts:              %zu\n", hosts.size());
+    std::printf("load text:          %.1f ms\n", load_time * 1e3);
+    std::printf("load image:         %.1f us (%zu bytes)\n",
+        image_time * 1e6, image.size());
+    std::printf("public_suffix:      %.1f ns\n", suffix_time);
+    std::printf("registrable_domain: %.1f ns (%.1f M/s)\n",
+        domain_time, 1e3 / domain_time);
+    std::printf("scan:               %.1f ns\n", scan_time);
+    return EXIT_SUCCESS;
+}
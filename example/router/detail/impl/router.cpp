@@ -18,7 +18,12 @@
 #include <boost/url/grammar/token_rule.hpp>
 #include <boost/url/grammar/variant_rule.hpp>
 #include <boost/url/rfc/detail/path_rules.hpp>
+#include <boost/url/detail/except.hpp>
 #include <boost/url/detail/replacement_field_rule.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace boost {
@@ -243,119 +248,6 @@ parse(
     return t;
 }
 
-// a small vector for child nodes...
-// we shouldn't expect many children per node, and
-// we don't want to allocate for that. But we also
-// cannot cap the max number of child nodes because
-// especially the root nodes can potentially an
-// exponentially higher number of child nodes.
-class child_idx_vector
-{
-    static constexpr std::size_t N = 5;
-    std::size_t static_child_idx_[N]{};
-    std::size_t* child_idx{nullptr};
-    std::size_t size_{0};
-    std::size_t cap_{0};
-
-public:
-    ~child_idx_vector()
-    {
-        delete[] child_idx;
-    }
-
-    child_idx_vector() = default;
-
-    child_idx_vector(child_idx_vector const& other)
-        : size_{other.size_}
-        , cap_{other.cap_}
-    {
-        if (other.child_idx)
-        {
-            child_idx = new std::size_t[cap_];
-            std::memcpy(child_idx, other.child_idx, size_ * sizeof(std::size_t));
-            return;
-        }
-        std::memcpy(static_child_idx_, other.static_child_idx_, size_ * sizeof(std::size_t));
-    }
-
-    child_idx_vector(child_idx_vector&& other)
-        : child_idx{other.child_idx}
-        , size_{other.size_}
-        , cap_{other.cap_}
-    {
-        std::memcpy(static_child_idx_, other.static_child_idx_, N);
-        other.child_idx = nullptr;
-    }
-
-    bool
-    empty() const
-    {
-        return size_ == 0;
-    }
-
-    std::size_t
-    size() const
-    {
-        return size_;
-    }
-
-    std::size_t*
-    begin()
-    {
-        if (child_idx)
-            return child_idx;
-        return static_child_idx_;
-    }
-
-    std::size_t*
-    end()
-    {
-        return begin() + size_;
-    }
-
-    std::size_t const*
-    begin() const
-    {
-        if (child_idx)
-            return child_idx;
-        return static_child_idx_;
-    }
-
-    std::size_t const*
-    end() const
-    {
-        return begin() + size_;
-    }
-
-    void
-    erase(std::size_t* it)
-    {
-        BOOST_ASSERT(it - begin() >= 0);
-        std::memmove(it - 1, it, end() - it);
-        --size_;
-    }
-
-    void
-    push_back(std::size_t v)
-    {
-        if (size_ == N && !child_idx)
-        {
-            child_idx = new std::size_t[N*2];
-            cap_ = N*2;
-            std::memcpy(child_idx, static_child_idx_, N * sizeof(std::size_t));
-        }
-        else if (child_idx && size_ == cap_)
-        {
-            auto* tmp = new std::size_t[cap_*2];
-            std::memcpy(tmp, child_idx, cap_ * sizeof(std::size_t));
-            delete[] child_idx;
-            child_idx = tmp;
-            cap_ = cap_*2;
-        }
-        begin()[size_++] = v;
-    }
-};
-
 // A node in the resource tree
 // Each segment in the resource tree might be
 // associated with
@@ -367,7 +259,8 @@ struct node
     detail::segment_template seg{};
 
     // A pointer to the resource
-    router_base::any_resource const* resource{nullptr};
+    std::shared_ptr<
+        router_base::any_resource const> resource;
 
     // The complete match for the resource
     std::string path_template;
@@ -377,89 +270,269 @@ struct node
     std::size_t parent_idx{npos};
 
     // Index of child nodes in the pool
-    detail::child_idx_vector child_idx;
+    std::vector<std::size_t> child_idx;
 };
 
-class impl
+// The resource tree compiled into a flat
+// trie. Nodes are numbered breadth first,
+// so the children of a node are adjacent:
+// first the literal segments, sorted by
+// their decoded string, then the
+// replacement fields in order of
+// precedence. Strings live in one pool.
+class route_table
 {
-    // Pool of nodes in the resource tree
-    std::vector<node> nodes_;
-
-public:
-    impl()
+    enum class kind : unsigned char
     {
-        // root node with no resource
-        nodes_.push_back(node{});
-    }
+        literal,
+        unique,
+        optional,
+        star,
+        plus
+    };
 
-    ~impl()
+    struct trie_node
     {
-        for (auto &r: nodes_)
-            delete r.resource;
-    }
+        std::uint32_t parent;
+        std::uint32_t first_child;
+        std::uint32_t n_literal;
+        std::uint32_t n_field;
 
-    // include a node for a resource
-    void
-    insert_impl(
-        core::string_view path,
-        router_base::any_resource const* v);
+        // literal string or field id
+        std::uint32_t key;
+        std::uint32_t key_size;
+
+        kind k;
+
+        // replacement field children
+        // without a modifier
+        unsigned char n_unique;
+
+        // any replacement field child
+        // has a modifier
+        bool any_modifier;
+
+        router_base::any_resource const* resource;
+    };
+
+    std::vector<trie_node> nodes_;
+    std::string pool_;
+
+    // keeps the resources alive as long
+    // as the table is referenced
+    std::vector<std::shared_ptr<
+        router_base::any_resource const>> resources_;
+
+public:
+    explicit
+    route_table(std::vector<node> const& ns);
 
-    // match a node and return the element
     router_base::any_resource const*
-    find_impl(
+    find(
         segments_encoded_view path,
         core::string_view*& matches,
-        core::string_view*& ids) const;
+        core::string_view*& ids) const noexcept;
 
 private:
+    core::string_view
+    key(trie_node const& n) const noexcept
+    {
+        return { pool_.data() + n.key, n.key_size };
+    }
+
+    // find the literal child which
+    // matches the segment
+    trie_node const*
+    find_literal(
+        trie_node const& cur,
+        pct_string_view s) const noexcept;
+
     // try to match from this root node
-    node const*
+    trie_node const*
     try_match(
         segments_encoded_view::const_iterator it,
         segments_encoded_view::const_iterator end,
-        node const* root,
+        trie_node const* root,
         int level,
         core::string_view*& matches,
-        core::string_view*& ids) const;
+        core::string_view*& ids) const noexcept;
 
     // check if a node has a resource when we
     // also consider optional paths through
     // the child nodes.
-    static
-    node const*
+    trie_node const*
     find_optional_resource(
-        const node* root,
-        std::vector<node> const& ns,
+        trie_node const* root,
         core::string_view*& matches,
-        core::string_view*& ids);
+        core::string_view*& ids) const noexcept;
 };
 
-node const*
-impl::
+route_table::
+route_table(std::vector<node> const& ns)
+{
+    static constexpr std::size_t max_size =
+        std::uint32_t(-1);
+    if (ns.size() > max_size)
+        urls::detail::throw_length_error();
+
+    // order[i] is the tree node
+    // numbered i in the trie
+    std::vector<std::size_t> order;
+    order.reserve(ns.size());
+    nodes_.reserve(ns.size());
+    order.push_back(0);
+    nodes_.push_back(trie_node{});
+    std::vector<std::size_t> lits;
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        node const& n = ns[order[i]];
+        lits.clear();
+        for (auto ci: n.child_idx)
+            if (ns[ci].seg.is_literal())
+                lits.push_back(ci);
+        std::sort(
+            lits.begin(), lits.end(),
+            [&ns](std::size_t a, std::size_t b)
+            {
+                return ns[a].seg.string() <
+                       ns[b].seg.string();
+            });
+        auto const first_child =
+            static_cast<std::uint32_t>(order.size());
+        std::uint32_t n_unique = 0;
+        bool any_modifier = false;
+        auto const add =
+            [&](std::size_t ci)
+            {
+                order.push_back(ci);
+                trie_node c{};
+                c.parent = static_cast<
+                    std::uint32_t>(i);
+                nodes_.push_back(c);
+            };
+        for (auto ci: lits)
+            add(ci);
+        for (auto ci: n.child_idx)
+        {
+            auto const& seg = ns[ci].seg;
+            if (seg.is_literal())
+                continue;
+            if (seg.has_modifier())
+                any_modifier = true;
+            else
+                ++n_unique;
+            add(ci);
+        }
+
+        trie_node& t = nodes_[i];
+        t.first_child = first_child;
+        t.n_literal = static_cast<
+            std::uint32_t>(lits.size());
+        t.n_field = static_cast<std::uint32_t>(
+            order.size() - first_child - lits.size());
+        t.n_unique = static_cast<
+            unsigned char>(n_unique);
+        t.any_modifier = any_modifier;
+        core::string_view k;
+        if (n.seg.is_literal())
+        {
+            t.k = kind::literal;
+            k = n.seg.string();
+        }
+        else
+        {
+            if (n.seg.is_optional())
+                t.k = kind::optional;
+            else if (n.seg.is_star())
+                t.k = kind::star;
+            else if (n.seg.is_plus())
+                t.k = kind::plus;
+            else
+                t.k = kind::unique;
+            k = n.seg.id();
+        }
+        if (pool_.size() + k.size() > max_size)
+            urls::detail::throw_length_error();
+        t.key = static_cast<
+            std::uint32_t>(pool_.size());
+        t.key_size = static_cast<
+            std::uint32_t>(k.size());
+        pool_.append(k.data(), k.size());
+        if (n.resource)
+        {
+            t.resource = n.resource.get();
+            resources_.push_back(n.resource);
+        }
+    }
+}
+
+auto
+route_table::
+find_literal(
+    trie_node const& cur,
+    pct_string_view s) const noexcept ->
+        trie_node const*
+{
+    auto first = nodes_.data() + cur.first_child;
+    auto const last = first + cur.n_literal;
+    // compare the decoded segment with
+    // a key, like core::string_view::compare
+    auto const compare =
+        [this, s](trie_node const& n)
+        {
+            if (s.decoded_size() == s.size())
+                return core::string_view(
+                    s.data(), s.size()).compare(key(n));
+            return (*s).compare(key(n));
+        };
+    std::size_t n = cur.n_literal;
+    while (n > 0)
+    {
+        auto const half = n / 2;
+        auto const mid = first + half;
+        if (compare(*mid) > 0)
+        {
+            first = mid + 1;
+            n -= half + 1;
+        }
+        else
+        {
+            n = half;
+        }
+    }
+    if (first != last &&
+        compare(*first) == 0)
+        return first;
+    return nullptr;
+}
+
+auto
+route_table::
 find_optional_resource(
-    const node* root,
-    std::vector<node> const& ns,
+    trie_node const* root,
     core::string_view*& matches,
-    core::string_view*& ids)
+    core::string_view*& ids) const noexcept ->
+        trie_node const*
 {
     BOOST_ASSERT(root);
     if (root->resource)
         return root;
-    BOOST_ASSERT(!root->child_idx.empty());
-    for (auto i: root->child_idx)
+    auto const first = nodes_.data() +
+        root->first_child + root->n_literal;
+    auto const last = first + root->n_field;
+    for (auto c = first; c != last; ++c)
     {
-        auto& c = ns[i];
-        if (!c.seg.is_optional() &&
-            !c.seg.is_star())
+        if (c->k != kind::optional &&
+            c->k != kind::star)
             continue;
         // Child nodes are also
         // potentially optional.
         auto matches0 = matches;
         auto ids0 = ids;
         *matches++ = {};
-        *ids++ = c.seg.id();
+        *ids++ = key(*c);
         auto n = find_optional_resource(
-            &c, ns, matches, ids);
+            c, matches, ids);
         if (n)
             return n;
         matches = matches0;
@@ -468,132 +541,16 @@ find_optional_resource(
     return nullptr;
 }
 
-void
-impl::
-insert_impl(
-    core::string_view path,
-    router_base::any_resource const* v)
-{
-    // Parse dynamic route segments
-    if (path.starts_with("/"))
-        path.remove_prefix(1);
-    auto segsr =
-        grammar::parse(path, detail::path_template_rule);
-    if (!segsr)
-    {
-        delete v;
-        segsr.value();
-    }
-    auto segs = *segsr;
-    auto it = segs.begin();
-    auto end = segs.end();
-
-    // Iterate existing nodes
-    node* cur = &nodes_.front();
-    int level = 0;
-    while (it != end)
-    {
-        core::string_view seg = (*it).string();
-        if (seg == ".")
-        {
-            ++it;
-            continue;
-        }
-        if (seg == "..")
-        {
-            // discount unmatched leaf or
-            // keep track of levels behind root
-            if (cur == &nodes_.front())
-            {
-                --level;
-                ++it;
-                continue;
-            }
-            // move to parent deleting current
-            // if it carries no resource
-            std::size_t p_idx = cur->parent_idx;
-            if (cur == &nodes_.back() &&
-                !cur->resource &&
-                cur->child_idx.empty())
-            {
-                node* p = &nodes_[p_idx];
-                std::size_t cur_idx = cur - nodes_.data();
-                p->child_idx.erase(
-                    std::remove(
-                        p->child_idx.begin(),
-                        p->child_idx.end(),
-                        cur_idx));
-                nodes_.pop_back();
-            }
-            cur = &nodes_[p_idx];
-            ++it;
-            continue;
-        }
-        // discount unmatched root parent
-        if (level < 0)
-        {
-            ++level;
-            ++it;
-            continue;
-        }
-        // look for child
-        auto cit = std::find_if(
-            cur->child_idx.begin(),
-            cur->child_idx.end(),
-            [this, &it](std::size_t ci) -> bool
-            {
-                return nodes_[ci].seg == *it;
-            });
-        if (cit != cur->child_idx.end())
-        {
-            // move to existing child
-            cur = &nodes_[*cit];
-        }
-        else
-        {
-            // create child if it doesn't exist
-            node child;
-            child.seg = *it;
-            std::size_t cur_id = cur - nodes_.data();
-            child.parent_idx = cur_id;
-            nodes_.push_back(std::move(child));
-            nodes_[cur_id].child_idx.push_back(nodes_.size() - 1);
-            if (nodes_[cur_id].child_idx.size() > 1)
-            {
-                // keep nodes sorted
-                auto& cs = nodes_[cur_id].child_idx;
-                std::size_t n = cs.size() - 1;
-                while (n)
-                {
-                    if (nodes_[cs.begin()[n]].seg < nodes_[cs.begin()[n - 1]].seg)
-                        std::swap(cs.begin()[n], cs.begin()[n - 1]);
-                    else
-                        break;
-                    --n;
-                }
-            }
-            cur = &nodes_.back();
-        }
-        ++it;
-    }
-    if (level != 0)
-    {
-        delete v;
-        urls::detail::throw_invalid_argument();
-    }
-    cur->resource = v;
-    cur->path_template = path;
-}
-
-node const*
-impl::
+auto
+route_table::
 try_match(
     segments_encoded_view::const_iterator it,
     segments_encoded_view::const_iterator end,
-    node const* cur,
+    trie_node const* cur,
     int level,
     core::string_view*& matches,
-    core::string_view*& ids) const
+    core::string_view*& ids) const noexcept ->
+        trie_node const*
 {
     while (it != end)
     {
@@ -610,14 +567,14 @@ try_match(
             // move back to the parent node
             ++it;
             if (level <= 0 &&
-                cur != &nodes_.front())
+                cur != nodes_.data())
             {
-                if (!cur->seg.is_literal())
+                if (cur->k != kind::literal)
                 {
                     --matches;
                     --ids;
                 }
-                cur = &nodes_[cur->parent_idx];
+                cur = &nodes_[cur->parent];
             }
             else
                 // there's no parent, so we
@@ -636,225 +593,200 @@ try_match(
             continue;
         }
 
-        // calculate the lower bound on the
-        // possible number of branches to
-        // determine if we need to branch.
-        // We branch when we might have more than
-        // one child matching node at this level.
-        // If so, we need to potentially branch
-        // to find which path leads to a valid
-        // resource. Otherwise, we can just
-        // consume the node and input without
-        // any recursive function calls.
-        bool branch = false;
-        if (cur->child_idx.size() > 1)
+        // At most one literal child matches
+        // the segment. We branch when we might
+        // have more than one child matching
+        // node at this level, to find which
+        // path leads to a valid resource.
+        // Otherwise, we can just consume the
+        // node and input without any recursive
+        // function calls. A field with a
+        // modifier counts as more than one
+        // path already.
+        trie_node const* lit =
+            find_literal(*cur, s);
+        bool const branch =
+            cur->n_literal + cur->n_field > 1 &&
+            (lit != nullptr) + cur->n_unique +
+                2 * cur->any_modifier > 1;
+
+        trie_node const* r = nullptr;
+        bool match_any = false;
+        if (lit)
         {
-            int branches_lb = 0;
-            for (auto i: cur->child_idx)
+            // just continue from the
+            // next segment
+            if (branch)
             {
-                auto& c = nodes_[i];
-                if (c.seg.is_literal() ||
-                    !c.seg.has_modifier())
-                {
-                    // a literal path counts only
-                    // if it matches
-                    branches_lb += c.seg.match(s);
-                }
-                else
-                {
-                    // everything not matching
-                    // a single path counts as
-                    // more than one path already
-                    branches_lb = 2;
-                }
-                if (branches_lb > 1)
-                {
-                    // already know we need to
-                    // branch
-                    branch = true;
-                    break;
-                }
+                r = try_match(
+                    std::next(it), end,
+                    lit, level,
+                    matches, ids);
+            }
+            else
+            {
+                cur = lit;
+                match_any = true;
             }
         }
 
-        // attempt to match each child node
-        node const* r = nullptr;
-        bool match_any = false;
-        for (auto i: cur->child_idx)
+        // attempt to match each field
+        auto const first = nodes_.data() +
+            cur->first_child + cur->n_literal;
+        auto const last = first +
+            (r || match_any ? 0 : cur->n_field);
+        for (auto pc = first; pc != last; ++pc)
         {
-            auto& c = nodes_[i];
-            if (c.seg.match(s))
+            auto& c = *pc;
+            if (c.k == kind::unique)
             {
-                if (c.seg.is_literal())
-                {
-                    // just continue from the
-                    // next segment
-                    if (branch)
-                    {
-                        r = try_match(
-                            std::next(it), end,
-                            &c, level,
-                            matches, ids);
-                        if (r)
-                            break;
-                    }
-                    else
-                    {
-                        cur = &c;
-                        match_any = true;
-                        break;
-                    }
-                }
-                else if (!c.seg.has_modifier())
-                {
-                    // just continue from the
-                    // next segment
-                    if (branch)
-                    {
-                        auto matches0 = matches;
-                        auto ids0 = ids;
-                        *matches++ = *it;
-                        *ids++ = c.seg.id();
-                        r = try_match(
-                            std::next(it), end, &c,
-                            level, matches, ids);
-                        if (r)
-                        {
-                            break;
-                        }
-                        else
-                        {
-                            // rewind
-                            matches = matches0;
-                            ids = ids0;
-                        }
-                    }
-                    else
-                    {
-                        // only path possible
-                        *matches++ = *it;
-                        *ids++ = c.seg.id();
-                        cur = &c;
-                        match_any = true;
-                        break;
-                    }
-                }
-                else if (c.seg.is_optional())
+                // just continue from the
+                // next segment
+                if (branch)
                 {
-                    // attempt to match by ignoring
-                    // and not ignoring the segment.
-                    // we first try the complete
-                    // continuation consuming the
-                    // input, which is the
-                    // longest and most likely
-                    // match
                     auto matches0 = matches;
                     auto ids0 = ids;
                     *matches++ = *it;
-                    *ids++ = c.seg.id();
+                    *ids++ = key(c);
                     r = try_match(
-                        std::next(it), end,
-                        &c, level, matches, ids);
-                    if (r)
-                        break;
-                    // rewind
-                    matches = matches0;
-                    ids = ids0;
-                    // try complete continuation
-                    // consuming no segment
-                    *matches++ = {};
-                    *ids++ = c.seg.id();
-                    r = try_match(
-                        it, end, &c,
+                        std::next(it), end, &c,
                         level, matches, ids);
                     if (r)
+                    {
                         break;
-                    // rewind
-                    matches = matches0;
-                    ids = ids0;
+                    }
+                    else
+                    {
+                        // rewind
+                        matches = matches0;
+                        ids = ids0;
+                    }
                 }
                 else
                 {
-                    // check if the next segments
-                    // won't send us to a parent
-                    // directory
-                    auto first = it;
-                    std::size_t ndotdot = 0;
-                    std::size_t nnondot = 0;
-                    auto it1 = it;
-                    while (it1 != end)
-                    {
-                        if (*it1 == "..")
-                        {
-                            ++ndotdot;
-                            if (ndotdot >= (nnondot + c.seg.is_star()))
-                                break;
-                        }
-                        else if (*it1 != ".")
-                        {
-                            ++nnondot;
-                        }
-                        ++it1;
-                    }
-                    if (it1 != end)
-                        break;
-
-                    // attempt to match many
-                    // segments
-                    auto matches0 = matches;
-                    auto ids0 = ids;
+                    // only path possible
                     *matches++ = *it;
-                    *ids++ = c.seg.id();
-                    // if this is a plus seg, we
-                    // already consumed the first
-                    // segment
-                    if (c.seg.is_plus())
-                    {
-                        ++first;
-                    }
-                    // {*} is usually the last
-                    // match in a path.
-                    // try complete continuation
-                    // match for every subrange
-                    // from {last, last} to
-                    // {first, last}.
-                    // We also try {last, last}
-                    // first because it is the
-                    // longest match.
-                    auto start = end;
-                    while (start != first)
+                    *ids++ = key(c);
+                    cur = &c;
+                    match_any = true;
+                    break;
+                }
+            }
+            else if (c.k == kind::optional)
+            {
+                // attempt to match by ignoring
+                // and not ignoring the segment.
+                // we first try the complete
+                // continuation consuming the
+                // input, which is the
+                // longest and most likely
+                // match
+                auto matches0 = matches;
+                auto ids0 = ids;
+                *matches++ = *it;
+                *ids++ = key(c);
+                r = try_match(
+                    std::next(it), end,
+                    &c, level, matches, ids);
+                if (r)
+                    break;
+                // rewind
+                matches = matches0;
+                ids = ids0;
+                // try complete continuation
+                // consuming no segment
+                *matches++ = {};
+                *ids++ = key(c);
+                r = try_match(
+                    it, end, &c,
+                    level, matches, ids);
+                if (r)
+                    break;
+                // rewind
+                matches = matches0;
+                ids = ids0;
+            }
+            else
+            {
+                // check if the next segments
+                // won't send us to a parent
+                // directory
+                auto first_seg = it;
+                std::size_t ndotdot = 0;
+                std::size_t nnondot = 0;
+                auto it1 = it;
+                while (it1 != end)
+                {
+                    if (*it1 == "..")
                     {
-                        r = try_match(
-                            start, end, &c,
-                            level, matches, ids);
-                        if (r)
-                        {
-                            core::string_view prev = *std::prev(start);
-                            *matches0 = {
-                                matches0->data(),
-                                prev.data() + prev.size()};
+                        ++ndotdot;
+                        if (ndotdot >= (nnondot + (c.k == kind::star)))
                             break;
-                        }
-                        matches = matches0 + 1;
-                        ids = ids0 + 1;
-                        --start;
                     }
-                    if (r)
+                    else if (*it1 != ".")
                     {
-                        break;
+                        ++nnondot;
                     }
-                    // start == first
-                    matches = matches0 + 1;
-                    ids = ids0 + 1;
+                    ++it1;
+                }
+                if (it1 != end)
+                    break;
+
+                // attempt to match many
+                // segments
+                auto matches0 = matches;
+                auto ids0 = ids;
+                *matches++ = *it;
+                *ids++ = key(c);
+                // if this is a plus seg, we
+                // already consumed the first
+                // segment
+                if (c.k == kind::plus)
+                {
+                    ++first_seg;
+                }
+                // {*} is usually the last
+                // match in a path.
+                // try complete continuation
+                // match for every subrange
+                // from {last, last} to
+                // {first, last}.
+                // We also try {last, last}
+                // first because it is the
+                // longest match.
+                auto start = end;
+                while (start != first_seg)
+                {
                     r = try_match(
                         start, end, &c,
                         level, matches, ids);
                     if (r)
                     {
-                        if (!c.seg.is_plus())
-                            *matches0 = {};
+                        core::string_view prev = *std::prev(start);
+                        *matches0 = {
+                            matches0->data(),
+                            prev.data() + prev.size()};
                         break;
                     }
+                    matches = matches0 + 1;
+                    ids = ids0 + 1;
+                    --start;
+                }
+                if (r)
+                {
+                    break;
+                }
+                // start == first
+                matches = matches0 + 1;
+                ids = ids0 + 1;
+                r = try_match(
+                    start, end, &c,
+                    level, matches, ids);
+                if (r)
+                {
+                    if (c.k != kind::plus)
+                        *matches0 = {};
+                    break;
                 }
             }
         }
@@ -884,32 +816,214 @@ try_match(
         // with resources we can reach without
         // consuming any input
         return find_optional_resource(
-            cur, nodes_, matches, ids);
+            cur, matches, ids);
     }
     return cur;
 }
 
 router_base::any_resource const*
-impl::
-find_impl(
+route_table::
+find(
     segments_encoded_view path,
     core::string_view*& matches,
-    core::string_view*& ids) const
+    core::string_view*& ids) const noexcept
 {
     // parse_path is inconsistent for empty paths
     if (path.empty())
         path = segments_encoded_view("./");
 
     // Iterate nodes from the root
-    node const*p = try_match(
+    trie_node const* p = try_match(
         path.begin(), path.end(),
-        &nodes_.front(), 0,
+        nodes_.data(), 0,
         matches, ids);
     if (p)
         return p->resource;
     return nullptr;
 }
 
+//------------------------------------------------
+
+class impl
+{
+    // Pool of nodes in the resource tree
+    std::vector<node> nodes_;
+
+    // The routes compiled on the first
+    // lookup after an insertion
+    mutable std::mutex mutex_;
+    mutable std::atomic<
+        route_table const*> table_{nullptr};
+    mutable std::shared_ptr<
+        route_table const> snapshot_;
+
+public:
+    impl()
+    {
+        // root node with no resource
+        nodes_.push_back(node{});
+    }
+
+    // include a node for a resource
+    void
+    insert_impl(
+        core::string_view path,
+        router_base::any_resource const* v);
+
+    // the current compiled routes
+    route_table const&
+    table() const;
+
+    std::shared_ptr<route_table const>
+    snapshot() const;
+};
+
+void
+impl::
+insert_impl(
+    core::string_view path,
+    router_base::any_resource const* v)
+{
+    std::shared_ptr<
+        router_base::any_resource const> sp(v);
+
+    // the compiled routes are stale
+    snapshot_.reset();
+    table_.store(nullptr, std::memory_order_relaxed);
+
+    // Parse dynamic route segments
+    if (path.starts_with("/"))
+        path.remove_prefix(1);
+    auto segsr =
+        grammar::parse(path, detail::path_template_rule);
+    if (!segsr)
+        segsr.value();
+    auto segs = *segsr;
+    auto it = segs.begin();
+    auto end = segs.end();
+
+    // Iterate existing nodes
+    node* cur = &nodes_.front();
+    int level = 0;
+    while (it != end)
+    {
+        core::string_view seg = (*it).string();
+        if (seg == ".")
+        {
+            ++it;
+            continue;
+        }
+        if (seg == "..")
+        {
+            // discount unmatched leaf or
+            // keep track of levels behind root
+            if (cur == &nodes_.front())
+            {
+                --level;
+                ++it;
+                continue;
+            }
+            // move to parent deleting current
+            // if it carries no resource
+            std::size_t p_idx = cur->parent_idx;
+            if (cur == &nodes_.back() &&
+                !cur->resource &&
+                cur->child_idx.empty())
+            {
+                node* p = &nodes_[p_idx];
+                std::size_t cur_idx = cur - nodes_.data();
+                p->child_idx.erase(
+                    std::remove(
+                        p->child_idx.begin(),
+                        p->child_idx.end(),
+                        cur_idx),
+                    p->child_idx.end());
+                nodes_.pop_back();
+            }
+            cur = &nodes_[p_idx];
+            ++it;
+            continue;
+        }
+        // discount unmatched root parent
+        if (level < 0)
+        {
+            ++level;
+            ++it;
+            continue;
+        }
+        // look for child
+        auto cit = std::find_if(
+            cur->child_idx.begin(),
+            cur->child_idx.end(),
+            [this, &it](std::size_t ci) -> bool
+            {
+                return nodes_[ci].seg == *it;
+            });
+        if (cit != cur->child_idx.end())
+        {
+            // move to existing child
+            cur = &nodes_[*cit];
+        }
+        else
+        {
+            // create child if it doesn't exist
+            node child;
+            child.seg = *it;
+            std::size_t cur_id = cur - nodes_.data();
+            child.parent_idx = cur_id;
+            nodes_.push_back(std::move(child));
+            nodes_[cur_id].child_idx.push_back(nodes_.size() - 1);
+            if (nodes_[cur_id].child_idx.size() > 1)
+            {
+                // keep nodes sorted
+                auto& cs = nodes_[cur_id].child_idx;
+                std::size_t n = cs.size() - 1;
+                while (n)
+                {
+                    if (nodes_[cs[n]].seg < nodes_[cs[n - 1]].seg)
+                        std::swap(cs[n], cs[n - 1]);
+                    else
+                        break;
+                    --n;
+                }
+            }
+            cur = &nodes_.back();
+        }
+        ++it;
+    }
+    if (level != 0)
+        urls::detail::throw_invalid_argument();
+    cur->resource = std::move(sp);
+    cur->path_template = path;
+}
+
+route_table const&
+impl::
+table() const
+{
+    auto p = table_.load(
+        std::memory_order_acquire);
+    if (p)
+        return *p;
+    return *snapshot();
+}
+
+std::shared_ptr<route_table const>
+impl::
+snapshot() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!snapshot_)
+    {
+        snapshot_ = std::make_shared<
+            route_table const>(nodes_);
+        table_.store(
+            snapshot_.get(),
+            std::memory_order_release);
+    }
+    return snapshot_;
+}
+
 router_base::
 router_base()
     : impl_(new impl{}) {}
@@ -930,16 +1044,30 @@ insert_impl(
         ->insert_impl(s, v);
 }
 
-auto
+route_table const&
+router_base::
+table_impl() const
+{
+    return reinterpret_cast<impl*>(impl_)
+        ->table();
+}
+
+std::shared_ptr<route_table const>
 router_base::
-find_impl(
+snapshot_impl() const
+{
+    return reinterpret_cast<impl*>(impl_)
+        ->snapshot();
+}
+
+router_base::any_resource const*
+find_route(
+    route_table const& t,
     segments_encoded_view path,
     core::string_view*& matches,
-    core::string_view*& ids) const noexcept
-    -> any_resource const*
+    core::string_view*& ids) noexcept
 {
-    return reinterpret_cast<impl*>(impl_)
-        ->find_impl(path, matches, ids);
+    return t.find(path, matches, ids);
 }
 
 } // detail
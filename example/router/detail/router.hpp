@@ -16,12 +16,17 @@
 #include <boost/url/grammar/optional_rule.hpp>
 #include <boost/url/grammar/range_rule.hpp>
 #include <boost/url/grammar/tuple_rule.hpp>
+#include <memory>
 #include <string>
 
 namespace boost {
 namespace urls {
 namespace detail {
 
+// The routes of a router compiled into
+// a flat trie which is never modified
+class route_table;
+
 class router_base
 {
     void* impl_{nullptr};
@@ -44,13 +49,22 @@ protected:
         core::string_view s,
         any_resource const* v);
 
-    any_resource const*
-    find_impl(
-        segments_encoded_view path,
-        core::string_view*& matches,
-        core::string_view*& names) const noexcept;
+    // compiles the routes on the
+    // first call after an insert
+    route_table const&
+    table_impl() const;
+
+    std::shared_ptr<route_table const>
+    snapshot_impl() const;
 };
 
+router_base::any_resource const*
+find_route(
+    route_table const& t,
+    segments_encoded_view path,
+    core::string_view*& matches,
+    core::string_view*& names) noexcept;
+
 } // detail
 } // urls
 } // boost
@@ -50,15 +50,19 @@ insert(core::string_view pattern, U&& v)
     insert_impl( pattern, p );
 }
 
+namespace detail {
+
 template <class T>
 T const*
-router<T>::
-find(segments_encoded_view path, matches_base& m) const noexcept
+find_route(
+    route_table const& t,
+    segments_encoded_view path,
+    matches_base& m) noexcept
 {
     core::string_view* matches_it = m.matches();
     core::string_view* ids_it = m.ids();
-    any_resource const* p = find_impl(
-        path, matches_it, ids_it );
+    router_base::any_resource const* p = find_route(
+        t, path, matches_it, ids_it );
     if (p)
     {
         BOOST_ASSERT(matches_it >= m.matches());
@@ -71,5 +75,37 @@ find(segments_encoded_view path, matches_base& m) const noexcept
     return nullptr;
 }
 
+} // detail
+
+template <class T>
+T const*
+router<T>::
+find(segments_encoded_view path, matches_base& m) const
+{
+    return detail::find_route<T>(
+        table_impl(), path, m);
+}
+
+template <class T>
+router_snapshot<T>
+router<T>::
+snapshot() const
+{
+    return router_snapshot<T>(snapshot_impl());
+}
+
+template <class T>
+T const*
+router_snapshot<T>::
+find(segments_encoded_view path, matches_base& m) const noexcept
+{
+    if (!t_)
+    {
+        m.resize(0);
+        return nullptr;
+    }
+    return detail::find_route<T>(*t_, path, m);
+}
+
 } // urls
 } // boost
@@ -18,6 +18,57 @@
 namespace boost {
 namespace urls {
 
+/** An immutable set of routes
+
+    A snapshot holds the routes of a
+    @ref router at the time it was taken.
+    It is never modified, so any number of
+    threads may look up paths in the same
+    snapshot concurrently, and it remains
+    valid when the router is modified or
+    destroyed.
+
+    @tparam T type of resource associated with
+    each path template
+
+    @see
+        @ref router::snapshot.
+*/
+template <class T>
+class router_snapshot
+{
+    std::shared_ptr<detail::route_table const> t_;
+
+    template <class U>
+    friend class router;
+
+    explicit
+    router_snapshot(
+        std::shared_ptr<
+            detail::route_table const> t) noexcept
+        : t_(std::move(t))
+    {
+    }
+
+public:
+    /** Constructor
+
+        A default constructed snapshot
+        has no routes.
+     */
+    router_snapshot() = default;
+
+    /** Match URL path to corresponding resource
+
+        @param path Request path
+        @param m The match results
+        @return A pointer to the resource, or
+        `nullptr` if no route matches.
+     */
+    T const*
+    find(segments_encoded_view path, matches_base& m) const noexcept;
+};
+
 /** A URL router.
 
     This container matches static and dynamic
@@ -31,6 +82,13 @@ namespace urls {
     @tparam N maximum number of replacement fields
     in a path template
 
+    The path templates are compiled into a
+    flat trie on the first lookup after an
+    insertion. Literal segments are found
+    with a binary search among the children
+    of a node, and replacement fields are
+    tried after them.
+
     @par Exception Safety
 
     @li Functions marked `noexcept` provide the
@@ -39,6 +97,13 @@ namespace urls {
     @li Functions which throw offer the strong
     exception safety guarantee.
 
+    @par Thread Safety
+    Lookups may be performed concurrently
+    from multiple threads, as long as no
+    thread inserts routes at the same time.
+    Use @ref snapshot to look up paths
+    while the router is being modified.
+
     @see
         @ref parse_absolute_uri,
         @ref parse_relative_ref,
@@ -68,17 +133,32 @@ public:
 
     /** Match URL path to corresponding resource
 
+        The first lookup after an insertion
+        compiles the routes, and may throw
+        if an allocation fails.
+
         @param request Request path
         @return The match results
      */
     T const*
-    find(segments_encoded_view path, matches_base& m) const noexcept;
+    find(segments_encoded_view path, matches_base& m) const;
 
 #ifdef BOOST_URL_DOCS
     /// @copydoc find
     T const*
-    find(segments_encoded_view path, matches& m) const noexcept;
+    find(segments_encoded_view path, matches& m) const;
 #endif
+
+    /** Return an immutable snapshot of the routes
+
+        Routes inserted after the snapshot
+        is taken are not visible to it.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+     */
+    router_snapshot<T>
+    snapshot() const;
 };
 
 } // urls
@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+/*
+    Compiles public_suffix_list.dat into the
+    binary image of a public_suffix_list,
+    which programs can map into memory and
+    use without parsing the list.
+*/
+
+#include "public_suffix_list.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace urls = boost::urls;
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        std::cout << argv[0] << "\n";
+        std::cout << "Usage: compile_suffix_list <suffix_list> <image>\n"
+                     "options:\n"
+                     "    <suffix_list>:      File with the public suffix list (required)\n"
+                     "    <image>:            File to write the compiled list to (required)\n"
+                     "examples:\n"
+                     "compile_suffix_list \"public_suffix_list.dat\" \"public_suffix_list.bin\"\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream fin(argv[1], std::ios::binary);
+    if (!fin)
+    {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+    std::string text(
+        (std::istreambuf_iterator<char>(fin)),
+        std::istreambuf_iterator<char>());
+    urls::public_suffix_list const psl(text);
+
+    std::ofstream fout(argv[2], std::ios::binary);
+    auto const image = psl.image();
+    fout.write(image.data(), static_cast<
+        std::streamsize>(image.size()));
+    fout.close();
+    if (!fout)
+    {
+        std::cerr << "Cannot write " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout <<
+        psl.size() << " rules, " <<
+        image.size() << " bytes\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_MAPPED_FILE_HPP
+#define BOOST_URL_MAPPED_FILE_HPP
+
+#include <cstddef>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace boost {
+namespace urls {
+
+/** A read-only view of a file mapped into memory
+
+    The contents of the file are paged in
+    on demand, and pages are shared by all
+    processes which map the same file.
+    The mapping is aligned to a page.
+*/
+class mapped_file
+{
+    void const* data_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    mapped_file() = default;
+
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    ~mapped_file()
+    {
+        close();
+    }
+
+    /** Map a file
+
+        @return `false` if the file could not
+        be opened or mapped.
+    */
+    bool
+    open(char const* path) noexcept
+    {
+        close();
+#ifdef _WIN32
+        HANDLE f = ::CreateFileA(
+            path, GENERIC_READ, FILE_SHARE_READ,
+            nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(f == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER n;
+        bool ok = ::GetFileSizeEx(f, &n) != 0;
+        if(ok && n.QuadPart > 0)
+        {
+            HANDLE m = ::CreateFileMappingA(
+                f, nullptr, PAGE_READONLY,
+                0, 0, nullptr);
+            ok = m != nullptr;
+            if(ok)
+            {
+                data_ = ::MapViewOfFile(
+                    m, FILE_MAP_READ, 0, 0, 0);
+                ok = data_ != nullptr;
+                ::CloseHandle(m);
+            }
+            if(ok)
+                size_ = static_cast<
+                    std::size_t>(n.QuadPart);
+        }
+        ::CloseHandle(f);
+        return ok;
+#else
+        int const fd = ::open(path, O_RDONLY);
+        if(fd < 0)
+            return false;
+        struct stat st;
+        bool ok = ::fstat(fd, &st) == 0;
+        if(ok && st.st_size > 0)
+        {
+            void* p = ::mmap(
+                nullptr, static_cast<std::size_t>(
+                    st.st_size),
+                PROT_READ, MAP_SHARED, fd, 0);
+            ok = p != MAP_FAILED;
+            if(ok)
+            {
+                data_ = p;
+                size_ = static_cast<
+                    std::size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+        return ok;
+#endif
+    }
+
+    /** Unmap the file
+    */
+    void
+    close() noexcept
+    {
+        if(! data_)
+            return;
+#ifdef _WIN32
+        ::UnmapViewOfFile(data_);
+#else
+        ::munmap(const_cast<void*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    void const*
+    data() const noexcept
+    {
+        return data_;
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+};
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,492 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#include "public_suffix_list.hpp"
+#include <boost/url/host_type.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+constexpr char magic[8] = "PSLTRIE";
+constexpr std::uint32_t byte_order = 0x01020304;
+constexpr std::uint32_t version = 1;
+
+// FNV-1a
+std::uint32_t
+checksum(
+    void const* data,
+    std::size_t n,
+    std::uint32_t h = 2166136261u) noexcept
+{
+    auto p = static_cast<
+        unsigned char const*>(data);
+    while(n--)
+    {
+        h ^= *p++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// A node of the trie while the
+// rules are being inserted
+struct tree_node
+{
+    std::map<std::string, std::size_t> children;
+    std::uint8_t flags = 0;
+};
+
+// Insert a rule into the tree, returns
+// false if the rule is not supported or
+// was already inserted
+bool
+insert_rule(
+    std::vector<tree_node>& tree,
+    core::string_view rule,
+    std::uint8_t flag)
+{
+    if( rule.empty() ||
+        rule.front() == '.' ||
+        rule.back() == '.' ||
+        rule.find("..") != core::string_view::npos ||
+        rule.find('*') != core::string_view::npos)
+        return false;
+
+    // labels from right to left
+    std::size_t i = 0;
+    std::size_t end = rule.size();
+    for(;;)
+    {
+        auto const p = rule.rfind('.', end - 1);
+        auto const start =
+            p == core::string_view::npos ? 0 : p + 1;
+        if(end - start > 0xffff)
+            return false;
+        std::string label(
+            rule.data() + start, end - start);
+        for(auto& c : label)
+            c = grammar::to_lower(c);
+        auto it = tree[i].children.find(label);
+        if(it == tree[i].children.end())
+        {
+            tree.emplace_back();
+            it = tree[i].children.emplace(
+                std::move(label),
+                tree.size() - 1).first;
+        }
+        i = it->second;
+        if(start == 0)
+            break;
+        end = p;
+    }
+    bool const is_new = !(tree[i].flags & flag);
+    tree[i].flags |= flag;
+    return is_new;
+}
+
+// Return the next character of a
+// percent-encoded string
+unsigned char
+next_char(
+    char const*& it,
+    char const* end) noexcept
+{
+    if( *it == '%' &&
+        end - it > 2)
+    {
+        auto const d0 = grammar::hexdig_value(it[1]);
+        auto const d1 = grammar::hexdig_value(it[2]);
+        if(d0 >= 0 && d1 >= 0)
+        {
+            it += 3;
+            return static_cast<unsigned char>(
+                (d0 << 4) + d1);
+        }
+    }
+    return static_cast<unsigned char>(*it++);
+}
+
+// Compare a percent-encoded label from
+// a host with a label of the trie
+int
+compare_label(
+    core::string_view label,
+    core::string_view key) noexcept
+{
+    auto it = label.data();
+    auto const end = it + label.size();
+    auto kt = key.data();
+    auto const kend = kt + key.size();
+    while(it != end)
+    {
+        if(kt == kend)
+            return 1;
+        unsigned char const c =
+            grammar::to_lower(static_cast<char>(
+                next_char(it, end)));
+        unsigned char const k = *kt++;
+        if(c != k)
+            return c < k ? -1 : 1;
+    }
+    return kt == kend ? 0 : -1;
+}
+
+// Return the position of the suffix with
+// n labels of host, or npos if the host
+// has fewer labels
+std::size_t
+suffix_pos(
+    core::string_view host,
+    std::size_t n) noexcept
+{
+    std::size_t end = host.size();
+    for(;;)
+    {
+        auto const p = end == 0 ?
+            core::string_view::npos :
+            host.rfind('.', end - 1);
+        auto const start =
+            p == core::string_view::npos ? 0 : p + 1;
+        if(--n == 0)
+            return start;
+        if(p == core::string_view::npos)
+            return core::string_view::npos;
+        end = p;
+    }
+}
+
+core::string_view
+strip_dot(core::string_view host) noexcept
+{
+    if(host.ends_with('.'))
+        host.remove_suffix(1);
+    return host;
+}
+
+core::string_view
+host_name(url_view_base const& u) noexcept
+{
+    if(u.host_type() != host_type::name)
+        return {};
+    return u.encoded_host();
+}
+
+} // (anon)
+
+void const*
+public_suffix_list::
+empty() noexcept
+{
+    struct image
+    {
+        header h;
+        node root;
+    };
+    static image const im = []
+    {
+        image im{};
+        std::memcpy(im.h.magic, magic, sizeof(im.h.magic));
+        im.h.order = byte_order;
+        im.h.version = version;
+        im.h.nodes = 1;
+        im.h.checksum = checksum(
+            &im.root, sizeof(node),
+            checksum(&im.h, sizeof(header)));
+        return im;
+    }();
+    return &im;
+}
+
+public_suffix_list::
+public_suffix_list(
+    core::string_view text)
+{
+    static_assert(sizeof(header) == 32, "");
+    static_assert(sizeof(node) == 16, "");
+
+    std::vector<tree_node> tree(1);
+    std::size_t rules = 0;
+    while(!text.empty())
+    {
+        auto n = text.find('\n');
+        if(n == core::string_view::npos)
+            n = text.size();
+        auto line = text.substr(0, n);
+        text.remove_prefix(
+            (std::min)(n + 1, text.size()));
+
+        // the rule ends at the
+        // first whitespace
+        line = line.substr(
+            0, line.find_first_of(" \t\r"));
+        if( line.empty() ||
+            line.starts_with("//"))
+            continue;
+        std::uint8_t flag = node::rule;
+        if(line.starts_with('!'))
+        {
+            flag = node::exception;
+            line.remove_prefix(1);
+        }
+        else if(line.starts_with("*."))
+        {
+            flag = node::wildcard;
+            line.remove_prefix(2);
+        }
+        if(insert_rule(tree, line, flag))
+            ++rules;
+    }
+
+    // flatten the tree breadth-first, so
+    // the children of each node are
+    // contiguous and sorted
+    std::vector<node> nodes;
+    std::string labels;
+    std::vector<std::size_t> order(1, 0);
+    order.reserve(tree.size());
+    nodes.reserve(tree.size());
+    nodes.push_back(node{});
+    for(std::size_t i = 0; i < order.size(); ++i)
+    {
+        auto const& t = tree[order[i]];
+        nodes[i].first = static_cast<
+            std::uint32_t>(nodes.size());
+        nodes[i].count = static_cast<
+            std::uint32_t>(t.children.size());
+        for(auto const& c : t.children)
+        {
+            node nd{};
+            nd.label = static_cast<
+                std::uint32_t>(labels.size());
+            nd.size = static_cast<
+                std::uint16_t>(c.first.size());
+            nd.flags = tree[c.second].flags;
+            labels.append(c.first);
+            nodes.push_back(nd);
+            order.push_back(c.second);
+        }
+    }
+    if(labels.size() > 0xffffffff)
+        throw std::length_error(
+            "public_suffix_list too large");
+
+    // write the image
+    header h{};
+    std::memcpy(h.magic, magic, sizeof(h.magic));
+    h.order = byte_order;
+    h.version = version;
+    h.rules = static_cast<std::uint32_t>(rules);
+    h.nodes = static_cast<std::uint32_t>(nodes.size());
+    h.labels = static_cast<std::uint32_t>(labels.size());
+    auto const nn = nodes.size() * sizeof(node);
+    auto const n = sizeof(header) + nn + labels.size();
+    buf_.resize((n + 3) / 4);
+    auto const p = reinterpret_cast<
+        unsigned char*>(buf_.data());
+    std::memcpy(p + sizeof(header), nodes.data(), nn);
+    std::memcpy(p + sizeof(header) + nn,
+        labels.data(), labels.size());
+    h.checksum = checksum(
+        p + sizeof(header), nn + labels.size(),
+        checksum(&h, sizeof(h)));
+    std::memcpy(p, &h, sizeof(h));
+}
+
+auto
+public_suffix_list::
+load(
+    void const* data,
+    std::size_t size) noexcept ->
+        system::result<public_suffix_list>
+{
+    auto const invalid = system::errc::make_error_code(
+        system::errc::illegal_byte_sequence);
+    if( reinterpret_cast<std::uintptr_t>(data) %
+            alignof(header) != 0 ||
+        size < sizeof(header))
+        return invalid;
+    header h;
+    std::memcpy(&h, data, sizeof(h));
+    if(std::memcmp(h.magic, magic, sizeof(h.magic)) != 0)
+        return invalid;
+    if( h.order != byte_order ||
+        h.version != version)
+        return system::errc::make_error_code(
+            system::errc::not_supported);
+    std::uint64_t const n =
+        std::uint64_t(h.nodes) * sizeof(node) +
+        h.labels;
+    if( h.nodes == 0 ||
+        n > size - sizeof(header))
+        return invalid;
+    // the checksum covers the header,
+    // with the checksum set to zero
+    auto const sum = h.checksum;
+    h.checksum = 0;
+    auto const p = static_cast<
+        unsigned char const*>(data) + sizeof(header);
+    if(checksum(p, static_cast<std::size_t>(n),
+            checksum(&h, sizeof(h))) != sum)
+        return invalid;
+
+    // children always follow their parent,
+    // so a lookup cannot loop
+    auto const nodes =
+        reinterpret_cast<node const*>(p);
+    for(std::uint32_t i = 0; i < h.nodes; ++i)
+    {
+        auto const& nd = nodes[i];
+        if(std::uint64_t(nd.label) + nd.size > h.labels)
+            return invalid;
+        if( nd.count != 0 && (
+                nd.first <= i ||
+                std::uint64_t(nd.first) +
+                    nd.count > h.nodes))
+            return invalid;
+    }
+    return public_suffix_list(borrow_t{}, data);
+}
+
+core::string_view
+public_suffix_list::
+image() const noexcept
+{
+    auto const& h = hdr();
+    return core::string_view(
+        reinterpret_cast<char const*>(&h),
+        sizeof(header) +
+            h.nodes * sizeof(node) + h.labels);
+}
+
+auto
+public_suffix_list::
+find_child(
+    node const& parent,
+    core::string_view label) const noexcept ->
+        node const*
+{
+    node const* first = nodes() + parent.first;
+    std::size_t n = parent.count;
+    while(n > 0)
+    {
+        auto const half = n / 2;
+        node const* mid = first + half;
+        int const c = compare_label(label,
+            core::string_view(
+                labels() + mid->label,
+                mid->size));
+        if(c == 0)
+            return mid;
+        if(c > 0)
+        {
+            first = mid + 1;
+            n -= half + 1;
+        }
+        else
+        {
+            n = half;
+        }
+    }
+    return nullptr;
+}
+
+// Return the number of labels in the
+// public suffix of host, or zero
+std::size_t
+public_suffix_list::
+match(core::string_view host) const noexcept
+{
+    // the implicit rule "*" makes the
+    // rightmost label a public suffix
+    std::size_t best = 1;
+    std::size_t n = 0;
+    node const* nd = nodes();
+    std::size_t end = host.size();
+    for(;;)
+    {
+        auto const p = end == 0 ?
+            core::string_view::npos :
+            host.rfind('.', end - 1);
+        auto const start =
+            p == core::string_view::npos ? 0 : p + 1;
+        if(start == end)
+            return n == 0 ? 0 : best;
+        if(nd->flags & node::wildcard)
+            best = n + 1;
+        nd = find_child(*nd, host.substr(
+            start, end - start));
+        if(! nd)
+            return best;
+        ++n;
+        // an exception rule prevails
+        // over every other rule
+        if(nd->flags & node::exception)
+            return n - 1;
+        if(nd->flags & node::rule)
+            best = n;
+        if(start == 0)
+            return best;
+        end = p;
+    }
+}
+
+core::string_view
+public_suffix_list::
+public_suffix(
+    core::string_view host) const noexcept
+{
+    host = strip_dot(host);
+    auto const n = match(host);
+    if(n == 0)
+        return {};
+    return host.substr(suffix_pos(host, n));
+}
+
+core::string_view
+public_suffix_list::
+public_suffix(
+    url_view_base const& u) const noexcept
+{
+    return public_suffix(host_name(u));
+}
+
+core::string_view
+public_suffix_list::
+registrable_domain(
+    core::string_view host) const noexcept
+{
+    host = strip_dot(host);
+    auto const n = match(host);
+    if(n == 0)
+        return {};
+    auto const pos = suffix_pos(host, n + 1);
+    if( pos == core::string_view::npos ||
+        host[pos] == '.')
+        return {};
+    return host.substr(pos);
+}
+
+core::string_view
+public_suffix_list::
+registrable_domain(
+    url_view_base const& u) const noexcept
+{
+    return registrable_domain(host_name(u));
+}
+
+} // urls
+} // boost
@@ -0,0 +1,292 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_PUBLIC_SUFFIX_LIST_HPP
+#define BOOST_URL_PUBLIC_SUFFIX_LIST_HPP
+
+#include <boost/url/error_types.hpp>
+#include <boost/url/url_view_base.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** A compiled Public Suffix List
+
+    The Public Suffix List enumerates the
+    domain suffixes under which anyone can
+    register names, such as "com", "co.uk"
+    or "github.io".
+    https://publicsuffix.org/list/
+
+    The rules are loaded once into a trie
+    of reversed labels, so a lookup visits
+    one node per label of the host instead
+    of every rule in the list. The trie is
+    stored in a single binary image, with
+    fixed-width nodes whose children are
+    sorted and contiguous, followed by
+    every label. The image holds no
+    pointers, so it can be saved to a file
+    and later used in place with @ref load,
+    for example from a memory-mapped file.
+
+    Wildcard rules such as "*.ck" and
+    exception rules such as "!www.ck" are
+    supported, following the algorithm
+    described by the list. Wildcards are
+    only supported as the leftmost label,
+    which is the only form used by the
+    list; other rules containing a
+    wildcard are ignored.
+
+    Objects of this type are never modified
+    after construction, so any number of
+    threads may look up hosts concurrently.
+
+    @par Example
+    @code
+    public_suffix_list const psl( "com\nuk\nco.uk\n" );
+    url_view u( "https://www.example.co.uk/index.htm" );
+    assert( psl.public_suffix( u ) == "co.uk" );
+    assert( psl.registrable_domain( u ) == "example.co.uk" );
+    @endcode
+*/
+class public_suffix_list
+{
+public:
+    /** Constructor
+
+        A default constructed list has no
+        rules, so the public suffix of every
+        host is its rightmost label.
+    */
+    public_suffix_list() noexcept = default;
+
+    /** Constructor
+
+        The rules are parsed from text in the
+        format of `public_suffix_list.dat`:
+        one rule per line, where the rule ends
+        at the first whitespace, and lines
+        starting with "//" are comments.
+        Rules are matched without regard to
+        case.
+
+        @param text The contents of the list
+    */
+    explicit
+    public_suffix_list(
+        core::string_view text);
+
+    /** Return a list which uses a binary image in place
+
+        The image must have been returned by
+        @ref image, possibly on another run of
+        the program. The header and checksum
+        of the image are validated, and every
+        node is checked to refer to valid
+        children and labels. The image is not
+        copied and nothing is allocated, so
+        the image must remain valid while the
+        list or any copy of it is used.
+
+        @par Example
+        @code
+        public_suffix_list const psl0( "com\nuk\nco.uk\n" );
+        std::string const s( psl0.image() );
+        // ... save s, and later
+        auto rv = public_suffix_list::load( s.data(), s.size() );
+        assert( rv->public_suffix( "www.example.co.uk" ) == "co.uk" );
+        @endcode
+
+        @par Complexity
+        Linear in `size`.
+
+        @return The list, or an error if the
+        image is not valid, was produced by
+        an incompatible version, or `data`
+        is not aligned to four bytes.
+
+        @param data The image
+        @param size The size of the image
+    */
+    static
+    system::result<public_suffix_list>
+    load(
+        void const* data,
+        std::size_t size) noexcept;
+
+    /** Return the binary image of the list
+
+        The image can be written to a file
+        and later passed to @ref load. Images
+        are only valid on platforms with the
+        same byte order.
+    */
+    core::string_view
+    image() const noexcept;
+
+    /** Return the number of rules
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return hdr().rules;
+    }
+
+    /** Return the public suffix of a host
+
+        The host is a registered name, which
+        may contain percent-encoded characters.
+        A trailing dot is ignored.
+
+        @return The rightmost labels of the
+        host which form its public suffix, or
+        an empty string if the host is empty.
+    */
+    core::string_view
+    public_suffix(
+        core::string_view host) const noexcept;
+
+    /** Return the public suffix of a URL
+
+        @return The public suffix of the host,
+        or an empty string if the host is not
+        a registered name.
+    */
+    core::string_view
+    public_suffix(
+        url_view_base const& u) const noexcept;
+
+    /** Return the registrable domain of a host
+
+        The registrable domain is the public
+        suffix of the host with the label to
+        its left, which is the part of the
+        name assigned by a registrar.
+
+        @return The rightmost labels of the
+        host which form its registrable
+        domain, or an empty string if the
+        host is itself a public suffix.
+    */
+    core::string_view
+    registrable_domain(
+        core::string_view host) const noexcept;
+
+    /** Return the registrable domain of a URL
+
+        @return The registrable domain of the
+        host, or an empty string if the host
+        is not a registered name or is itself
+        a public suffix.
+    */
+    core::string_view
+    registrable_domain(
+        url_view_base const& u) const noexcept;
+
+private:
+    // A node of the trie
+    struct node
+    {
+        enum : std::uint8_t
+        {
+            // the node is the end of a rule
+            rule = 1,
+            // the node is the end of an
+            // exception rule
+            exception = 2,
+            // any label below the node is
+            // the end of a rule
+            wildcard = 4
+        };
+
+        // offset and size of the
+        // label in the labels
+        std::uint32_t label;
+        std::uint16_t size;
+        std::uint8_t flags;
+        std::uint8_t reserved;
+        // children of the node
+        std::uint32_t first;
+        std::uint32_t count;
+    };
+
+    // The image starts with a header,
+    // followed by the nodes and the labels
+    struct header
+    {
+        char magic[8];
+        // 0x01020304 in native byte order
+        std::uint32_t order;
+        std::uint32_t version;
+        std::uint32_t rules;
+        std::uint32_t nodes;
+        std::uint32_t labels;
+        // FNV-1a of the image, with
+        // this field set to zero
+        std::uint32_t checksum;
+    };
+
+    // the image of a list without rules
+    static
+    void const*
+    empty() noexcept;
+
+    // owned image, if any
+    std::vector<std::uint32_t> buf_;
+    void const* data_ = empty();
+
+    header const&
+    hdr() const noexcept
+    {
+        return *static_cast<header const*>(
+            buf_.empty() ? data_ : buf_.data());
+    }
+
+    node const*
+    nodes() const noexcept
+    {
+        return reinterpret_cast<node const*>(
+            &hdr() + 1);
+    }
+
+    char const*
+    labels() const noexcept
+    {
+        return reinterpret_cast<char const*>(
+            nodes() + hdr().nodes);
+    }
+
+    struct borrow_t {};
+
+    public_suffix_list(
+        borrow_t,
+        void const* data) noexcept
+        : data_(data)
+    {
+    }
+
+    node const*
+    find_child(
+        node const& parent,
+        core::string_view label) const noexcept;
+
+    std::size_t
+    match(core::string_view host) const noexcept;
+};
+
+} // urls
+} // boost
+
+#endif
@@ -14,9 +14,10 @@
     https://publicsuffix.org/list/
 */
 
+#include "mapped_file.hpp"
+#include "public_suffix_list.hpp"
 #include <boost/url/url.hpp>
 #include <boost/url/parse.hpp>
-#include <fstream>
 #include <iostream>
 
 namespace urls = boost::urls;
@@ -28,9 +29,11 @@ int main(int argc, char** argv)
         std::cout << "Usage: suffix_list <url> <suffix_list>\n"
                      "options:\n"
                      "    <url>:              A valid url (required)\n"
-                     "    <suffix_list>:      File with the public suffix list (default: public_suffix_list.dat)\n"
+                     "    <suffix_list>:      File with the public suffix list, or the list\n"
+                     "                        compiled by compile_suffix_list (default: public_suffix_list.dat)\n"
                      "examples:\n"
-                     "suffix_list \"www.example.com\" \"public_suffix_list.dat\"\n";
+                     "suffix_list \"www.example.com\" \"public_suffix_list.dat\"\n"
+                     "suffix_list \"www.example.com\" \"public_suffix_list.bin\"\n";
         return EXIT_FAILURE;
     }
 
@@ -40,42 +43,34 @@ int main(int argc, char** argv)
         argc < 3 ?
             "public_suffix_list.dat" :
             argv[2];
-    std::ifstream fin(filename);
-    if (fin.bad())
+    urls::mapped_file f;
+    if (!f.open(filename.c_str()))
     {
         std::cerr << "Cannot open " << filename << "\n";
         return EXIT_FAILURE;
     }
 
-    std::string comment;
-    std::string suffix;
-    std::string line;
-    while (std::getline(fin, line))
-    {
-        boost::core::string_view sv(line);
-        if (sv.starts_with("//") && suffix.empty())
-        {
-            comment.append(sv.substr(3));
-            comment.append("\n");
-        }
-        else if (line.empty())
-        {
-            if (suffix.empty())
-                comment.clear();
-            else
-                break;
-        }
-        else if (u.encoded_host().ends_with(line))
-        {
-            suffix = line;
-        }
-    }
+    // A compiled list is used in place,
+    // without parsing or allocating.
+    // Otherwise the list is loaded once,
+    // and can then be used for any number
+    // of lookups.
+    urls::public_suffix_list psl;
+    auto rv = urls::public_suffix_list::load(
+        f.data(), f.size());
+    if (rv)
+        psl = *rv;
+    else
+        psl = urls::public_suffix_list(
+            urls::core::string_view(
+                static_cast<char const*>(f.data()),
+                f.size()));
 
     std::cout <<
-        "url:    \n" << u                << "\n\n"
-        "host:   \n" << u.encoded_host() << "\n\n"
-        "suffix: \n" << suffix           << "\n\n"
-        "detail: \n" << comment          << "\n\n";
+        "url:    \n" << u                            << "\n\n"
+        "host:   \n" << u.encoded_host()             << "\n\n"
+        "suffix: \n" << psl.public_suffix(u)         << "\n\n"
+        "domain: \n" << psl.registrable_domain(u)    << "\n\n";
 
     return EXIT_SUCCESS;
 }
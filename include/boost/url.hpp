@@ -13,6 +13,8 @@
 #include <boost/url/grammar.hpp>
 
 #include <boost/url/authority_view.hpp>
+#include <boost/url/basic_url.hpp>
+#include <boost/url/compiled_format.hpp>
 #include <boost/url/decode_view.hpp>
 #include <boost/url/encode.hpp>
 #include <boost/url/encoding_opts.hpp>
@@ -23,12 +25,15 @@
 #include <boost/url/ignore_case.hpp>
 #include <boost/url/ipv4_address.hpp>
 #include <boost/url/ipv6_address.hpp>
+#include <boost/url/normalized_key.hpp>
 #include <boost/url/optional.hpp>
 #include <boost/url/param.hpp>
 #include <boost/url/params_base.hpp>
 #include <boost/url/params_encoded_base.hpp>
 #include <boost/url/params_encoded_ref.hpp>
 #include <boost/url/params_encoded_view.hpp>
+#include <boost/url/params_index.hpp>
+#include <boost/url/params_offsets.hpp>
 #include <boost/url/params_ref.hpp>
 #include <boost/url/params_view.hpp>
 #include <boost/url/parse.hpp>
@@ -40,13 +45,18 @@
 #include <boost/url/segments_encoded_base.hpp>
 #include <boost/url/segments_encoded_ref.hpp>
 #include <boost/url/segments_encoded_view.hpp>
+#include <boost/url/segments_offsets.hpp>
 #include <boost/url/segments_ref.hpp>
 #include <boost/url/segments_view.hpp>
+#include <boost/url/small_url.hpp>
 #include <boost/url/static_url.hpp>
 #include <boost/url/string_view.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/url/url.hpp>
 #include <boost/url/url_base.hpp>
+#include <boost/url/url_batch.hpp>
+#include <boost/url/url_editor.hpp>
+#include <boost/url/url_parser.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/url/url_view_base.hpp>
 #include <boost/url/urls.hpp>
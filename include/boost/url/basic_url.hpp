@@ -0,0 +1,743 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_BASIC_URL_HPP
+#define BOOST_URL_BASIC_URL_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/pointer_traits.hpp>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+template<class Allocator>
+class basic_url;
+#endif
+
+/** Common implementation for all allocator-aware URLs
+
+    This base class is used by the library
+    to provide common functionality for
+    URLs which obtain their storage from
+    an allocator. Users should not use this
+    class directly. Instead, construct an
+    instance of one of the containers
+    or call a parsing function.
+
+    @par Containers
+        @li @ref basic_url
+        @li @ref url
+        @li @ref url_view
+        @li @ref static_url
+
+    @par Parsing Functions
+        @li @ref parse_absolute_uri
+        @li @ref parse_origin_form
+        @li @ref parse_relative_ref
+        @li @ref parse_uri
+        @li @ref parse_uri_reference
+*/
+class BOOST_URL_DECL
+    basic_url_base
+    : public url_base
+{
+    template<class>
+    friend class basic_url;
+
+    // capacity of op_t::old
+    std::size_t old_cap_ = 0;
+
+    ~basic_url_base() = default;
+    basic_url_base() noexcept = default;
+
+    // Return storage for n characters
+    // plus the null terminator
+    virtual char* allocate(std::size_t n) = 0;
+    virtual void deallocate(
+        char* s, std::size_t n) noexcept = 0;
+
+    void release() noexcept;
+    void steal(basic_url_base& u) noexcept;
+    void swap_impl(basic_url_base& u) noexcept;
+    void clear_impl() noexcept override;
+    void reserve_impl(std::size_t, op_t&) override;
+    void cleanup(op_t&) override;
+
+    void
+    copy(url_view_base const& u)
+    {
+        this->url_base::copy(u);
+    }
+};
+
+//------------------------------------------------
+
+/** A modifiable container for a URL, using an allocator.
+
+    This container owns a url, represented
+    by a null-terminated character buffer
+    obtained from the allocator.
+    The contents may be inspected and modified,
+    and the implementation maintains a useful
+    invariant: changes to the url always
+    leave it in a valid state.
+
+    Unlike @ref url, which always uses the
+    global heap, the storage may come from
+    an arena or monotonic buffer which
+    is freed in bulk.
+
+    @par Example
+    @code
+    std::pmr::monotonic_buffer_resource mr;
+    basic_url< std::pmr::polymorphic_allocator< char > > u(
+        "https://www.example.com", &mr );
+    @endcode
+
+    @tparam Allocator The allocator to use.
+    It is rebound to `char`.
+
+    @see
+        @ref url,
+        @ref static_url,
+        @ref url_view.
+*/
+template<class Allocator>
+class basic_url
+    : public basic_url_base
+    , private empty_value<typename
+        std::allocator_traits<Allocator>::
+            template rebind_alloc<char>>
+{
+    using alloc_type = typename
+        std::allocator_traits<Allocator>::
+            template rebind_alloc<char>;
+    using traits = std::allocator_traits<
+        alloc_type>;
+
+    friend std::hash<basic_url>;
+    using url_view_base::digest;
+
+    alloc_type&
+    alloc() noexcept
+    {
+        return empty_value<alloc_type>::get();
+    }
+
+    alloc_type const&
+    alloc() const noexcept
+    {
+        return empty_value<alloc_type>::get();
+    }
+
+    char*
+    allocate(std::size_t n) override
+    {
+        return boost::to_address(
+            traits::allocate(alloc(), n + 1));
+    }
+
+    void
+    deallocate(
+        char* s, std::size_t n) noexcept override
+    {
+        traits::deallocate(alloc(),
+            std::pointer_traits<typename
+                traits::pointer>::pointer_to(*s),
+            n + 1);
+    }
+
+public:
+    /** The allocator type
+    */
+    using allocator_type = Allocator;
+
+    //--------------------------------------------
+    //
+    // Special Members
+    //
+    //--------------------------------------------
+
+    /** Destructor
+
+        Any params, segments, iterators, or
+        views which reference this object are
+        invalidated. The underlying character
+        buffer is returned to the allocator,
+        invalidating all references to it.
+    */
+    ~basic_url()
+    {
+        release();
+    }
+
+    /** Constructor
+
+        Default constructed urls contain
+        a zero-length string. No memory
+        is allocated.
+
+        @par Postconditions
+        @code
+        this->empty() == true
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    basic_url() noexcept(
+        std::is_nothrow_default_constructible<
+            Allocator>::value)
+        : basic_url(Allocator())
+    {
+    }
+
+    /** Constructor
+
+        Constructs an empty url which will
+        obtain its storage from `a`.
+        No memory is allocated.
+
+        @par Postconditions
+        @code
+        this->empty() == true
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param a The allocator to use.
+    */
+    explicit
+    basic_url(
+        Allocator const& a) noexcept
+        : empty_value<alloc_type>(
+            empty_init, alloc_type(a))
+    {
+    }
+
+    /** Constructor
+
+        This function constructs a URL from
+        the string `s`, which must contain a
+        valid <em>URI</em> or <em>relative-ref</em>
+        or else an exception is thrown.
+        The new url retains ownership by
+        allocating a copy of the passed string
+        from `a`.
+
+        @par Example
+        @code
+        basic_url< std::allocator< char > > u( "https://www.example.com" );
+        @endcode
+
+        @par Postconditions
+        @code
+        this->buffer().data() != s.data()
+        @endcode
+
+        @par Complexity
+        Linear in `s.size()`.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+        Exceptions thrown on invalid input.
+
+        @throw system_error
+        The input does not contain a valid url.
+
+        @param s The string to parse.
+
+        @param a The allocator to use.
+    */
+    explicit
+    basic_url(
+        core::string_view s,
+        Allocator const& a = Allocator())
+        : basic_url(a)
+    {
+        copy(parse_uri_reference(s
+            ).value(BOOST_URL_POS));
+    }
+
+    /** Constructor
+
+        The newly constructed object contains
+        a copy of `u`. The allocator is
+        obtained as if by
+        `select_on_container_copy_construction`.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    basic_url(
+        basic_url const& u)
+        : basic_url(Allocator(traits::
+            select_on_container_copy_construction(
+                u.alloc())))
+    {
+        copy(u);
+    }
+
+    /** Constructor
+
+        The newly constructed object contains
+        a copy of `u`, allocated from `a`.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+
+        @param a The allocator to use.
+    */
+    basic_url(
+        url_view_base const& u,
+        Allocator const& a = Allocator())
+        : basic_url(a)
+    {
+        copy(u);
+    }
+
+    /** Constructor
+
+        This function performs a move-construction
+        from `u`. After the move, the state of `u`
+        will be as-if default constructed.
+
+        @par Postconditions
+        @code
+        u.empty() == true
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param u The url to move from.
+    */
+    basic_url(basic_url&& u) noexcept
+        : empty_value<alloc_type>(
+            empty_init, std::move(u.alloc()))
+    {
+        steal(u);
+    }
+
+    /** Constructor
+
+        This function performs a move-construction
+        from `u` using the allocator `a`. When
+        `a` does not compare equal to the allocator
+        of `u`, the contents are copied.
+
+        @par Complexity
+        Constant if the allocators are equal,
+        otherwise linear in `u.size()`.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param u The url to move from.
+
+        @param a The allocator to use.
+    */
+    basic_url(
+        basic_url&& u,
+        Allocator const& a)
+        : basic_url(a)
+    {
+        if(alloc() == u.alloc())
+            steal(u);
+        else
+            copy(u);
+    }
+
+    /** Assignment
+
+        The contents of `u` are copied and
+        the previous contents of `this` are
+        discarded. The allocator is replaced
+        when it propagates on copy assignment.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    basic_url&
+    operator=(basic_url const& u)
+    {
+        if(this == &u)
+            return *this;
+        if( traits::propagate_on_container_copy_assignment::value &&
+            alloc() != u.alloc())
+        {
+            basic_url tmp(u, Allocator(u.alloc()));
+            release();
+            alloc() = u.alloc();
+            steal(tmp);
+            return *this;
+        }
+        copy(u);
+        return *this;
+    }
+
+    /** Assignment
+
+        The contents of `u` are moved into
+        `this` when the allocator propagates
+        on move assignment or the allocators
+        compare equal, otherwise they are
+        copied.
+        After the move, the state of `u`
+        will be as-if default constructed.
+
+        @par Complexity
+        Constant if the contents are moved,
+        otherwise linear in `u.size()`.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param u The url to move from.
+    */
+    basic_url&
+    operator=(basic_url&& u) noexcept(
+        traits::propagate_on_container_move_assignment::value)
+    {
+        if(this == &u)
+            return *this;
+        if(traits::propagate_on_container_move_assignment::value)
+        {
+            release();
+            alloc() = std::move(u.alloc());
+            steal(u);
+        }
+        else if(alloc() == u.alloc())
+        {
+            release();
+            steal(u);
+        }
+        else
+        {
+            copy(u);
+        }
+        return *this;
+    }
+
+    /** Assignment
+
+        The contents of `u` are copied and
+        the previous contents of `this` are
+        discarded.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    basic_url&
+    operator=(url_view_base const& u)
+    {
+        copy(u);
+        return *this;
+    }
+
+    //--------------------------------------------
+    //
+    // Observers
+    //
+    //--------------------------------------------
+
+    /** Return the allocator
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return allocator_type(alloc());
+    }
+
+    //--------------------------------------------
+
+    /** Swap the contents.
+
+        Exchanges the contents of this url with another
+        url. All views, iterators and references remain valid.
+        The allocators are exchanged when they propagate
+        on swap, otherwise they must compare equal.
+
+        If `this == &other`, this function call has no effect.
+
+        @par Example
+        @code
+        basic_url< std::allocator< char > > u1( "https://www.example.com" );
+        basic_url< std::allocator< char > > u2( "https://www.boost.org" );
+        u1.swap(u2);
+        assert(u1 == "https://www.boost.org" );
+        assert(u2 == "https://www.example.com" );
+        @endcode
+
+        @par Complexity
+        Constant
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param other The object to swap with
+
+    */
+    void
+    swap(basic_url& other) noexcept
+    {
+        if(this == &other)
+            return;
+        if(traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(alloc(), other.alloc());
+        }
+        else
+        {
+            BOOST_ASSERT(alloc() == other.alloc());
+        }
+        swap_impl(other);
+    }
+
+    /** Swap
+
+        Exchanges the contents of `v0` with another `v1`.
+        All views, iterators and references remain
+        valid.
+
+        If `&v0 == &v1`, this function call has no effect.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param v0 The first object to swap
+        @param v1 The second object to swap
+
+        @see
+            @ref basic_url::swap
+    */
+    friend
+    void
+    swap(basic_url& v0, basic_url& v1) noexcept
+    {
+        v0.swap(v1);
+    }
+
+    //--------------------------------------------
+    //
+    // fluent api
+    //
+
+    /// @copydoc url_base::set_scheme
+    basic_url& set_scheme(core::string_view s) { url_base::set_scheme(s); return *this; }
+    /// @copydoc url_base::set_scheme_id
+    basic_url& set_scheme_id(urls::scheme id) { url_base::set_scheme_id(id); return *this; }
+    /// @copydoc url_base::remove_scheme
+    basic_url& remove_scheme() { url_base::remove_scheme(); return *this; }
+
+    /// @copydoc url_base::set_encoded_authority
+    basic_url& set_encoded_authority(pct_string_view s) { url_base::set_encoded_authority(s); return *this; }
+    /// @copydoc url_base::remove_authority
+    basic_url& remove_authority() { url_base::remove_authority(); return *this; }
+
+    /// @copydoc url_base::set_userinfo
+    basic_url& set_userinfo(core::string_view s) { url_base::set_userinfo(s); return *this; }
+    /// @copydoc url_base::set_encoded_userinfo
+    basic_url& set_encoded_userinfo(pct_string_view s) { url_base::set_encoded_userinfo(s); return *this; }
+    /// @copydoc url_base::remove_userinfo
+    basic_url& remove_userinfo() noexcept { url_base::remove_userinfo(); return *this; }
+    /// @copydoc url_base::set_user
+    basic_url& set_user(core::string_view s) { url_base::set_user(s); return *this; }
+    /// @copydoc url_base::set_encoded_user
+    basic_url& set_encoded_user(pct_string_view s) { url_base::set_encoded_user(s); return *this; }
+    /// @copydoc url_base::set_password
+    basic_url& set_password(core::string_view s) { url_base::set_password(s); return *this; }
+    /// @copydoc url_base::set_encoded_password
+    basic_url& set_encoded_password(pct_string_view s) { url_base::set_encoded_password(s); return *this; }
+    /// @copydoc url_base::remove_password
+    basic_url& remove_password() noexcept { url_base::remove_password(); return *this; }
+
+    /// @copydoc url_base::set_host
+    basic_url& set_host(core::string_view s) { url_base::set_host(s); return *this; }
+    /// @copydoc url_base::set_encoded_host
+    basic_url& set_encoded_host(pct_string_view s) { url_base::set_encoded_host(s); return *this; }
+    /// @copydoc url_base::set_host_address
+    basic_url& set_host_address(core::string_view s) { url_base::set_host_address(s); return *this; }
+    /// @copydoc url_base::set_encoded_host_address
+    basic_url& set_encoded_host_address(pct_string_view s) { url_base::set_encoded_host_address(s); return *this; }
+    /// @copydoc url_base::set_host_ipv4
+    basic_url& set_host_ipv4(ipv4_address const& addr) { url_base::set_host_ipv4(addr); return *this; }
+    /// @copydoc url_base::set_host_ipv6
+    basic_url& set_host_ipv6(ipv6_address const& addr) { url_base::set_host_ipv6(addr); return *this; }
+    /// @copydoc url_base::set_host_ipvfuture
+    basic_url& set_host_ipvfuture(core::string_view s) { url_base::set_host_ipvfuture(s); return *this; }
+    /// @copydoc url_base::set_host_name
+    basic_url& set_host_name(core::string_view s) { url_base::set_host_name(s); return *this; }
+    /// @copydoc url_base::set_encoded_host_name
+    basic_url& set_encoded_host_name(pct_string_view s) { url_base::set_encoded_host_name(s); return *this; }
+    /// @copydoc url_base::set_port_number
+    basic_url& set_port_number(std::uint16_t n) { url_base::set_port_number(n); return *this; }
+    /// @copydoc url_base::set_port
+    basic_url& set_port(core::string_view s) { url_base::set_port(s); return *this; }
+    /// @copydoc url_base::remove_port
+    basic_url& remove_port() noexcept { url_base::remove_port(); return *this; }
+
+    /// @copydoc url_base::set_path_absolute
+    //bool set_path_absolute(bool absolute);
+    /// @copydoc url_base::set_path
+    basic_url& set_path(core::string_view s) { url_base::set_path(s); return *this; }
+    /// @copydoc url_base::set_encoded_path
+    basic_url& set_encoded_path(pct_string_view s) { url_base::set_encoded_path(s); return *this; }
+
+    /// @copydoc url_base::set_query
+    basic_url& set_query(core::string_view s) { url_base::set_query(s); return *this; }
+    /// @copydoc url_base::set_encoded_query
+    basic_url& set_encoded_query(pct_string_view s) { url_base::set_encoded_query(s); return *this; }
+    /// @copydoc url_base::set_params
+    basic_url& set_params(std::initializer_list<param_view> ps, encoding_opts opts = {}) { url_base::set_params(ps, opts); return *this; }
+    /// @copydoc url_base::remove_query
+    basic_url& remove_query() noexcept { url_base::remove_query(); return *this; }
+
+    /// @copydoc url_base::remove_fragment
+    basic_url& remove_fragment() noexcept { url_base::remove_fragment(); return *this; }
+    /// @copydoc url_base::set_fragment
+    basic_url& set_fragment(core::string_view s) { url_base::set_fragment(s); return *this; }
+    /// @copydoc url_base::set_encoded_fragment
+    basic_url& set_encoded_fragment(pct_string_view s) { url_base::set_encoded_fragment(s); return *this; }
+
+    /// @copydoc url_base::remove_origin
+    basic_url& remove_origin() { url_base::remove_origin(); return *this; }
+
+    /// @copydoc url_base::normalize
+    basic_url& normalize() { url_base::normalize(); return *this; }
+    /// @copydoc url_base::normalize_scheme
+    basic_url& normalize_scheme() { url_base::normalize_scheme(); return *this; }
+    /// @copydoc url_base::normalize_authority
+    basic_url& normalize_authority() { url_base::normalize_authority(); return *this; }
+    /// @copydoc url_base::normalize_path
+    basic_url& normalize_path() { url_base::normalize_path(); return *this; }
+    /// @copydoc url_base::normalize_query
+    basic_url& normalize_query() { url_base::normalize_query(); return *this; }
+    /// @copydoc url_base::normalize_fragment
+    basic_url& normalize_fragment() { url_base::normalize_fragment(); return *this; }
+
+    //--------------------------------------------
+};
+
+} // urls
+} // boost
+
+//------------------------------------------------
+
+// std::hash specialization
+#ifndef BOOST_URL_DOCS
+namespace std {
+template<class Allocator>
+struct hash< ::boost::urls::basic_url<Allocator> >
+{
+    hash() = default;
+    hash(hash const&) = default;
+    hash& operator=(hash const&) = default;
+
+    explicit
+    hash(std::size_t salt) noexcept
+        : salt_(salt)
+    {
+    }
+
+    hash(
+        std::size_t salt,
+        ::boost::urls::hash_algorithm alg) noexcept
+        : salt_(salt)
+        , alg_(alg)
+    {
+    }
+
+    std::size_t
+    operator()(::boost::urls::basic_url<Allocator> const& u) const noexcept
+    {
+        return u.digest(salt_, alg_);
+    }
+
+private:
+    std::size_t salt_ = 0;
+    ::boost::urls::hash_algorithm alg_ =
+        ::boost::urls::hash_algorithm::block;
+};
+} // std
+#endif
+
+#endif
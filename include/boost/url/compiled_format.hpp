@@ -0,0 +1,310 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_COMPILED_FORMAT_HPP
+#define BOOST_URL_COMPILED_FORMAT_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/format.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/detail/format_args.hpp>
+#include <boost/url/detail/vformat.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+namespace detail {
+struct pattern;
+}
+#endif
+
+/** A format URL string parsed ahead of time
+
+    Objects of this type hold a format URL
+    string which was parsed once, on
+    construction. The string is split into
+    its URL components, and each component
+    into literals and replacement fields,
+    with the encoded size of every literal
+    precomputed.
+
+    Formatting with a compiled format gives
+    the same result as formatting with the
+    string it was constructed from, but the
+    format string is not parsed again. When
+    the destination has enough capacity,
+    formatting does not allocate.
+
+    @par Example
+    @code
+    compiled_format const fmt( "https://{}/api/v1/users/{id}" );
+
+    url u = format( fmt, "example.com", arg( "id", 42 ) );
+    assert( u.buffer() == "https://example.com/api/v1/users/42" );
+
+    format_to( u, fmt, "example.org", arg( "id", 43 ) );
+    assert( u.buffer() == "https://example.org/api/v1/users/43" );
+    @endcode
+
+    @par Lifetime
+    The format string is copied, so it does
+    not need to remain valid after
+    construction.
+
+    @see
+        @ref format,
+        @ref format_to.
+*/
+class BOOST_URL_DECL compiled_format
+{
+    std::string s_;
+    std::vector<detail::format_piece> pieces_;
+
+    // position and size of each component
+    // in s_, and the first piece of each
+    std::size_t pos_[detail::parts_base::id_end + 1] = {};
+    std::size_t len_[detail::parts_base::id_end + 1] = {};
+    std::size_t first_[detail::parts_base::id_end + 2] = {};
+
+    bool has_authority_ = false;
+    bool has_user_ = false;
+    bool has_pass_ = false;
+    bool has_port_ = false;
+    bool has_query_ = false;
+    bool has_frag_ = false;
+
+    friend struct detail::pattern;
+
+public:
+    /** Constructor
+
+        The format URL string is parsed and
+        split into pieces.
+
+        @par Example
+        @code
+        compiled_format fmt( "{scheme}://{host}:{port}/{path}" );
+        @endcode
+
+        @par Complexity
+        Linear in `fmt.size()`.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+        Exceptions thrown on invalid input.
+
+        @throw system_error
+        `fmt` is not a valid format URL string.
+
+        @param fmt The format URL string.
+    */
+    explicit
+    compiled_format(
+        core::string_view fmt);
+
+    /** Return the format URL string
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    core::string_view
+    buffer() const noexcept
+    {
+        return s_;
+    }
+};
+
+/** Format arguments into a URL
+
+    Format arguments according to a compiled
+    format URL string into a @ref url.
+
+    The result is the same as calling
+    @ref format with the string the compiled
+    format was constructed from.
+
+    @par Example
+    @code
+    compiled_format const fmt( "user/{}" );
+    assert( format( fmt, 1 ).buffer() == "user/1" );
+    @endcode
+
+    @return A URL holding the formatted result.
+
+    @param fmt The compiled format URL string.
+    @param args Arguments to be formatted.
+
+    @throws system_error
+    The result contains an invalid URL after
+    replacements are applied.
+
+    @see
+        @ref compiled_format,
+        @ref format_to.
+*/
+template <class... Args>
+url
+format(
+    compiled_format const& fmt,
+    Args&&... args)
+{
+    return detail::vformat(
+        fmt, detail::make_format_args(
+            std::forward<Args>(args)...));
+}
+
+/** Format arguments into a URL
+
+    Format arguments according to a compiled
+    format URL string into a @ref url_base.
+
+    The previous contents of `u` are
+    replaced, keeping its capacity, so a
+    url can be reused to format many
+    results. When `u` has enough capacity
+    for the result, this function does not
+    allocate.
+
+    @par Example
+    @code
+    compiled_format const fmt( "user/{}" );
+    static_url<30> u;
+    format_to( u, fmt, 1 );
+    assert( u.buffer() == "user/1" );
+    @endcode
+
+    @par Exception Safety
+    Basic guarantee.
+    If the result does not fit, `u` is unchanged.
+
+    @param u An object that derives from @ref url_base.
+    @param fmt The compiled format URL string.
+    @param args Arguments to be formatted.
+
+    @throws system_error
+    `u` contains an invalid URL after
+    replacements are applied.
+
+    @see
+        @ref compiled_format,
+        @ref format.
+*/
+template <class... Args>
+void
+format_to(
+    url_base& u,
+    compiled_format const& fmt,
+    Args&&... args)
+{
+    detail::vformat_to(
+        u, fmt, detail::make_format_args(
+            std::forward<Args>(args)...));
+}
+
+/** Format arguments into a URL
+
+    Format type-erased arguments according
+    to a compiled format URL string into a
+    @ref url.
+
+    @par Example
+    @code
+    compiled_format const fmt( "user/{id}" );
+    assert( format( fmt, {{"id", 1}} ).buffer() == "user/1" );
+    @endcode
+
+    @return A URL holding the formatted result.
+
+    @param fmt The compiled format URL string.
+    @param args Arguments to be formatted.
+
+    @throws system_error
+    The result contains an invalid URL after
+    replacements are applied.
+
+    @see
+        @ref compiled_format,
+        @ref format_to.
+*/
+inline
+url
+format(
+    compiled_format const& fmt,
+#ifdef BOOST_URL_DOCS
+    std::initializer_list<__see_below__> args
+#else
+    std::initializer_list<see_below::format_arg> args
+#endif
+    )
+{
+    return detail::vformat(
+        fmt, detail::format_args(
+            args.begin(), args.end()));
+}
+
+/** Format arguments into a URL
+
+    Format type-erased arguments according
+    to a compiled format URL string into a
+    @ref url_base, replacing its previous
+    contents.
+
+    @par Example
+    @code
+    compiled_format const fmt( "user/{id}" );
+    static_url<30> u;
+    format_to( u, fmt, {{"id", 1}} );
+    assert( u.buffer() == "user/1" );
+    @endcode
+
+    @par Exception Safety
+    Basic guarantee.
+    If the result does not fit, `u` is unchanged.
+
+    @param u An object that derives from @ref url_base.
+    @param fmt The compiled format URL string.
+    @param args Arguments to be formatted.
+
+    @throws system_error
+    `u` contains an invalid URL after
+    replacements are applied.
+
+    @see
+        @ref compiled_format,
+        @ref format.
+*/
+inline
+void
+format_to(
+    url_base& u,
+    compiled_format const& fmt,
+#ifdef BOOST_URL_DOCS
+    std::initializer_list<__see_below__> args
+#else
+    std::initializer_list<see_below::format_arg> args
+#endif
+    )
+{
+    detail::vformat_to(
+        u, fmt, detail::format_args(
+            args.begin(), args.end()));
+}
+
+} // urls
+} // boost
+
+#endif
@@ -12,6 +12,7 @@
 
 #include <boost/url/param.hpp>
 #include <boost/url/pct_string_view.hpp>
+#include <boost/url/detail/range_buffer.hpp>
 #include <boost/static_assert.hpp>
 #include <cstddef>
 #include <iterator>
@@ -167,7 +168,8 @@ protected:
 //------------------------------------------------
 
 // A range of plain query params_ref
-template<class FwdIt>
+template<class FwdIt, bool =
+    is_random_access_iter<FwdIt>::value>
 struct params_iter
     : any_params_iter
     , private params_iter_base
@@ -221,6 +223,70 @@ private:
     }
 };
 
+// A random access range of plain query
+// params_ref, encoded once when measured
+template<class FwdIt>
+struct params_iter<FwdIt, true>
+    : any_params_iter
+    , private params_iter_base
+{
+    BOOST_STATIC_ASSERT(
+        std::is_convertible<
+            typename std::iterator_traits<
+                FwdIt>::reference,
+            param_view>::value);
+
+    params_iter(
+        FwdIt first,
+        FwdIt last) noexcept
+        : any_params_iter(
+            first == last)
+        , it0_(first)
+        , it_(first)
+        , end_(last)
+        , buf_('&')
+    {
+    }
+
+private:
+    FwdIt it0_;
+    FwdIt it_;
+    FwdIt end_;
+    range_buffer buf_;
+
+    void
+    rewind() noexcept override
+    {
+        it_ = it0_;
+        buf_.rewind();
+    }
+
+    bool
+    measure(
+        std::size_t& n) override
+    {
+        if(it_ == end_)
+            return false;
+        if(it_ == it0_)
+            buf_.clear();
+        param_view const p(*it_++);
+        std::size_t const nmax = 1 + 3 * (
+            p.key.size() + p.value.size());
+        char* dest = buf_.prepare(nmax);
+        copy_impl(dest, dest + nmax, p);
+        n += buf_.commit(dest);
+        return true;
+    }
+
+    void
+    copy(
+        char*& dest,
+        char const* end) noexcept override
+    {
+        buf_.copy(dest, end);
+    }
+};
+
 //------------------------------------------------
 //
 // param_encoded_iter
@@ -276,7 +342,8 @@ protected:
 //------------------------------------------------
 
 // A range of encoded query params_ref
-template<class FwdIt>
+template<class FwdIt, bool =
+    is_random_access_iter<FwdIt>::value>
 struct params_encoded_iter
     : any_params_iter
     , private params_encoded_iter_base
@@ -333,6 +400,72 @@ private:
     }
 };
 
+// A random access range of encoded query
+// params_ref, re-encoded once when measured
+template<class FwdIt>
+struct params_encoded_iter<FwdIt, true>
+    : any_params_iter
+    , private params_encoded_iter_base
+{
+    BOOST_STATIC_ASSERT(
+        std::is_convertible<
+            typename std::iterator_traits<
+                FwdIt>::reference,
+            param_view>::value);
+
+    params_encoded_iter(
+        FwdIt first,
+        FwdIt last) noexcept
+        : any_params_iter(
+            first == last)
+        , it0_(first)
+        , it_(first)
+        , end_(last)
+        , buf_('&')
+    {
+    }
+
+private:
+    FwdIt it0_;
+    FwdIt it_;
+    FwdIt end_;
+    range_buffer buf_;
+
+    void
+    rewind() noexcept override
+    {
+        it_ = it0_;
+        buf_.rewind();
+    }
+
+    bool
+    measure(
+        std::size_t& n) override
+    {
+        if(it_ == end_)
+            return false;
+        if(it_ == it0_)
+            buf_.clear();
+        // throw on invalid input
+        param_pct_view const p(
+            param_view(*it_++));
+        std::size_t const nmax = 1 + 3 * (
+            p.key.size() + p.value.size());
+        char* dest = buf_.prepare(nmax);
+        copy_impl(dest, dest + nmax, p);
+        n += buf_.commit(dest);
+        return true;
+    }
+
+    void
+    copy(
+        char*& dest,
+        char const* end) noexcept override
+    {
+        buf_.copy(dest, end);
+    }
+};
+
 //------------------------------------------------
 //
 // param_value_iter
@@ -11,6 +11,7 @@
 #define BOOST_URL_DETAIL_ANY_SEGMENTS_ITER_HPP
 
 #include <boost/url/pct_string_view.hpp>
+#include <boost/url/detail/range_buffer.hpp>
 #include <boost/static_assert.hpp>
 #include <cstddef>
 #include <iterator>
@@ -115,7 +116,8 @@ protected:
 
 // iterates segments in a
 // plain segment range
-template<class FwdIt>
+template<class FwdIt, bool =
+    is_random_access_iter<FwdIt>::value>
 struct segments_iter
     : any_segments_iter
     , segments_iter_base
@@ -183,6 +185,78 @@ private:
     }
 };
 
+// iterates segments in a random access
+// plain segment range, encoding each
+// segment once when it is measured
+template<class FwdIt>
+struct segments_iter<FwdIt, true>
+    : any_segments_iter
+    , segments_iter_base
+{
+    BOOST_STATIC_ASSERT(
+        std::is_convertible<
+            typename std::iterator_traits<
+                FwdIt>::reference,
+            core::string_view>::value);
+
+    segments_iter(
+        FwdIt first,
+        FwdIt last) noexcept
+        : it_(first)
+        , it0_(first)
+        , end_(last)
+        , buf_('/')
+    {
+        if(first != last)
+        {
+            front = *first;
+            fast_nseg = last - first > 1 ? 2 : 1;
+        }
+        else
+        {
+            fast_nseg = 0;
+        }
+    }
+
+private:
+    FwdIt it_;
+    FwdIt it0_;
+    FwdIt end_;
+    range_buffer buf_;
+
+    void
+    rewind() noexcept override
+    {
+        it_ = it0_;
+        buf_.rewind();
+    }
+
+    bool
+    measure(
+        std::size_t& n) override
+    {
+        if(it_ == end_)
+            return false;
+        if(it_ == it0_)
+            buf_.clear();
+        core::string_view const s =
+            detail::to_sv(*it_++);
+        char* dest = buf_.prepare(3 * s.size());
+        copy_impl(dest, dest + 3 * s.size(),
+            s, encode_colons);
+        n += buf_.commit(dest);
+        return true;
+    }
+
+    void
+    copy(
+        char*& dest,
+        char const* end) noexcept override
+    {
+        buf_.copy(dest, end);
+    }
+};
+
 //------------------------------------------------
 //
 // segment_encoded_iter
@@ -229,7 +303,8 @@ protected:
 
 // iterates segments in an
 // encoded segment range
-template<class FwdIt>
+template<class FwdIt, bool =
+    is_random_access_iter<FwdIt>::value>
 struct segments_encoded_iter
     : public any_segments_iter
     , public segments_encoded_iter_base
@@ -300,6 +375,81 @@ private:
     }
 };
 
+// iterates segments in a random access
+// encoded segment range, re-encoding each
+// segment once when it is measured
+template<class FwdIt>
+struct segments_encoded_iter<FwdIt, true>
+    : public any_segments_iter
+    , public segments_encoded_iter_base
+{
+    BOOST_STATIC_ASSERT(
+        std::is_convertible<
+            typename std::iterator_traits<
+                FwdIt>::reference,
+            core::string_view>::value);
+
+    segments_encoded_iter(
+        FwdIt first,
+        FwdIt last)
+        : it_(first)
+        , it0_(first)
+        , end_(last)
+        , buf_('/')
+    {
+        if(it_ != end_)
+        {
+            // throw on invalid input
+            front = pct_string_view(
+                detail::to_sv(*first));
+            fast_nseg = last - first > 1 ? 2 : 1;
+        }
+        else
+        {
+            fast_nseg = 0;
+        }
+    }
+
+private:
+    FwdIt it_;
+    FwdIt it0_;
+    FwdIt end_;
+    range_buffer buf_;
+
+    void
+    rewind() noexcept override
+    {
+        it_ = it0_;
+        buf_.rewind();
+    }
+
+    bool
+    measure(
+        std::size_t& n) override
+    {
+        if(it_ == end_)
+            return false;
+        if(it_ == it0_)
+            buf_.clear();
+        // throw on invalid input
+        pct_string_view const s(
+            detail::to_sv(*it_++));
+        char* dest = buf_.prepare(3 * s.size());
+        copy_impl(dest, dest + 3 * s.size(),
+            s, encode_colons);
+        n += buf_.commit(dest);
+        return true;
+    }
+
+    void
+    copy(
+        char*& dest,
+        char const* end) noexcept override
+    {
+        buf_.copy(dest, end);
+    }
+};
+
 //------------------------------------------------
 
 template<class FwdIt>
@@ -52,6 +52,25 @@
 # endif
 #endif
 
+// Kernels for instruction sets beyond the
+// baseline are compiled with a target
+// attribute and selected at runtime.
+#if defined(__GNUC__) || defined(__clang__)
+# define BOOST_URL_TARGET(isa) __attribute__((target(isa)))
+#else
+# define BOOST_URL_TARGET(isa)
+#endif
+
+// Set up NEON
+#if ! defined(BOOST_URL_NO_NEON) && \
+    ! defined(BOOST_URL_USE_NEON)
+# if (defined(__ARM_NEON) || defined(_M_ARM64)) && \
+     (defined(__aarch64__) || defined(_M_ARM64)) && \
+     ! defined(__ARM_BIG_ENDIAN)
+#  define BOOST_URL_USE_NEON
+# endif
+#endif
+
 // constexpr
 #if BOOST_WORKAROUND( BOOST_GCC_VERSION, <= 72000 ) || \
     BOOST_WORKAROUND( BOOST_CLANG_VERSION, <= 35000 )
@@ -94,12 +113,30 @@
 #define BOOST_URL_RETURN(x) return (x)
 #endif
 
+// Unsigned type for the offsets and decoded
+// sizes stored in url_view and url. A
+// narrower type such as std::uint32_t makes
+// these objects smaller, and lowers max_size
+#ifndef BOOST_URL_OFFSET_TYPE
+#define BOOST_URL_OFFSET_TYPE std::size_t
+#endif
+
 // Limit tests
 #ifndef BOOST_URL_MAX_SIZE
 // we leave room for a null,
-// and still fit in size_t
-#define BOOST_URL_MAX_SIZE ((std::size_t(-1))-1)
+// and still fit in the offset type
+#define BOOST_URL_MAX_SIZE ((std::size_t( \
+    static_cast<BOOST_URL_OFFSET_TYPE>(-1)))-1)
+#endif
+
+// Maximum number of instances of each
+// type retained by a recycle bin
+#ifndef BOOST_URL_RECYCLED_CAPACITY
+#define BOOST_URL_RECYCLED_CAPACITY 16
 #endif
+static_assert(
+    BOOST_URL_RECYCLED_CAPACITY > 0,
+    "BOOST_URL_RECYCLED_CAPACITY must be positive");
 
 // noinline attribute
 #ifdef BOOST_GCC
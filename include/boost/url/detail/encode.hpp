@@ -13,9 +13,12 @@
 
 #include <boost/url/encoding_opts.hpp>
 #include <boost/url/pct_string_view.hpp>
+#include <boost/url/grammar/charset.hpp>
+#include <boost/url/grammar/lut_chars.hpp>
 #include <boost/url/grammar/hexdig_chars.hpp>
 #include <boost/core/ignore_unused.hpp>
 #include <cstdlib>
+#include <cstring>
 
 namespace boost {
 namespace urls {
@@ -28,6 +31,217 @@ char const* const hexdigs[] = {
 
 //------------------------------------------------
 
+// Return the size of s after encoding.
+// Each character of s takes one byte
+// or three, without branches.
+template<class CharSet>
+std::size_t
+encoded_size_impl(
+    core::string_view s,
+    CharSet const& unreserved,
+    bool space_as_plus) noexcept
+{
+    std::size_t n = 0;
+    auto it = s.data();
+    auto const last = it + s.size();
+    if(! space_as_plus)
+    {
+        while(it != last)
+        {
+            n += unreserved(*it) ? 1 : 3;
+            ++it;
+        }
+    }
+    else
+    {
+        while(it != last)
+        {
+            auto const c = *it;
+            n += (unreserved(c) ||
+                c == ' ') ? 1 : 3;
+            ++it;
+        }
+    }
+    return n;
+}
+
+// lut_chars counts its members
+// a block at a time
+inline
+std::size_t
+encoded_size_impl(
+    core::string_view s,
+    grammar::lut_chars const& unreserved,
+    bool space_as_plus) noexcept
+{
+    auto const first = s.data();
+    auto const last = first + s.size();
+    std::size_t const kept = space_as_plus ?
+        (unreserved + grammar::lut_chars(' ')
+            ).count(first, last) :
+        unreserved.count(first, last);
+    return s.size() + 2 * (s.size() - kept);
+}
+
+/*  Runs of unreserved characters at least
+    this long are copied a block at a time,
+    using the vector kernels of lut_chars.
+*/
+constexpr std::size_t encode_run_size = 16;
+
+inline
+void
+encode_one(
+    char*& dest,
+    unsigned char c,
+    char const* hex) noexcept
+{
+    dest[0] = '%';
+    dest[1] = hex[c >> 4];
+    dest[2] = hex[c & 0xf];
+    dest += 3;
+}
+
+// Encode s into [dest, end), stopping
+// at the first character which does
+// not fit, and return the size written
+template<bool SpaceAsPlus, class CharSet>
+std::size_t
+encode_impl(
+    char* dest,
+    char const* const end,
+    core::string_view s,
+    CharSet const& unreserved,
+    char const* const hex) noexcept
+{
+    auto it = s.data();
+    auto const last = it + s.size();
+    auto const dest0 = dest;
+    std::size_t run = 0;
+    while(it != last)
+    {
+        if(unreserved(*it))
+        {
+            if(dest == end)
+                break;
+            *dest++ = *it++;
+            if(++run < encode_run_size)
+                continue;
+            // copy the rest of the run,
+            // or as much of it as fits
+            auto p = grammar::find_if_not(
+                it, last, unreserved);
+            if(end - dest < p - it)
+                p = it + (end - dest);
+            std::memcpy(dest, it, p - it);
+            dest += p - it;
+            it = p;
+        }
+        else if(
+            SpaceAsPlus &&
+            *it == ' ')
+        {
+            if(dest == end)
+                break;
+            *dest++ = '+';
+            ++it;
+        }
+        else
+        {
+            if(end - dest < 3)
+                break;
+            encode_one(dest, *it++, hex);
+        }
+        run = 0;
+    }
+    return dest - dest0;
+}
+
+// Encode s into [dest, end), which
+// must be large enough
+template<bool SpaceAsPlus, class CharSet>
+std::size_t
+encode_unsafe_impl(
+    char* dest,
+    char const* const end,
+    core::string_view s,
+    CharSet const& unreserved,
+    char const* const hex) noexcept
+{
+    auto it = s.data();
+    auto const last = it + s.size();
+    auto const dest0 = dest;
+    if( ! SpaceAsPlus &&
+        static_cast<std::size_t>(
+            end - dest) == s.size())
+    {
+        // the buffer only fits s
+        // when nothing is escaped
+        std::memcpy(dest, it, s.size());
+        return s.size();
+    }
+    if(s.size() < 4 * encode_run_size)
+    {
+        // short strings are encoded
+        // one character at a time
+        while(it != last)
+        {
+            BOOST_ASSERT(dest != end);
+            if(unreserved(*it))
+            {
+                *dest++ = *it++;
+            }
+            else if(
+                SpaceAsPlus &&
+                *it == ' ')
+            {
+                *dest++ = '+';
+                ++it;
+            }
+            else
+            {
+                BOOST_ASSERT(end - dest >= 3);
+                encode_one(dest, *it++, hex);
+            }
+        }
+        return dest - dest0;
+    }
+    std::size_t run = 0;
+    while(it != last)
+    {
+        BOOST_ASSERT(dest != end);
+        if(unreserved(*it))
+        {
+            *dest++ = *it++;
+            if(++run < encode_run_size)
+                continue;
+            // copy the rest of the run
+            auto const p = grammar::find_if_not(
+                it, last, unreserved);
+            BOOST_ASSERT(end - dest >= p - it);
+            std::memcpy(dest, it, p - it);
+            dest += p - it;
+            it = p;
+        }
+        else if(
+            SpaceAsPlus &&
+            *it == ' ')
+        {
+            *dest++ = '+';
+            ++it;
+        }
+        else
+        {
+            BOOST_ASSERT(end - dest >= 3);
+            encode_one(dest, *it++, hex);
+        }
+        run = 0;
+    }
+    return dest - dest0;
+}
+
+//------------------------------------------------
+
 // re-encode is to percent-encode a
 // string that can already contain
 // escapes. Characters not in the
@@ -80,6 +80,35 @@ public:
     }
 };
 
+// A literal or a replacement field of a
+// format string, split ahead of time so it
+// can be applied without parsing again.
+// Positions are relative to the beginning
+// of the component containing the piece.
+struct format_piece
+{
+    enum kind_t : unsigned char
+    {
+        literal,    // characters to copy
+        index,      // {0}
+        name,       // {id}
+        next        // {}
+    };
+
+    // literal or field name
+    std::size_t pos = 0;
+    std::size_t n = 0;
+
+    // literal: encoded size
+    // index: the argument index
+    std::size_t value = 0;
+
+    // field: start of the format spec
+    std::size_t spec = 0;
+
+    kind_t kind = literal;
+};
+
 // State of the destination string
 class format_context;
 class measure_context;
@@ -101,11 +130,6 @@ struct named_arg
 class format_arg
 {
     void const* arg_;
-    void (*measure_)(
-        format_parse_context&,
-        measure_context&,
-        grammar::lut_chars const&,
-        void const* );
     void (*fmt_)(
         format_parse_context&,
         format_context&,
@@ -115,15 +139,6 @@ class format_arg
     std::size_t value_ = 0;
     bool ignore_ = false;
 
-    template <class A>
-    static
-    void
-    measure_impl(
-        format_parse_context& pctx,
-        measure_context& mctx,
-        grammar::lut_chars const& cs,
-        void const* a );
-
     template <class A>
     static
     void
@@ -153,15 +168,8 @@ public:
         return !ignore_;
     }
 
-    void
-    measure(
-        format_parse_context& pctx,
-        measure_context& mctx,
-        grammar::lut_chars const& cs)
-    {
-        measure_( pctx, mctx, cs, arg_ );
-    }
-
+    // makes room for the argument in the
+    // buffer of the context and formats it
     void
     format(
         format_parse_context& pctx,
@@ -232,18 +240,64 @@ public:
     }
 };
 
+// Growable storage for the output of
+// formatting. Arguments are encoded once,
+// into storage made large enough for an
+// upper bound of their encoded size,
+// instead of being measured first.
+class format_buffer
+{
+    char* p_;
+    std::size_t cap_;
+    char buf_[256];
+
+public:
+    format_buffer() noexcept
+        : p_(buf_)
+        , cap_(sizeof(buf_))
+    {}
+
+    format_buffer(
+        format_buffer const&) = delete;
+    format_buffer& operator=(
+        format_buffer const&) = delete;
+
+    ~format_buffer()
+    {
+        if (p_ != buf_)
+            delete[] p_;
+    }
+
+    char*
+    data() noexcept
+    {
+        return p_;
+    }
+
+    // return `out` after making room for
+    // n more chars after it, which moves
+    // the contents when the buffer grows
+    BOOST_URL_DECL
+    char*
+    grow(
+        char* out,
+        std::size_t n);
+};
+
 // define the format_context after format_args
 class format_context
 {
     format_args args_;
+    format_buffer& buf_;
     char* out_;
 
 public:
     format_context(
-        char* out,
+        format_buffer& buf,
         format_args args )
         : args_( args )
-        , out_( out )
+        , buf_( buf )
+        , out_( buf.data() )
     {}
 
     format_args
@@ -275,9 +329,18 @@ public:
     {
         out_ = it;
     }
+
+    // make room for n more chars at out()
+    void
+    grow( std::size_t n )
+    {
+        out_ = buf_.grow( out_, n );
+    }
 };
 
-// define the measure_context after format_args
+// define the measure_context after format_args.
+// It measures the arguments whose formatter
+// cannot bound the size of their output.
 class measure_context
 {
     format_args args_;
@@ -68,7 +68,6 @@ template<class A>
 format_arg::
 format_arg( A&& a )
     : arg_( &a )
-    , measure_( &measure_impl<A> )
     , fmt_( &format_impl<A> )
     , value_( get_uvalue(std::forward<A>(a) ))
     , ignore_( std::is_same<A, ignore_format>::value )
@@ -78,7 +77,6 @@ template<class A>
 format_arg::
 format_arg( named_arg<A>&& a )
     : arg_( &a.value )
-    , measure_( &measure_impl<A> )
     , fmt_( &format_impl<A> )
     , name_( a.name )
     , value_( get_uvalue(a.value))
@@ -88,33 +86,42 @@ template<class A>
 format_arg::
 format_arg( core::string_view name, A&& a )
     : arg_( &a )
-    , measure_( &measure_impl<A> )
     , fmt_( &format_impl<A> )
     , name_( name )
     , value_( get_uvalue(a) )
 {}
 
-// define the type-erased implementations that
-// depends on everything: the context types,
-// formatters, and type erased args
-template <class A>
-void
-format_arg::
-measure_impl(
-    format_parse_context& pctx,
-    measure_context& mctx,
+// upper bound of the size of the output,
+// for formatters which provide one
+template <class F, class T>
+auto
+format_bound(
+    F const& f,
+    T const& v,
+    format_context& fctx,
     grammar::lut_chars const& cs,
-    void const* a )
+    int) -> decltype(f.bound(v, fctx, cs))
 {
-    using ref_t = typename std::remove_cv<
-        typename std::remove_reference<A>::type>::type;
-    A const& ref = *static_cast<ref_t*>(
-        const_cast<void*>( a ) );
-    formatter<ref_t> f;
-    pctx.advance_to( f.parse(pctx) );
-    mctx.advance_to( f.measure( ref, mctx, cs ) );
+    return f.bound(v, fctx, cs);
+}
+
+// otherwise, the exact size of the output
+template <class F, class T>
+std::size_t
+format_bound(
+    F const& f,
+    T const& v,
+    format_context& fctx,
+    grammar::lut_chars const& cs,
+    long)
+{
+    measure_context mctx(fctx.args());
+    return f.measure(v, mctx, cs);
 }
 
+// define the type-erased implementation that
+// depends on everything: the context types,
+// formatters, and type erased args
 template <class A>
 void
 format_arg::
@@ -130,6 +137,7 @@ format_impl(
             const_cast<void*>( a ) );
     formatter<ref_t> f;
     pctx.advance_to( f.parse(pctx) );
+    fctx.grow( format_bound(f, ref, fctx, cs, 0) );
     fctx.advance_to( f.format( ref, fctx, cs ) );
 }
 
@@ -147,12 +155,12 @@ public:
     }
 
     std::size_t
-    measure(
+    bound(
         ignore_format,
-        measure_context& ctx,
+        format_context&,
         grammar::lut_chars const&) const
     {
-        return ctx.out();
+        return 0;
     }
 
     char*
@@ -243,9 +251,9 @@ public:
 
     BOOST_URL_DECL
     std::size_t
-    measure(
+    bound(
         core::string_view str,
-        measure_context& ctx,
+        format_context& ctx,
         grammar::lut_chars const& cs) const;
 
     BOOST_URL_DECL
@@ -274,12 +282,12 @@ public:
     }
 
     std::size_t
-    measure(
+    bound(
         core::string_view str,
-        measure_context& ctx,
+        format_context& ctx,
         grammar::lut_chars const& cs) const
     {
-        return impl_.measure(str, ctx, cs);
+        return impl_.bound(str, ctx, cs);
     }
 
     char*
@@ -302,12 +310,12 @@ public:
     }
 
     std::size_t
-    measure(
+    bound(
         char c,
-        measure_context& ctx,
+        format_context& ctx,
         grammar::lut_chars const& cs) const
     {
-        return impl_.measure({&c, 1}, ctx, cs);
+        return impl_.bound({&c, 1}, ctx, cs);
     }
 
     char*
@@ -336,18 +344,11 @@ public:
     char const*
     parse(format_parse_context& ctx);
 
+    // the bound does not depend on the value
     BOOST_URL_DECL
     std::size_t
-    measure(
-        unsigned long long int v,
-        measure_context& ctx,
-        grammar::lut_chars const& cs) const;
-
-    BOOST_URL_DECL
-    std::size_t
-    measure(
-        long long int v,
-        measure_context& ctx,
+    bound(
+        format_context& ctx,
         grammar::lut_chars const& cs) const;
 
     BOOST_URL_DECL
@@ -394,13 +395,12 @@ public:
     }
 
     std::size_t
-    measure(
-        T v,
-        measure_context& ctx,
+    bound(
+        T,
+        format_context& ctx,
         grammar::lut_chars const& cs) const
     {
-        return impl_.measure(
-            static_cast<base_value_type>(v), ctx, cs);
+        return impl_.bound(ctx, cs);
     }
 
     char*
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_DETAIL_RANGE_BUFFER_HPP
+#define BOOST_URL_DETAIL_RANGE_BUFFER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/grammar/recycled.hpp>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// True if It is a random access iterator,
+// whose ranges are inserted in one pass
+template<class It>
+using is_random_access_iter =
+    std::is_base_of<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<
+            It>::iterator_category>;
+
+/*  Holds the elements of a range after
+    they are encoded once, when they are
+    measured, so that copying them does
+    not encode them again.
+
+    Elements are stored back to back in
+    a recycled string, each followed by
+    `sep`, which the encoding of an
+    element always escapes.
+*/
+class range_buffer
+{
+    grammar::recycled_ptr<
+        std::string> s_;
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0;
+    char sep_;
+
+public:
+    explicit
+    range_buffer(char sep) noexcept
+        : s_(nullptr)
+        , sep_(sep)
+    {
+    }
+
+    // Remove all elements
+    void
+    clear() noexcept
+    {
+        size_ = 0;
+        pos_ = 0;
+    }
+
+    // Copy from the first element again
+    void
+    rewind() noexcept
+    {
+        pos_ = 0;
+    }
+
+    // Return room for a new element of
+    // at most n chars
+    BOOST_URL_DECL
+    char*
+    prepare(std::size_t n);
+
+    // Append the element written from
+    // prepare() up to end, and return
+    // its size
+    BOOST_URL_DECL
+    std::size_t
+    commit(char const* end) noexcept;
+
+    // Copy the next element to dest
+    BOOST_URL_DECL
+    void
+    copy(
+        char*& dest,
+        char const* end) noexcept;
+};
+
+} // detail
+} // urls
+} // boost
+
+#endif
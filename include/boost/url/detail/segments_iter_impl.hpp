@@ -49,7 +49,7 @@ public:
 
     // at index
     segments_iter_impl(
-        url_impl const& u_,
+        detail::path_ref const&,
         std::size_t pos_,
         std::size_t i_) noexcept;
 
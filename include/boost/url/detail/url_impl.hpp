@@ -17,6 +17,7 @@
 #include <boost/url/detail/parts_base.hpp>
 #include <boost/assert.hpp>
 #include <cstdint>
+#include <type_traits>
 
 namespace boost {
 namespace urls {
@@ -28,6 +29,19 @@ namespace detail {
 
 constexpr char const* const empty_c_str_ = "";
 
+// The type of the offsets and decoded
+// sizes stored in a url_impl
+using offset_type = BOOST_URL_OFFSET_TYPE;
+
+static_assert(
+    std::is_unsigned<offset_type>::value,
+    "BOOST_URL_OFFSET_TYPE must be unsigned");
+
+static_assert(
+    BOOST_URL_MAX_SIZE < std::size_t(
+        static_cast<offset_type>(-1)),
+    "BOOST_URL_MAX_SIZE must fit in BOOST_URL_OFFSET_TYPE");
+
 // This is the private 'guts' of a
 // url_view, exposed so different parts
 // of the implementation can work on it.
@@ -40,10 +54,10 @@ struct BOOST_URL_DECL url_impl : parts_base
     // never nullptr
     char const* cs_ = empty_c_str_;
 
-    std::size_t offset_[id_end + 1] = {};
-    std::size_t decoded_[id_end] = {};
-    std::size_t nseg_ = 0;
-    std::size_t nparam_ = 0;
+    offset_type offset_[id_end + 1] = {};
+    offset_type decoded_[id_end] = {};
+    offset_type nseg_ = 0;
+    offset_type nparam_ = 0;
     unsigned char ip_addr_[16] = {};
     // VFALCO don't we need a bool?
     std::uint16_t port_number_ = 0;
@@ -100,6 +114,7 @@ class path_ref
     : private parts_base
 {
     url_impl const* impl_ = nullptr;
+    std::size_t const* gen_ = nullptr;
     char const* data_ = nullptr;
     std::size_t size_ = 0;
     std::size_t nseg_ = 0;
@@ -108,6 +123,8 @@ class path_ref
 public:
     path_ref() = default;
     path_ref(url_impl const& impl) noexcept;
+    path_ref(url_impl const& impl,
+        std::size_t const* gen) noexcept;
     path_ref(core::string_view,
         std::size_t, std::size_t) noexcept;
     pct_string_view buffer() const noexcept;
@@ -116,6 +133,21 @@ public:
     char const* end() const noexcept;
     std::size_t nseg() const noexcept;
 
+    // changes when the url changes
+    std::size_t
+    gen() const noexcept
+    {
+        return gen_ ? *gen_ : 0;
+    }
+
+    // true if the url can change
+    // without gen() changing
+    bool
+    untracked() const noexcept
+    {
+        return impl_ && ! gen_;
+    }
+
     bool
     alias_of(
         url_impl const& impl) const noexcept
@@ -145,6 +177,7 @@ class BOOST_URL_DECL query_ref
     : private parts_base
 {
     url_impl const* impl_ = nullptr;
+    std::size_t const* gen_ = nullptr;
     char const* data_ = nullptr;
     std::size_t size_ = 0;
     std::size_t nparam_ = 0;
@@ -159,12 +192,29 @@ public:
             ) noexcept;
     query_ref() = default;
     query_ref(url_impl const& impl) noexcept;
+    query_ref(url_impl const& impl,
+        std::size_t const* gen) noexcept;
     pct_string_view buffer() const noexcept;
     std::size_t size() const noexcept; // with '?'
     char const* begin() const noexcept; // no '?'
     char const* end() const noexcept;
     std::size_t nparam() const noexcept;
 
+    // changes when the url changes
+    std::size_t
+    gen() const noexcept
+    {
+        return gen_ ? *gen_ : 0;
+    }
+
+    // true if the url can change
+    // without gen() changing
+    bool
+    untracked() const noexcept
+    {
+        return impl_ && ! gen_;
+    }
+
     bool
     alias_of(
         url_impl const& impl) const noexcept
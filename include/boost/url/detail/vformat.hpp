@@ -16,6 +16,9 @@
 
 namespace boost {
 namespace urls {
+
+class compiled_format;
+
 namespace detail {
 
 BOOST_URL_DECL
@@ -36,6 +39,24 @@ vformat(
     return u;
 }
 
+BOOST_URL_DECL
+void
+vformat_to(
+    url_base& u,
+    compiled_format const& fmt,
+    format_args args);
+
+inline
+url
+vformat(
+    compiled_format const& fmt,
+    format_args args)
+{
+    url u;
+    vformat_to(u, fmt, args);
+    return u;
+}
+
 } // detail
 } // url
 } // boost
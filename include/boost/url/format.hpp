@@ -103,6 +103,9 @@ format(
     Format arguments according to the format
     URL string into a @ref url_base.
 
+    The previous contents of `u` are
+    replaced, keeping its capacity.
+
     The rules for a format URL string are the same
     as for a `std::format_string`, where replacement
     fields are delimited by curly braces.
@@ -280,6 +283,9 @@ format(
     Format arguments according to the format
     URL string into a @ref url_base.
 
+    The previous contents of `u` are
+    replaced, keeping its capacity.
+
     This overload allows type-erased arguments
     to be passed as an initializer_list, which
     is mostly convenient for named parameters.
@@ -10,7 +10,10 @@
 #ifndef BOOST_URL_GRAMMAR_DETAIL_CHARSET_HPP
 #define BOOST_URL_GRAMMAR_DETAIL_CHARSET_HPP
 
+#include <boost/url/detail/config.hpp>
 #include <boost/core/bit.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 #ifdef BOOST_URL_USE_SSE2
@@ -177,6 +180,98 @@ find_if_not_pred(
 
 #endif
 
+//------------------------------------------------
+//
+// lut_chars
+//
+//------------------------------------------------
+
+/*  The 256 bits of a lut_chars are laid out
+    as two 16-byte nibble tables, so that SIMD
+    code can test membership with byte shuffles.
+    The byte for `c` is at index
+    `(c & 0x0F) + 16 * (c >> 7)`, and the bit
+    within that byte is `(c >> 4) & 7`.
+*/
+constexpr
+std::size_t
+lut_word(unsigned char c) noexcept
+{
+    return ((c >> 3) & 1) | ((c >> 6) & 2);
+}
+
+constexpr
+std::uint64_t
+lut_bit(unsigned char c) noexcept
+{
+    return 1ULL << (
+        ((c & 7) << 3) | ((c >> 4) & 7));
+}
+
+// Instruction sets with a lut_chars kernel
+enum class lut_isa
+{
+    scalar,
+    ssse3,
+    avx2,
+    neon
+};
+
+using lut_find_fn = char const*(*)(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last);
+
+// Return the find_if kernel for isa, or
+// nullptr if this build or CPU lacks it
+BOOST_URL_DECL
+lut_find_fn
+lut_find_if_kernel(lut_isa isa) noexcept;
+
+// Return the find_if_not kernel for isa, or
+// nullptr if this build or CPU lacks it
+BOOST_URL_DECL
+lut_find_fn
+lut_find_if_not_kernel(lut_isa isa) noexcept;
+
+using lut_count_fn = std::size_t(*)(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last);
+
+// Return the member count kernel for isa,
+// or nullptr if this build or CPU lacks it
+BOOST_URL_DECL
+lut_count_fn
+lut_count_kernel(lut_isa isa) noexcept;
+
+// Return the best isa supported at runtime
+BOOST_URL_DECL
+lut_isa
+lut_best_isa() noexcept;
+
+BOOST_URL_DECL
+char const*
+lut_find_if(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last) noexcept;
+
+BOOST_URL_DECL
+char const*
+lut_find_if_not(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last) noexcept;
+
+// Return the number of members in [first, last)
+BOOST_URL_DECL
+std::size_t
+lut_count(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last) noexcept;
+
 } // detail
 } // grammar
 } // urls
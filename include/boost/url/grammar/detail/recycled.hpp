@@ -53,6 +53,12 @@ nearest_pow2(
 
 //------------------------------------------------
 
+// Return a small number which
+// is different for each thread
+BOOST_URL_DECL
+std::size_t
+recycled_thread_index() noexcept;
+
 BOOST_URL_DECL
 void
 recycled_add_impl(
@@ -598,21 +598,24 @@ end() const noexcept ->
 
 //------------------------------------------------
 
-template<class R>
-auto
-implementation_defined::range_rule_t<R>::
-parse(
+namespace detail {
+
+// match the elements of a range
+// and return the number of elements
+template<class R0, class R1>
+system::result<std::size_t>
+parse_range(
     char const*& it,
-    char const* end) const ->
-        system::result<value_type>
+    char const* end,
+    R0 const& first,
+    R1 const& next,
+    std::size_t N,
+    std::size_t M)
 {
-    using T = typename R::value_type;
-
     std::size_t n = 0;
-    auto const it0 = it;
     auto it1 = it;
     auto rv = (grammar::parse)(
-        it, end, next_);
+        it, end, first);
     if( !rv )
     {
         if(rv.error() != error::end_of_range)
@@ -620,23 +623,21 @@ parse(
             // rewind unless error::end_of_range
             it = it1;
         }
-        if(n < N_)
+        if(n < N)
         {
             // too few
             BOOST_URL_RETURN_EC(
                 error::mismatch);
         }
         // good
-        return range<T>(
-            core::string_view(it0, it - it0),
-                n, next_);
+        return n;
     }
     for(;;)
     {
         ++n;
         it1 = it;
         rv = (grammar::parse)(
-            it, end, next_);
+            it, end, next);
         if( !rv )
         {
             if(rv.error() != error::end_of_range)
@@ -646,23 +647,43 @@ parse(
             }
             break;
         }
-        if(n >= M_)
+        if(n >= M)
         {
             // too many
             BOOST_URL_RETURN_EC(
                 error::mismatch);
         }
     }
-    if(n < N_)
+    if(n < N)
     {
         // too few
         BOOST_URL_RETURN_EC(
             error::mismatch);
     }
     // good
+    return n;
+}
+
+} // detail
+
+template<class R>
+auto
+implementation_defined::range_rule_t<R>::
+parse(
+    char const*& it,
+    char const* end) const ->
+        system::result<value_type>
+{
+    using T = typename R::value_type;
+
+    auto const it0 = it;
+    auto rv = detail::parse_range(
+        it, end, next_, next_, N_, M_);
+    if( !rv )
+        return rv.error();
     return range<T>(
         core::string_view(it0, it - it0),
-            n, next_);
+            *rv, next_);
 }
 
 //------------------------------------------------
@@ -678,61 +699,188 @@ parse(
 {
     using T = typename R0::value_type;
 
-    std::size_t n = 0;
     auto const it0 = it;
-    auto it1 = it;
-    auto rv = (grammar::parse)(
-        it, end, first_);
+    auto rv = detail::parse_range(
+        it, end, first_, next_, N_, M_);
     if( !rv )
+        return rv.error();
+    return range<T>(
+        core::string_view(it0, it - it0),
+            *rv, first_, next_);
+}
+
+//------------------------------------------------
+//
+// typed_range
+//
+//------------------------------------------------
+
+template<class R0, class R1>
+class typed_range<R0, R1>::
+    iterator
+{
+public:
+    using value_type =
+        typename R0::value_type;
+    using reference = value_type const&;
+    using pointer = void const*;
+    using difference_type =
+        std::ptrdiff_t;
+    using iterator_category =
+        std::forward_iterator_tag;
+
+    iterator() = default;
+    iterator(
+        iterator const&) = default;
+    iterator& operator=(
+        iterator const&) = default;
+
+    reference
+    operator*() const noexcept
     {
-        if(rv.error() != error::end_of_range)
-        {
-            // rewind unless error::end_of_range
-            it = it1;
-        }
-        if(n < N_)
-        {
-            // too few
-            BOOST_URL_RETURN_EC(
-                error::mismatch);
-        }
-        // good
-        return range<T>(
-            core::string_view(it0, it - it0),
-                n, first_, next_);
+        return *rv_;
     }
-    for(;;)
+
+    bool
+    operator==(
+        iterator const& other) const noexcept
     {
-        ++n;
-        it1 = it;
-        rv = (grammar::parse)(
-            it, end, next_);
-        if( !rv )
+        // can't compare iterators
+        // from different containers!
+        BOOST_ASSERT(r_ == other.r_);
+
+        return p_ == other.p_;
+    }
+
+    bool
+    operator!=(
+        iterator const& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    iterator&
+    operator++() noexcept
+    {
+        BOOST_ASSERT(
+            p_ != nullptr);
+        // the number of elements is known,
+        // so the last one is not re-parsed
+        // just to fail with end_of_range
+        if(--left_ == 0)
         {
-            if(rv.error() != error::end_of_range)
-            {
-                // rewind unless error::end_of_range
-                it = it1;
-            }
-            break;
+            p_ = nullptr;
+            return *this;
         }
-        if(n >= M_)
+        auto const end =
+            r_->s_.data() +
+            r_->s_.size();
+        rv_ = (grammar::parse)(
+            p_, end, r_->next());
+        BOOST_ASSERT(rv_.has_value());
+        return *this;
+    }
+
+    iterator
+    operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+private:
+    friend class typed_range;
+
+    typed_range const* r_ = nullptr;
+    char const* p_ = nullptr;
+    std::size_t left_ = 0;
+    system::result<value_type> rv_;
+
+    explicit
+    iterator(
+        typed_range const& r) noexcept
+        : r_(&r)
+        , p_(r.s_.data())
+        , left_(r.n_)
+    {
+        if(left_ == 0)
         {
-            // too many
-            BOOST_URL_RETURN_EC(
-                error::mismatch);
+            p_ = nullptr;
+            return;
         }
+        auto const end =
+            r_->s_.data() +
+            r_->s_.size();
+        rv_ = (grammar::parse)(
+            p_, end, r_->first());
+        BOOST_ASSERT(rv_.has_value());
     }
-    if(n < N_)
+
+    constexpr
+    iterator(
+        typed_range const& r,
+        int) noexcept
+        : r_(&r)
+        , p_(nullptr)
     {
-        // too few
-        BOOST_URL_RETURN_EC(
-            error::mismatch);
     }
-    // good
-    return range<T>(
+};
+
+template<class R0, class R1>
+auto
+typed_range<R0, R1>::
+begin() const noexcept ->
+    iterator
+{
+    return iterator(*this);
+}
+
+template<class R0, class R1>
+auto
+typed_range<R0, R1>::
+end() const noexcept ->
+    iterator
+{
+    return iterator(*this, 0);
+}
+
+//------------------------------------------------
+
+template<class R0, class R1>
+auto
+implementation_defined::typed_range_rule_t<R0, R1>::
+parse(
+    char const*& it,
+    char const* end) const ->
+        system::result<value_type>
+{
+    auto const it0 = it;
+    auto rv = detail::parse_range(
+        it, end, first_, next_, N_, M_);
+    if( !rv )
+        return rv.error();
+    return value_type(
+        core::string_view(it0, it - it0),
+            *rv, first_, next_);
+}
+
+template<class R>
+auto
+implementation_defined::typed_range_rule_t<R, void>::
+parse(
+    char const*& it,
+    char const* end) const ->
+        system::result<value_type>
+{
+    auto const it0 = it;
+    auto rv = detail::parse_range(
+        it, end, next_, next_, N_, M_);
+    if( !rv )
+        return rv.error();
+    return value_type(
         core::string_view(it0, it - it0),
-            n, first_, next_);
+            *rv, next_);
 }
 
 } // grammar
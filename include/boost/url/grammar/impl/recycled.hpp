@@ -23,18 +23,20 @@ recycled<T>::
 ~recycled()
 {
     std::size_t n = 0;
-    // VFALCO we should probably deallocate
-    // in reverse order of allocation but
-    // that requires a doubly-linked list.
-    auto it = head_;
-    while(it)
+    for(auto& s : slots_)
     {
+#if !defined(BOOST_URL_DISABLE_THREADS)
+        U* p = s.p.load(
+            std::memory_order_acquire);
+#else
+        U* p = s.p;
+#endif
+        if(! p)
+            continue;
         ++n;
-        auto next = it->next;
         BOOST_ASSERT(
-            it->refs == 0);
-        delete it;
-        it = next;
+            p->refs == 0);
+        delete p;
     }
     see_below::recycled_remove(
         sizeof(U) * n);
@@ -46,28 +48,36 @@ recycled<T>::
 acquire() ->
     U*
 {
-    U* p;
+    std::size_t const i0 =
+        see_below::recycled_thread_index();
+    for(std::size_t i = 0; i < N; ++i)
     {
+        auto& s = slots_[(i0 + i) % N];
 #if !defined(BOOST_URL_DISABLE_THREADS)
-        std::lock_guard<
-            std::mutex> lock(m_);
+        // check first, to avoid taking
+        // the cache line for writing
+        if(! s.p.load(
+                std::memory_order_relaxed))
+            continue;
+        // the exchange gives us sole
+        // ownership of whatever was in
+        // the slot, so there is no ABA
+        U* p = s.p.exchange(nullptr,
+            std::memory_order_acquire);
+#else
+        U* p = s.p;
+        s.p = nullptr;
 #endif
-        p = head_;
-        if(p)
-        {
-            // reuse
-            head_ = head_->next;
-            see_below::recycled_remove(
-                sizeof(U));
-            ++p->refs;
-        }
-        else
-        {
-            p = new U;
-        }
+        if(! p)
+            continue;
+        // reuse
+        see_below::recycled_remove(
+            sizeof(U));
+        ++p->refs;
+        BOOST_ASSERT(p->refs == 1);
+        return p;
     }
-    BOOST_ASSERT(p->refs == 1);
-    return p;
+    return new U;
 }
 
 template<class T>
@@ -77,16 +87,32 @@ release(U* u) noexcept
 {
     if(--u->refs != 0)
         return;
+    std::size_t const i0 =
+        see_below::recycled_thread_index();
+    for(std::size_t i = 0; i < N; ++i)
     {
+        auto& s = slots_[(i0 + i) % N];
 #if !defined(BOOST_URL_DISABLE_THREADS)
-        std::lock_guard<
-            std::mutex> lock(m_);
+        if(s.p.load(
+                std::memory_order_relaxed))
+            continue;
+        U* expected = nullptr;
+        if(! s.p.compare_exchange_strong(
+                expected, u,
+                std::memory_order_release,
+                std::memory_order_relaxed))
+            continue;
+#else
+        if(s.p)
+            continue;
+        s.p = u;
 #endif
-        u->next = head_;
-        head_ = u;
+        see_below::recycled_add(
+            sizeof(U));
+        return;
     }
-    see_below::recycled_add(
-        sizeof(U));
+    // the bin is full
+    delete u;
 }
 
 //------------------------------------------------
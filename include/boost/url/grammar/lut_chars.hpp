@@ -70,8 +70,8 @@ class lut_chars
     std::uint64_t
     lo(char c) noexcept
     {
-        return static_cast<
-            unsigned char>(c) & 3;
+        return detail::lut_word(
+            static_cast<unsigned char>(c));
     }
 
     constexpr
@@ -79,8 +79,8 @@ class lut_chars
     std::uint64_t
     hi(char c) noexcept
     {
-        return 1ULL << (static_cast<
-            unsigned char>(c) >> 2);
+        return detail::lut_bit(
+            static_cast<unsigned char>(c));
     }
 
     constexpr
@@ -381,14 +381,21 @@ public:
     }
 
 #ifndef BOOST_URL_DOCS
-#ifdef BOOST_URL_USE_SSE2
+#if defined(BOOST_URL_USE_SSE2) || \
+    defined(BOOST_URL_USE_NEON)
     char const*
     find_if(
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_pred(
-            *this, first, last);
+        // short strings are not
+        // worth a vector kernel
+        if(last - first < 16)
+            return detail::find_if(
+                first, last, *this,
+                std::false_type{});
+        return detail::lut_find_if(
+            mask_, first, last);
     }
 
     char const*
@@ -396,10 +403,33 @@ public:
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_not_pred(
-            *this, first, last);
+        if(last - first < 16)
+            return detail::find_if_not(
+                first, last, *this,
+                std::false_type{});
+        return detail::lut_find_if_not(
+            mask_, first, last);
     }
 #endif
+
+    // Return the number of characters
+    // in [first, last) which are in the set
+    std::size_t
+    count(
+        char const* first,
+        char const* last) const noexcept
+    {
+#if defined(BOOST_URL_USE_SSE2) || \
+    defined(BOOST_URL_USE_NEON)
+        if(last - first >= 16)
+            return detail::lut_count(
+                mask_, first, last);
+#endif
+        std::size_t n = 0;
+        while(first != last)
+            n += (*this)(*first++);
+        return n;
+    }
 #endif
 };
 
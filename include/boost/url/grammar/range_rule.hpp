@@ -18,6 +18,7 @@
 #include <boost/static_assert.hpp>
 #include <cstddef>
 #include <iterator>
+#include <new>
 #include <type_traits>
 #include <stddef.h> // ::max_align_t
 
@@ -27,6 +28,8 @@ namespace grammar {
 namespace implementation_defined {
 template<class R0, class R1>
 struct range_rule_t;
+template<class R0, class R1>
+struct typed_range_rule_t;
 } // implementation_defined
 
 /** A forward range of parsed elements
@@ -275,6 +278,268 @@ public:
 
 //------------------------------------------------
 
+#ifndef BOOST_URL_DOCS
+namespace detail {
+
+// holds a rule by value. Rules are only
+// required to be nothrow copy constructible,
+// so assignment constructs a new copy.
+template<class R>
+class rule_box
+{
+    union
+    {
+        R r_;
+    };
+
+public:
+    rule_box() noexcept
+        : r_()
+    {
+    }
+
+    explicit
+    rule_box(R const& r) noexcept
+        : r_(r)
+    {
+    }
+
+    rule_box(
+        rule_box const& other) noexcept
+        : r_(other.r_)
+    {
+    }
+
+    rule_box&
+    operator=(
+        rule_box const& other) noexcept
+    {
+        if(this != &other)
+        {
+            r_.~R();
+            ::new(&r_) R(other.r_);
+        }
+        return *this;
+    }
+
+    ~rule_box()
+    {
+        r_.~R();
+    }
+
+    R const&
+    get() const noexcept
+    {
+        return r_;
+    }
+};
+
+// holds the rules of a typed_range
+template<class R0, class R1>
+struct range_rules
+{
+    range_rules() = default;
+
+    range_rules(
+        R0 const& first,
+        R1 const& next) noexcept
+        : first_(first)
+        , next_(next)
+    {
+    }
+
+    R0 const&
+    first() const noexcept
+    {
+        return first_.get();
+    }
+
+    R1 const&
+    next() const noexcept
+    {
+        return next_.get();
+    }
+
+private:
+    rule_box<R0> first_;
+    rule_box<R1> next_;
+};
+
+// the same rule matches every element
+template<class R>
+struct range_rules<R, void>
+{
+    range_rules() = default;
+
+    explicit
+    range_rules(
+        R const& next) noexcept
+        : next_(next)
+    {
+    }
+
+    R const&
+    first() const noexcept
+    {
+        return next_.get();
+    }
+
+    R const&
+    next() const noexcept
+    {
+        return next_.get();
+    }
+
+private:
+    rule_box<R> next_;
+};
+
+} // detail
+#endif
+
+/** A forward range of parsed elements
+
+    Objects of this type are forward ranges
+    returned when parsing using the
+    @ref typed_range_rule.
+    Unlike @ref range, the rules used to
+    match the elements are stored by value
+    with their exact types, so iterating
+    the range calls the rules directly
+    instead of through a virtual function.
+    This allows each element to be parsed
+    inline, and the range never uses
+    recycled storage, so it may be stored
+    for as long as the underlying character
+    buffer remains valid.
+
+    Iteration is performed by re-parsing the
+    underlying character buffer. Ownership
+    of the buffer is not transferred; the
+    caller is responsible for ensuring that
+    the lifetime of the buffer extends until
+    it is no longer referenced by the range.
+
+    @tparam R0 The rule used to match the
+    first element.
+
+    @tparam R1 The rule used to match each
+    subsequent element, or `void` if `R0`
+    is used for every element.
+
+    @see
+        @ref parse,
+        @ref range,
+        @ref typed_range_rule.
+*/
+template<class R0, class R1 = void>
+class typed_range
+#ifndef BOOST_URL_DOCS
+    : private detail::range_rules<R0, R1>
+#endif
+{
+    using rules_type =
+        detail::range_rules<R0, R1>;
+
+    core::string_view s_;
+    std::size_t n_ = 0;
+
+    template<
+        class R0_, class R1_>
+    friend struct implementation_defined::typed_range_rule_t;
+
+    template<class... Rs>
+    typed_range(
+        core::string_view s,
+        std::size_t n,
+        Rs const&... rs) noexcept
+        : rules_type(rs...)
+        , s_(s)
+        , n_(n)
+    {
+    }
+
+public:
+    /** The type of each element of the range
+    */
+    using value_type =
+        typename R0::value_type;
+
+    /** The type of each element of the range
+    */
+    using reference = value_type const&;
+
+    /** The type of each element of the range
+    */
+    using const_reference = value_type const&;
+
+    /** Provided for compatibility, unused
+    */
+    using pointer = void const*;
+
+    /** The type used to represent unsigned integers
+    */
+    using size_type = std::size_t;
+
+    /** The type used to represent signed integers
+    */
+    using difference_type = std::ptrdiff_t;
+
+    /** A constant, forward iterator to elements of the range
+    */
+    class iterator;
+
+    /** A constant, forward iterator to elements of the range
+    */
+    using const_iterator = iterator;
+
+    /** Constructor
+
+        Default-constructed ranges have
+        zero elements. This constructor
+        requires that the rules are default
+        constructible.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    typed_range() = default;
+
+    /** Return an iterator to the beginning
+    */
+    iterator begin() const noexcept;
+
+    /** Return an iterator to the end
+    */
+    iterator end() const noexcept;
+
+    /** Return true if the range is empty
+    */
+    bool
+    empty() const noexcept
+    {
+        return n_ == 0;
+    }
+
+    /** Return the number of elements in the range
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    /** Return the matching part of the string
+    */
+    core::string_view
+    string() const noexcept
+    {
+        return s_;
+    }
+};
+
+//------------------------------------------------
+
 #ifndef BOOST_URL_DOCS
 namespace implementation_defined {
 template<
@@ -711,6 +976,254 @@ range_rule(
 }
 #endif
 
+//------------------------------------------------
+
+/** Match a repeating number of elements
+
+    This function is the same as
+    @ref range_rule, except that the value
+    produced is a @ref typed_range, which
+    stores the rule by value and iterates
+    the elements without type-erasure.
+
+    @par Value Type
+    @code
+    using value_type = typed_range< Rule >;
+    @endcode
+
+    @par Example
+    Rules are used with the function @ref parse.
+    @code
+    // range    = 1*( ";" token )
+
+    auto rv = parse( ";alpha;xray;charlie",
+        typed_range_rule(
+            tuple_rule(
+                squelch( delim_rule( ';' ) ),
+                token_rule( alpha_chars ) ),
+            1 ) );
+    @endcode
+
+    @par BNF
+    @code
+    range        = <N>*<M>next
+    @endcode
+
+    @param next The rule to use for matching
+    each element. The range extends until this
+    rule returns an error.
+
+    @param N The minimum number of elements for
+    the range to be valid. If omitted, this
+    defaults to zero.
+
+    @param M The maximum number of elements for
+    the range to be valid. If omitted, this
+    defaults to unlimited.
+
+    @see
+        @ref parse,
+        @ref range_rule,
+        @ref typed_range.
+*/
+#ifdef BOOST_URL_DOCS
+template<class Rule>
+constexpr
+__implementation_defined__
+typed_range_rule(
+    Rule next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept;
+#else
+namespace implementation_defined {
+template<class R0, class R1 = void>
+struct typed_range_rule_t
+{
+    using value_type =
+        typed_range<R0, R1>;
+
+    system::result<value_type>
+    parse(
+        char const*& it,
+        char const* end) const;
+
+    constexpr
+    typed_range_rule_t(
+        R0 const& first,
+        R1 const& next,
+        std::size_t N,
+        std::size_t M) noexcept
+        : first_(first)
+        , next_(next)
+        , N_(N)
+        , M_(M)
+    {
+    }
+
+private:
+    R0 const first_;
+    R1 const next_;
+    std::size_t N_;
+    std::size_t M_;
+};
+
+template<class R>
+struct typed_range_rule_t<R, void>
+{
+    using value_type =
+        typed_range<R>;
+
+    system::result<value_type>
+    parse(
+        char const*& it,
+        char const* end) const;
+
+    constexpr
+    typed_range_rule_t(
+        R const& next,
+        std::size_t N,
+        std::size_t M) noexcept
+        : next_(next)
+        , N_(N)
+        , M_(M)
+    {
+    }
+
+private:
+    R const next_;
+    std::size_t N_;
+    std::size_t M_;
+};
+} // implementation_defined
+
+template<class Rule>
+constexpr
+implementation_defined::typed_range_rule_t<Rule>
+typed_range_rule(
+    Rule const& next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept
+{
+    // If you get a compile error here it
+    // means that your rule does not meet
+    // the type requirements. Please check
+    // the documentation.
+    static_assert(
+        is_rule<Rule>::value,
+        "Rule requirements not met");
+
+    return implementation_defined::typed_range_rule_t<Rule>{
+        next, N, M};
+}
+#endif
+
+/** Match a repeating number of elements
+
+    This function is the same as
+    @ref range_rule, except that the value
+    produced is a @ref typed_range, which
+    stores the rules by value and iterates
+    the elements without type-erasure.
+
+    @par Value Type
+    @code
+    using value_type = typed_range< Rule1, Rule2 >;
+    @endcode
+
+    @par Example
+    Rules are used with the function @ref parse.
+    @code
+    // range    = [ token ] *( "," token )
+
+    auto rv = parse( "whiskey,tango,foxtrot",
+        typed_range_rule(
+            token_rule( alpha_chars ),          // first
+            tuple_rule(                      // next
+                squelch( delim_rule(',') ),
+                token_rule( alpha_chars ) ) ) );
+    @endcode
+
+    @par BNF
+    @code
+    range       = <1>*<1>first
+                / first <N-1>*<M-1>next
+    @endcode
+
+    @param first The rule to use for matching
+    the first element. If this rule returns
+    an error, the range is empty.
+
+    @param next The rule to use for matching
+    each subsequent element. The range extends
+    until this rule returns an error.
+
+    @param N The minimum number of elements for
+    the range to be valid. If omitted, this
+    defaults to zero.
+
+    @param M The maximum number of elements for
+    the range to be valid. If omitted, this
+    defaults to unlimited.
+
+    @see
+        @ref parse,
+        @ref range_rule,
+        @ref typed_range.
+*/
+#ifdef BOOST_URL_DOCS
+template<
+    class Rule1, class Rule2>
+constexpr
+__implementation_defined__
+typed_range_rule(
+    Rule1 first,
+    Rule2 next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept;
+#else
+template<
+    class Rule1, class Rule2>
+constexpr
+auto
+typed_range_rule(
+    Rule1 const& first,
+    Rule2 const& next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept ->
+    typename std::enable_if<
+        ! std::is_integral<Rule2>::value,
+        implementation_defined::typed_range_rule_t<Rule1, Rule2>>::type
+{
+    // If you get a compile error here it
+    // means that your rule does not meet
+    // the type requirements. Please check
+    // the documentation.
+    static_assert(
+        is_rule<Rule1>::value,
+        "Rule requirements not met");
+    static_assert(
+        is_rule<Rule2>::value,
+        "Rule requirements not met");
+
+    // If you get a compile error here it
+    // means that your rules do not have
+    // the exact same value_type. Please
+    // check the documentation.
+    static_assert(
+        std::is_same<
+            typename Rule1::value_type,
+            typename Rule2::value_type>::value,
+        "Rule requirements not met");
+
+    return implementation_defined::typed_range_rule_t<Rule1, Rule2>{
+        first, next, N, M};
+}
+#endif
+
 } // grammar
 } // urls
 } // boost
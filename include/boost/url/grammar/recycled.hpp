@@ -17,9 +17,6 @@
 #include <type_traits>
 #include <stddef.h> // ::max_align_t
 
-#if !defined(BOOST_URL_DISABLE_THREADS)
-# include <mutex>
-#endif
 
 namespace boost {
 namespace urls {
@@ -71,6 +68,15 @@ using aligned_storage =
     where recycled instances of T come from when
     used with @ref recycled_ptr.
 
+    The bin retains at most
+    `BOOST_URL_RECYCLED_CAPACITY` instances,
+    in slots which are claimed and filled with
+    atomic operations, so acquiring and releasing
+    never takes a lock. When every slot is
+    occupied, released instances are destroyed.
+    Each thread starts its search at a different
+    slot, to reduce contention.
+
     @par Example
     @code
     static recycled< std::string > bin;
@@ -108,7 +114,6 @@ private:
     struct U
     {
         T t;
-        U* next = nullptr;
 
 #if !defined(BOOST_URL_DISABLE_THREADS)
         std::atomic<
@@ -124,16 +129,27 @@ private:
         }
     };
 
+    // one slot per cache line,
+    // to avoid false sharing
+    struct slot
+    {
+#if !defined(BOOST_URL_DISABLE_THREADS)
+        std::atomic<U*> p;
+        char pad[64 - sizeof(std::atomic<U*>)];
+#else
+        U* p;
+#endif
+    };
+
     struct report;
 
+    static constexpr std::size_t N =
+        BOOST_URL_RECYCLED_CAPACITY;
+
     U* acquire();
     void release(U* u) noexcept;
 
-    U* head_ = nullptr;
-
-#if !defined(BOOST_URL_DISABLE_THREADS)
-    std::mutex m_;
-#endif
+    slot slots_[N] = {};
 };
 
 //------------------------------------------------
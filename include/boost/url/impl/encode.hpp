@@ -40,37 +40,10 @@ encoded_size(
         grammar::is_charset<CharSet>::value,
         "Type requirements not met");
 
-    std::size_t n = 0;
-    auto it = s.data();
-    auto const last = it + s.size();
-
-    if(! opt.space_as_plus ||
-        unreserved(' '))
-    {
-        while(it != last)
-        {
-            if(unreserved(*it))
-                n += 1;
-            else
-                n += 3;
-            ++it;
-        }
-    }
-    else
-    {
-        while(it != last)
-        {
-            auto c = *it;
-            if(unreserved(c))
-                ++n;
-            else if(c == ' ')
-                ++n;
-            else
-                n += 3;
-            ++it;
-        }
-    }
-    return n;
+    return detail::encoded_size_impl(
+        s, unreserved,
+        opt.space_as_plus &&
+        ! unreserved(' '));
 }
 
 //------------------------------------------------
@@ -98,70 +71,12 @@ encode(
 
     char const* const hex =
         detail::hexdigs[opt.lower_case];
-    auto const encode = [hex](
-        char*& dest,
-        unsigned char c) noexcept
-    {
-        *dest++ = '%';
-        *dest++ = hex[c>>4];
-        *dest++ = hex[c&0xf];
-    };
-
-    auto it = s.data();
-    auto const end = dest + size;
-    auto const last = it + s.size();
-    auto const dest0 = dest;
-    auto const end3 = end - 3;
-
-    if(! opt.space_as_plus)
-    {
-        while(it != last)
-        {
-            if(unreserved(*it))
-            {
-                if(dest == end)
-                    return dest - dest0;
-                *dest++ = *it++;
-                continue;
-            }
-            if(dest > end3)
-                return dest - dest0;
-            encode(dest, *it++);
-        }
-        return dest - dest0;
-    }
-    else if(! unreserved(' '))
-    {
-        // VFALCO space is usually reserved,
-        // and we depend on this for an
-        // optimization. if this assert
-        // goes off we can split the loop
-        // below into two versions.
-        BOOST_ASSERT(! unreserved(' '));
-
-        while(it != last)
-        {
-            if(unreserved(*it))
-            {
-                if(dest == end)
-                    return dest - dest0;
-                *dest++ = *it++;
-                continue;
-            }
-            if(*it == ' ')
-            {
-                if(dest == end)
-                    return dest - dest0;
-                *dest++ = '+';
-                ++it;
-                continue;
-            }
-            if(dest > end3)
-                return dest - dest0;
-            encode(dest, *it++);
-        }
-    }
-    return dest - dest0;
+    if( opt.space_as_plus &&
+        ! unreserved(' '))
+        return detail::encode_impl<true>(
+            dest, dest + size, s, unreserved, hex);
+    return detail::encode_impl<false>(
+        dest, dest + size, s, unreserved, hex);
 }
 
 //------------------------------------------------
@@ -181,65 +96,14 @@ encode_unsafe(
     // '%' must be reserved
     BOOST_ASSERT(! unreserved('%'));
 
-    auto it = s.data();
-    auto const last = it + s.size();
-    auto const end = dest + size;
-    ignore_unused(end);
-
     char const* const hex =
         detail::hexdigs[opt.lower_case];
-    auto const encode = [end, hex](
-        char*& dest,
-        unsigned char c) noexcept
-    {
-        ignore_unused(end);
-        *dest++ = '%';
-        BOOST_ASSERT(dest != end);
-        *dest++ = hex[c>>4];
-        BOOST_ASSERT(dest != end);
-        *dest++ = hex[c&0xf];
-    };
-
-    auto const dest0 = dest;
-    if(! opt.space_as_plus)
-    {
-        while(it != last)
-        {
-            BOOST_ASSERT(dest != end);
-            if(unreserved(*it))
-                *dest++ = *it++;
-            else
-                encode(dest, *it++);
-        }
-    }
-    else
-    {
-        // VFALCO space is usually reserved,
-        // and we depend on this for an
-        // optimization. if this assert
-        // goes off we can split the loop
-        // below into two versions.
-        BOOST_ASSERT(! unreserved(' '));
-
-        while(it != last)
-        {
-            BOOST_ASSERT(dest != end);
-            if(unreserved(*it))
-            {
-                *dest++ = *it++;
-            }
-            else if(*it == ' ')
-            {
-                *dest++ = '+';
-                ++it;
-            }
-            else
-            {
-                encode(dest, *it++);
-            }
-        }
-    }
-    return dest - dest0;
+    if( opt.space_as_plus &&
+        ! unreserved(' '))
+        return detail::encode_unsafe_impl<true>(
+            dest, dest + size, s, unreserved, hex);
+    return detail::encode_unsafe_impl<false>(
+        dest, dest + size, s, unreserved, hex);
 }
 
 //------------------------------------------------
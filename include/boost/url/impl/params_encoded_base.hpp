@@ -28,6 +28,8 @@ class params_encoded_base::iterator
 
     friend class params_encoded_base;
     friend class params_encoded_ref;
+    friend class params_index;
+    friend class params_offsets;
 
     iterator(detail::query_ref const& ref) noexcept;
     iterator(detail::query_ref const& ref, int) noexcept;
@@ -25,7 +25,9 @@ params_ref::
 params_ref(
     url_base& u,
     encoding_opts opt) noexcept
-    : params_base(u.impl_, opt)
+    : params_base(
+        detail::query_ref(u.impl_, &u.gen_),
+        opt)
     , u_(&u)
 {
 }
@@ -24,6 +24,7 @@ class segments_encoded_base::iterator
     friend class url_base;
     friend class segments_encoded_base;
     friend class segments_encoded_ref;
+    friend class segments_offsets;
 
     iterator(detail::path_ref const&) noexcept;
     iterator(detail::path_ref const&, int) noexcept;
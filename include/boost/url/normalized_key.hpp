@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_NORMALIZED_KEY_HPP
+#define BOOST_URL_NORMALIZED_KEY_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_view_base.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+/** A precomputed comparison key for a url
+
+    Objects of this type hold the normalized
+    form of a url as a canonical string of
+    bytes, together with its hash. The key
+    is computed once on construction, after
+    which comparing and hashing keys does not
+    decode percent-escapes or resolve dot
+    segments again: equality is a comparison
+    of the hashes and of the bytes, and
+    ordering is a comparison of the bytes.
+
+    Two keys are equal if and only if the
+    urls they were built from compare equal
+    with @ref url_view_base::compare. This
+    makes keys suitable for use in place of
+    urls in ordered and unordered containers,
+    where each url is compared or hashed many
+    times.
+
+    @par Example
+    @code
+    std::map< normalized_key, int > m;
+    m.emplace( normalized_key( url_view( "HTTP://www.example.com/a/./b" ) ), 1 );
+
+    assert( m.count( normalized_key( url_view( "http://www.%65xample.com/a/b" ) ) ) == 1 );
+    @endcode
+
+    @note
+    The ordering of keys is a strict weak
+    ordering which agrees with equality, but
+    it is not the same ordering as the one
+    of @ref url_view_base::compare. The hash
+    of a key is not the same value as the
+    hash of the url it was built from.
+
+    @see
+        @ref url_view_base::compare.
+*/
+class BOOST_URL_DECL normalized_key
+{
+    std::string s_;
+    std::size_t hash_ = 0;
+
+public:
+    /** Constructor
+
+        Default constructed keys are equal
+        to the key of an empty url.
+
+        @par Postconditions
+        @code
+        *this == normalized_key( url_view() )
+        @endcode
+
+        @par Exception Safety
+        Calls to allocate may throw.
+    */
+    normalized_key();
+
+    /** Constructor
+
+        This function computes the key of
+        the url `u`.
+
+        @par Example
+        @code
+        normalized_key k( url_view( "https://www.example.com" ) );
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param u The url to compute the key of.
+    */
+    explicit
+    normalized_key(
+        url_view_base const& u);
+
+    /** Return the canonical bytes of the key
+
+        The returned string is not a url. It
+        is an unspecified encoding of the
+        normalized components of the url,
+        which is the same for two urls if and
+        only if they compare equal.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    core::string_view
+    data() const noexcept
+    {
+        return s_;
+    }
+
+    /** Return the hash of the key
+
+        This value is computed on construction.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    std::size_t
+    hash() const noexcept
+    {
+        return hash_;
+    }
+
+    /** Return the result of comparing two keys
+
+        @par Complexity
+        Linear in the size of the shorter key.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @return -1 if `*this < other`, 0 if
+        `this == other`, and 1 if
+        `this > other`.
+    */
+    int
+    compare(
+        normalized_key const& other) const noexcept;
+
+    /** Return the result of comparing two keys
+
+        @par Complexity
+        Constant if the hashes differ,
+        otherwise linear in the size of
+        the keys.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    friend
+    bool
+    operator==(
+        normalized_key const& k0,
+        normalized_key const& k1) noexcept
+    {
+        return
+            k0.hash_ == k1.hash_ &&
+            k0.s_ == k1.s_;
+    }
+
+    /** Return the result of comparing two keys
+
+        @par Complexity
+        Constant if the hashes differ,
+        otherwise linear in the size of
+        the keys.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    friend
+    bool
+    operator!=(
+        normalized_key const& k0,
+        normalized_key const& k1) noexcept
+    {
+        return !(k0 == k1);
+    }
+
+    /** Return the result of comparing two keys
+
+        @par Complexity
+        Linear in the size of the shorter key.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    friend
+    bool
+    operator<(
+        normalized_key const& k0,
+        normalized_key const& k1) noexcept
+    {
+        return k0.compare(k1) < 0;
+    }
+
+    /** Return the result of comparing two keys
+
+        @par Complexity
+        Linear in the size of the shorter key.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    friend
+    bool
+    operator<=(
+        normalized_key const& k0,
+        normalized_key const& k1) noexcept
+    {
+        return k0.compare(k1) <= 0;
+    }
+
+    /** Return the result of comparing two keys
+
+        @par Complexity
+        Linear in the size of the shorter key.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    friend
+    bool
+    operator>(
+        normalized_key const& k0,
+        normalized_key const& k1) noexcept
+    {
+        return k0.compare(k1) > 0;
+    }
+
+    /** Return the result of comparing two keys
+
+        @par Complexity
+        Linear in the size of the shorter key.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    friend
+    bool
+    operator>=(
+        normalized_key const& k0,
+        normalized_key const& k1) noexcept
+    {
+        return k0.compare(k1) >= 0;
+    }
+};
+
+} // urls
+} // boost
+
+//------------------------------------------------
+
+// std::hash specialization
+#ifndef BOOST_URL_DOCS
+namespace std {
+template<>
+struct hash< ::boost::urls::normalized_key >
+{
+    std::size_t
+    operator()(
+        ::boost::urls::normalized_key const& k) const noexcept
+    {
+        return k.hash();
+    }
+};
+} // std
+#endif
+
+#endif
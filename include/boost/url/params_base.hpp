@@ -41,6 +41,8 @@ class BOOST_URL_DECL params_base
     friend class url_view_base;
     friend class params_ref;
     friend class params_view;
+    friend class params_index;
+    friend class params_offsets;
 
     detail::query_ref ref_;
     encoding_opts opt_;
@@ -40,6 +40,8 @@ class BOOST_URL_DECL params_encoded_base
     friend class url_view_base;
     friend class params_encoded_ref;
     friend class params_encoded_view;
+    friend class params_index;
+    friend class params_offsets;
 
     detail::query_ref ref_;
 
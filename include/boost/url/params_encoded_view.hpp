@@ -58,6 +58,7 @@ namespace implementation_defined {
 class BOOST_URL_DECL params_encoded_view
     : public params_encoded_base
 {
+    friend class url_base;
     friend class url_view_base;
     friend class params_view;
     friend class params_encoded_ref;
@@ -0,0 +1,362 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_PARAMS_INDEX_HPP
+#define BOOST_URL_PARAMS_INDEX_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/ignore_case.hpp>
+#include <boost/url/params_base.hpp>
+#include <boost/url/params_encoded_base.hpp>
+#include <boost/url/detail/url_impl.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** A hash index over the keys of a query
+
+    Objects of this type answer key lookups
+    on a range of query parameters in
+    constant time on average, instead of
+    the linear scans performed by
+    @ref params_base::find and
+    @ref params_encoded_base::find.
+    This helps when many keys are looked up
+    in a query with many parameters.
+
+    The index is built lazily on the first
+    lookup, by hashing the percent-decoded
+    key of every parameter. Keys are compared
+    the same way as `find` compares them:
+    the key used for a lookup is a plain
+    string, which is compared to the decoded
+    parameter keys, and a plus sign in a
+    key is not treated as a space.
+    When @ref ignore_case is given on
+    construction, keys are hashed and
+    compared without regard to case.
+
+    The index is a non-owning view; it holds
+    only the positions of parameters and
+    never copies the underlying character
+    buffer.
+
+    @par Example
+    @code
+    url_view u( "?id=42&sort=asc&Page=3&id=43" );
+    params_index idx( u.encoded_params(), ignore_case );
+
+    assert( idx.count( "id" ) == 2 );
+    assert( (*idx.find( "page" )).value == "3" );
+    assert( (*idx.find_last( "id" )).value == "43" );
+    assert( ! idx.contains( "limit" ) );
+    @endcode
+
+    @par Iterator Invalidation
+    Changes to the underlying character buffer
+    can invalidate the index and the iterators
+    which reference it. Modifying the query of
+    a @ref url invalidates any index built
+    over its params.
+
+    @par Thread Safety
+    Lookups on an index which has not been
+    built yet modify the index, so an index
+    may not be shared between threads unless
+    @ref build has been called first.
+
+    @see
+        @ref params_encoded_view,
+        @ref params_view.
+*/
+class BOOST_URL_DECL params_index
+{
+    struct entry
+    {
+        std::size_t pos;    // offset of the key
+        std::size_t nk;     // key size, with '?' or '&'
+        std::size_t dk;     // decoded key size
+        std::size_t next;   // next entry with an equal key
+    };
+
+    struct slot
+    {
+        std::size_t hash;
+        std::size_t first;  // npos if empty
+        std::size_t last;
+        std::size_t count;
+    };
+
+    detail::query_ref ref_;
+    bool ic_ = false;
+    mutable bool built_ = false;
+    mutable std::vector<entry> entries_;
+    mutable std::vector<slot> slots_;
+
+    slot const* lookup(
+        core::string_view key) const;
+    bool key_equal(
+        entry const& e,
+        core::string_view key) const noexcept;
+    std::size_t digest(
+        core::string_view key) const noexcept;
+
+public:
+    /** The iterator type
+
+        Lookups return iterators into the
+        params which the index was built
+        over. The referenced params are
+        percent-encoded.
+    */
+    using iterator =
+        params_encoded_base::iterator;
+
+    /** Constructor
+
+        Constructs an index over the
+        parameters referenced by `ps`.
+        No memory is allocated until the
+        first lookup.
+
+        @par Example
+        @code
+        url_view u( "?first=John&last=Doe" );
+        params_index idx( u.encoded_params() );
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param ps The parameters to index.
+
+        @param ic An optional parameter. If
+        the value @ref ignore_case is passed
+        here, keys are matched without
+        regard to case.
+    */
+    explicit
+    params_index(
+        params_encoded_base const& ps,
+        ignore_case_param ic = {}) noexcept;
+
+    /** Constructor
+
+        Constructs an index over the
+        parameters referenced by `ps`.
+        No memory is allocated until the
+        first lookup.
+
+        @par Example
+        @code
+        url_view u( "?first=John&last=Doe" );
+        params_index idx( u.params() );
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param ps The parameters to index.
+
+        @param ic An optional parameter. If
+        the value @ref ignore_case is passed
+        here, keys are matched without
+        regard to case.
+    */
+    explicit
+    params_index(
+        params_base const& ps,
+        ignore_case_param ic = {}) noexcept;
+
+    /** Build the index
+
+        This function hashes the key of every
+        parameter. It is called automatically
+        by the first lookup. Calling it again
+        has no effect.
+
+        @par Complexity
+        Linear in the size of the query.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    void
+    build() const;
+
+    /** Return the first parameter
+
+        @par Complexity
+        Linear in the size of the first param.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    iterator
+    begin() const noexcept;
+
+    /** Return the iterator one past the last parameter
+
+        Lookups which find no match return
+        this iterator.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    iterator
+    end() const noexcept;
+
+    /** Return the number of parameters
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return ref_.nparam();
+    }
+
+    /** Return true if a matching key exists
+
+        @par Example
+        @code
+        assert( params_index( url_view( "?first=John&last=Doe" ).params() ).contains( "first" ) );
+        @endcode
+
+        @par Complexity
+        Constant on average.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param key The key to match.
+        It is compared to the decoded keys.
+    */
+    bool
+    contains(
+        core::string_view key) const
+    {
+        return lookup(key) != nullptr;
+    }
+
+    /** Return the number of matching keys
+
+        @par Example
+        @code
+        assert( params_index( url_view( "?a=1&b=2&a=3" ).params() ).count( "a" ) == 2 );
+        @endcode
+
+        @par Complexity
+        Constant on average.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param key The key to match.
+        It is compared to the decoded keys.
+    */
+    std::size_t
+    count(
+        core::string_view key) const;
+
+    /** Find the first matching key
+
+        This function returns an iterator to
+        the first parameter whose key matches
+        `key`, or @ref end if there is none.
+
+        @par Example
+        @code
+        assert( (*params_index( url_view( "?first=John&last=Doe" ).params() ).find( "first" )).value == "John" );
+        @endcode
+
+        @par Complexity
+        Constant on average.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param key The key to match.
+        It is compared to the decoded keys.
+    */
+    iterator
+    find(
+        core::string_view key) const;
+
+    /** Find the last matching key
+
+        This function returns an iterator to
+        the last parameter whose key matches
+        `key`, or @ref end if there is none.
+
+        @par Example
+        @code
+        assert( (*params_index( url_view( "?a=1&b=2&a=3" ).params() ).find_last( "a" )).value == "3" );
+        @endcode
+
+        @par Complexity
+        Constant on average.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param key The key to match.
+        It is compared to the decoded keys.
+    */
+    iterator
+    find_last(
+        core::string_view key) const;
+
+    /** Find the next matching key
+
+        This function returns an iterator to
+        the next parameter after `it` whose
+        key is equal to the key at `it`, or
+        @ref end if there is none.
+
+        @par Example
+        @code
+        url_view u( "?a=1&b=2&a=3" );
+        params_index idx( u.params() );
+        assert( (*idx.find_next( idx.find( "a" ) )).value == "3" );
+        @endcode
+
+        @par Preconditions
+        `it` was returned by a lookup on
+        this index and is not equal to
+        @ref end.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param it An iterator to a param.
+    */
+    iterator
+    find_next(
+        iterator it) const noexcept;
+};
+
+} // urls
+} // boost
+
+#endif
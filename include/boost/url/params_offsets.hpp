@@ -0,0 +1,252 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_PARAMS_OFFSETS_HPP
+#define BOOST_URL_PARAMS_OFFSETS_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/param.hpp>
+#include <boost/url/params_base.hpp>
+#include <boost/url/params_encoded_base.hpp>
+#include <boost/url/detail/url_impl.hpp>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** A positional index over a query
+
+    Objects of this type give access to the
+    parameters of a query by position in
+    constant time. Iterators of the params
+    containers are bidirectional, so reaching
+    the n-th parameter with `std::next`
+    examines every parameter before it, and
+    visiting parameters by position in a loop
+    takes quadratic time.
+
+    The index is built lazily on the first
+    positional access, by recording the
+    offset at which each parameter starts.
+    When the index refers to the params of a
+    @ref url, it is rebuilt automatically on
+    the next access after the url changes.
+    Params obtained through a @ref url_view
+    which refers to a url carry no way to
+    detect changes, so an index over them is
+    rebuilt on every positional access.
+
+    The index is a non-owning view; it holds
+    only the positions of parameters and
+    never copies the underlying character
+    buffer.
+
+    @par Example
+    @code
+    url u( "?first=John&last=Doe&age=42" );
+    params_offsets idx( u.encoded_params() );
+
+    assert( idx[2].key == "age" );
+
+    u.params().erase( u.params().begin() );
+
+    assert( idx.size() == 2 );
+    assert( idx[1].key == "age" );
+    @endcode
+
+    @par Thread Safety
+    Accesses to an index which has not been
+    built yet, or whose url has changed,
+    modify the index, so an index may not be
+    shared between threads unless
+    @ref build has been called first and
+    the url is not modified.
+
+    @see
+        @ref params_encoded_view,
+        @ref params_index,
+        @ref segments_offsets.
+*/
+class BOOST_URL_DECL params_offsets
+{
+    detail::query_ref ref_;
+    mutable bool built_ = false;
+    mutable std::size_t gen_ = 0;
+    mutable std::vector<std::size_t> pos_;
+
+public:
+    /** The iterator type
+
+        Positional accesses return iterators
+        into the params which the index was
+        built over. The referenced params are
+        percent-encoded.
+    */
+    using iterator =
+        params_encoded_base::iterator;
+
+    /** Constructor
+
+        Constructs an index over the
+        parameters referenced by `ps`.
+        No memory is allocated until the
+        first positional access.
+
+        @par Example
+        @code
+        url_view u( "?first=John&last=Doe" );
+        params_offsets idx( u.encoded_params() );
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param ps The parameters to index.
+    */
+    explicit
+    params_offsets(
+        params_encoded_base const& ps) noexcept;
+
+    /** Constructor
+
+        Constructs an index over the
+        parameters referenced by `ps`.
+        No memory is allocated until the
+        first positional access.
+
+        @par Example
+        @code
+        url_view u( "?first=John&last=Doe" );
+        params_offsets idx( u.params() );
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param ps The parameters to index.
+    */
+    explicit
+    params_offsets(
+        params_base const& ps) noexcept;
+
+    /** Build the index
+
+        This function records the offset of
+        every parameter. It is called
+        automatically by positional accesses.
+        Calling it again has no effect unless
+        the url has changed.
+
+        @par Complexity
+        Linear in the size of the query.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    void
+    build() const;
+
+    /** Return the first parameter
+
+        @par Complexity
+        Linear in the size of the first param.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    iterator
+    begin() const noexcept;
+
+    /** Return the iterator one past the last parameter
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    iterator
+    end() const noexcept;
+
+    /** Return the number of parameters
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return ref_.nparam();
+    }
+
+    /** Return an iterator to a parameter
+
+        This function returns an iterator to
+        the parameter at position `i`, or
+        @ref end if `i == size()`.
+
+        @par Example
+        @code
+        url_view u( "?a=1&b=2&c=3" );
+        params_offsets idx( u.params() );
+        assert( std::distance( idx.nth( 1 ), idx.end() ) == 2 );
+        @endcode
+
+        @par Preconditions
+        @code
+        i <= this->size()
+        @endcode
+
+        @par Complexity
+        Constant, after the index is built.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param i The zero-based position.
+    */
+    iterator
+    nth(std::size_t i) const;
+
+    /** Return a parameter
+
+        This function returns the parameter
+        at position `i`.
+
+        @par Example
+        @code
+        assert( params_offsets( url_view( "?a=1&b=2" ).params() )[1].value == "2" );
+        @endcode
+
+        @par Preconditions
+        @code
+        i < this->size()
+        @endcode
+
+        @par Complexity
+        Constant, after the index is built.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param i The zero-based position.
+    */
+    param_pct_view
+    operator[](std::size_t i) const;
+};
+
+} // urls
+} // boost
+
+#endif
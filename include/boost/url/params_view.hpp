@@ -47,6 +47,7 @@ namespace urls {
 class params_view
     : public params_base
 {
+    friend class url_base;
     friend class url_view_base;
     friend class params_encoded_view;
     friend class params_ref;
@@ -278,6 +278,168 @@ system::result<url_view>
 parse_uri_reference(
     core::string_view s);
 
+//------------------------------------------------
+
+/** Return success if a string is a valid absolute URI
+
+    This function checks the string against
+    the same grammar as @ref parse_absolute_uri,
+    without constructing a @ref url_view.
+    No segments or params are counted, no
+    sizes are computed and IPv4 addresses are
+    not converted, so it is considerably
+    faster when only the validity of the
+    string matters.
+
+    @par Example
+    @code
+    assert( validate_absolute_uri( "http://example.com/index.htm?id=1" ) );
+    @endcode
+
+    @par Complexity
+    Linear in `s.size()`.
+
+    @throw std::length_error `s.size() > url_view::max_size`
+
+    @return Success if and only if
+    @ref parse_absolute_uri succeeds, else
+    an error. The error may differ from the
+    one returned by @ref parse_absolute_uri.
+
+    @param s The string to check
+
+    @see
+        @ref parse_absolute_uri.
+*/
+BOOST_URL_DECL
+system::result<void>
+validate_absolute_uri(
+    core::string_view s);
+
+/** Return success if a string is a valid origin-form
+
+    This function checks the string against
+    the same grammar as @ref parse_origin_form,
+    without constructing a @ref url_view.
+
+    @par Example
+    @code
+    assert( validate_origin_form( "/index.htm?layout=mobile" ) );
+    @endcode
+
+    @par Complexity
+    Linear in `s.size()`.
+
+    @throw std::length_error `s.size() > url_view::max_size`
+
+    @return Success if and only if
+    @ref parse_origin_form succeeds, else
+    an error. The error may differ from the
+    one returned by @ref parse_origin_form.
+
+    @param s The string to check
+
+    @see
+        @ref parse_origin_form.
+*/
+BOOST_URL_DECL
+system::result<void>
+validate_origin_form(
+    core::string_view s);
+
+/** Return success if a string is a valid relative-ref
+
+    This function checks the string against
+    the same grammar as @ref parse_relative_ref,
+    without constructing a @ref url_view.
+
+    @par Example
+    @code
+    assert( validate_relative_ref( "//www.boost.org/index.html?field=value#downloads" ) );
+    @endcode
+
+    @par Complexity
+    Linear in `s.size()`.
+
+    @throw std::length_error `s.size() > url_view::max_size`
+
+    @return Success if and only if
+    @ref parse_relative_ref succeeds, else
+    an error. The error may differ from the
+    one returned by @ref parse_relative_ref.
+
+    @param s The string to check
+
+    @see
+        @ref parse_relative_ref.
+*/
+BOOST_URL_DECL
+system::result<void>
+validate_relative_ref(
+    core::string_view s);
+
+/** Return success if a string is a valid URI
+
+    This function checks the string against
+    the same grammar as @ref parse_uri,
+    without constructing a @ref url_view.
+
+    @par Example
+    @code
+    assert( validate_uri( "https://www.example.com/index.htm?text=none#a1" ) );
+    @endcode
+
+    @par Complexity
+    Linear in `s.size()`.
+
+    @throw std::length_error `s.size() > url_view::max_size`
+
+    @return Success if and only if
+    @ref parse_uri succeeds, else an error.
+    The error may differ from the one
+    returned by @ref parse_uri.
+
+    @param s The string to check
+
+    @see
+        @ref parse_uri.
+*/
+BOOST_URL_DECL
+system::result<void>
+validate_uri(
+    core::string_view s);
+
+/** Return success if a string is a valid URI-reference
+
+    This function checks the string against
+    the same grammar as @ref parse_uri_reference,
+    without constructing a @ref url_view.
+
+    @par Example
+    @code
+    assert( validate_uri_reference( "ws://echo.example.com/?name=boost#demo" ) );
+    @endcode
+
+    @par Complexity
+    Linear in `s.size()`.
+
+    @throw std::length_error `s.size() > url_view::max_size`
+
+    @return Success if and only if
+    @ref parse_uri_reference succeeds, else
+    an error. The error may differ from the
+    one returned by @ref parse_uri_reference.
+
+    @param s The string to check
+
+    @see
+        @ref parse_uri_reference.
+*/
+BOOST_URL_DECL
+system::result<void>
+validate_uri_reference(
+    core::string_view s);
+
 } // url
 } // boost
 
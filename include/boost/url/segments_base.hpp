@@ -41,6 +41,7 @@ class segments_base
     friend class url_view_base;
     friend class segments_ref;
     friend class segments_view;
+    friend class segments_offsets;
 
     segments_base(
         detail::path_ref const& ref) noexcept;
@@ -41,6 +41,7 @@ class segments_encoded_base
     friend class url_view_base;
     friend class segments_encoded_ref;
     friend class segments_encoded_view;
+    friend class segments_offsets;
 
     segments_encoded_base(
         detail::path_ref const& ref) noexcept;
@@ -61,6 +61,7 @@ namespace urls {
 class segments_encoded_view
     : public segments_encoded_base
 {
+    friend class url_base;
     friend class url_view_base;
     friend class segments_encoded_ref;
 
@@ -0,0 +1,253 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_SEGMENTS_OFFSETS_HPP
+#define BOOST_URL_SEGMENTS_OFFSETS_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/pct_string_view.hpp>
+#include <boost/url/segments_base.hpp>
+#include <boost/url/segments_encoded_base.hpp>
+#include <boost/url/detail/url_impl.hpp>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** A positional index over a path
+
+    Objects of this type give access to the
+    segments of a path by position in
+    constant time. Iterators of the segments
+    containers are bidirectional, so reaching
+    the n-th segment with `std::next`
+    examines every segment before it, and
+    visiting segments by position in a loop
+    takes quadratic time.
+
+    The index is built lazily on the first
+    positional access, by recording the
+    offset at which each segment starts.
+    When the index refers to the segments of
+    a @ref url, it is rebuilt automatically
+    on the next access after the url changes.
+    Segments obtained through a @ref url_view
+    which refers to a url carry no way to
+    detect changes, so an index over them is
+    rebuilt on every positional access.
+
+    The index is a non-owning view; it holds
+    only the positions of segments and
+    never copies the underlying character
+    buffer.
+
+    @par Example
+    @code
+    url u( "/path/to/the/file.txt" );
+    segments_offsets idx( u.encoded_segments() );
+
+    assert( idx[3] == "file.txt" );
+
+    u.segments().pop_back();
+
+    assert( idx.size() == 3 );
+    assert( idx[2] == "the" );
+    @endcode
+
+    @par Thread Safety
+    Accesses to an index which has not been
+    built yet, or whose url has changed,
+    modify the index, so an index may not be
+    shared between threads unless
+    @ref build has been called first and
+    the url is not modified.
+
+    @see
+        @ref params_offsets,
+        @ref segments_encoded_view.
+*/
+class BOOST_URL_DECL segments_offsets
+{
+    detail::path_ref ref_;
+    mutable bool built_ = false;
+    mutable std::size_t gen_ = 0;
+    mutable std::vector<std::size_t> pos_;
+
+public:
+    /** The iterator type
+
+        Positional accesses return iterators
+        into the segments which the index was
+        built over. The referenced segments
+        are percent-encoded.
+    */
+    using iterator =
+        segments_encoded_base::iterator;
+
+    /** Constructor
+
+        Constructs an index over the
+        segments referenced by `ps`.
+        No memory is allocated until the
+        first positional access.
+
+        @par Example
+        @code
+        url_view u( "/path/to/file.txt" );
+        segments_offsets idx( u.encoded_segments() );
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param ps The segments to index.
+    */
+    explicit
+    segments_offsets(
+        segments_encoded_base const& ps) noexcept;
+
+    /** Constructor
+
+        Constructs an index over the
+        segments referenced by `ps`.
+        No memory is allocated until the
+        first positional access.
+
+        @par Example
+        @code
+        url_view u( "/path/to/file.txt" );
+        segments_offsets idx( u.segments() );
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param ps The segments to index.
+    */
+    explicit
+    segments_offsets(
+        segments_base const& ps) noexcept;
+
+    /** Build the index
+
+        This function records the offset of
+        every segment. It is called
+        automatically by positional accesses.
+        Calling it again has no effect unless
+        the url has changed.
+
+        @par Complexity
+        Linear in the size of the path.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    void
+    build() const;
+
+    /** Return the first segment
+
+        @par Complexity
+        Linear in the size of the first segment.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    iterator
+    begin() const noexcept;
+
+    /** Return the iterator one past the last segment
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    iterator
+    end() const noexcept;
+
+    /** Return the number of segments
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return ref_.nseg();
+    }
+
+    /** Return an iterator to a segment
+
+        This function returns an iterator to
+        the segment at position `i`, or
+        @ref end if `i == size()`.
+
+        @par Example
+        @code
+        url_view u( "/a/b/c" );
+        segments_offsets idx( u.segments() );
+        assert( std::distance( idx.nth( 1 ), idx.end() ) == 2 );
+        @endcode
+
+        @par Preconditions
+        @code
+        i <= this->size()
+        @endcode
+
+        @par Complexity
+        Linear in the size of the segment,
+        after the index is built.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param i The zero-based position.
+    */
+    iterator
+    nth(std::size_t i) const;
+
+    /** Return a segment
+
+        This function returns the segment
+        at position `i`.
+
+        @par Example
+        @code
+        assert( segments_offsets( url_view( "/a/b" ).segments() )[1] == "b" );
+        @endcode
+
+        @par Preconditions
+        @code
+        i < this->size()
+        @endcode
+
+        @par Complexity
+        Linear in the size of the segment,
+        after the index is built.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param i The zero-based position.
+    */
+    pct_string_view
+    operator[](std::size_t i) const;
+};
+
+} // urls
+} // boost
+
+#endif
@@ -55,6 +55,7 @@ namespace urls {
 class segments_view
     : public segments_base
 {
+    friend class url_base;
     friend class url_view_base;
     friend class segments_encoded_view;
     friend class segments_ref;
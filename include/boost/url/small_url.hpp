@@ -0,0 +1,738 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_SMALL_URL_HPP
+#define BOOST_URL_SMALL_URL_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/url_base.hpp>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+template<std::size_t Capacity>
+class small_url;
+#endif
+
+/** Counters for the storage of small URLs
+
+    These counters report how often urls
+    of a @ref small_url type outgrew their
+    inline buffer, which helps to choose
+    the capacity for a workload.
+
+    @see
+        @ref small_url::stats.
+*/
+struct small_url_stats
+{
+    /** The number of urls which moved from
+        their inline buffer to the heap
+    */
+    std::size_t spills = 0;
+
+    /** The largest size requested when a
+        url moved to the heap
+    */
+    std::size_t max_spill_size = 0;
+};
+
+namespace detail {
+
+// updated by every small_url
+// with the same capacity
+struct small_url_counters
+{
+    std::atomic<std::size_t> spills{0};
+    std::atomic<std::size_t> max_spill_size{0};
+};
+
+} // detail
+
+/** Common implementation for all small URLs
+
+    This base class is used by the library
+    to provide common functionality for
+    small URLs. Users should not use this
+    class directly. Instead, construct an
+    instance of one of the containers
+    or call a parsing function.
+
+    @par Containers
+        @li @ref url
+        @li @ref url_view
+        @li @ref small_url
+        @li @ref static_url
+*/
+class BOOST_URL_DECL
+    small_url_base
+    : public url_base
+{
+    template<std::size_t>
+    friend class small_url;
+
+    // the inline buffer
+    char* buf_;
+    std::size_t buf_cap_;
+
+    ~small_url_base();
+    small_url_base(
+        char* buf, std::size_t cap) noexcept;
+    void release() noexcept;
+    void steal(small_url_base& u) noexcept;
+    void clear_impl() noexcept override;
+    void reserve_impl(std::size_t, op_t&) override;
+    void cleanup(op_t&) override;
+
+    virtual
+    detail::small_url_counters&
+    counters() const noexcept = 0;
+
+    static
+    small_url_stats
+    stats_impl(
+        detail::small_url_counters const&) noexcept;
+
+    void
+    copy(url_view_base const& u)
+    {
+        this->url_base::copy(u);
+    }
+
+public:
+    /** Return true if the url is stored in the inline buffer
+
+        This is true until the url grows
+        beyond the capacity of the inline
+        buffer. The heap storage is then
+        kept when the url shrinks or is
+        cleared, like the capacity of a
+        @ref url.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    bool
+    is_inline() const noexcept
+    {
+        return s_ == buf_;
+    }
+};
+
+//------------------------------------------------
+
+/** A modifiable container for a URL, with an inline buffer.
+
+    This container owns a url, represented
+    by a null-terminated character buffer.
+    Urls of up to `Capacity` characters are
+    stored in a buffer inside the object, so
+    no memory is allocated. When a url grows
+    beyond `Capacity` it is moved to storage
+    allocated on the heap, like @ref url,
+    instead of throwing like @ref static_url.
+
+    The contents may be inspected and modified,
+    and the implementation maintains a useful
+    invariant: changes to the url always
+    leave it in a valid state.
+
+    @par Example
+    @code
+    small_url< 64 > u( "https://www.example.com" );
+    u.set_path( "/index.htm" );
+    assert( u.is_inline() );
+    @endcode
+
+    @par Exception Safety
+    @li Functions marked `noexcept` provide the
+    no-throw guarantee, otherwise:
+    @li Functions which throw offer the strong
+    exception safety guarantee.
+
+    @tparam Capacity The number of characters
+    stored inline, not including the
+    null terminator.
+
+    @see
+        @ref static_url,
+        @ref url,
+        @ref url_view.
+*/
+template<std::size_t Capacity>
+class small_url
+    : public small_url_base
+{
+    char buf_[Capacity + 1];
+
+    friend std::hash<small_url>;
+    using url_view_base::digest;
+
+    static
+    detail::small_url_counters&
+    shared_counters() noexcept
+    {
+        static detail::small_url_counters c;
+        return c;
+    }
+
+    detail::small_url_counters&
+    counters() const noexcept override
+    {
+        return shared_counters();
+    }
+
+public:
+    //--------------------------------------------
+    //
+    // Special Members
+    //
+    //--------------------------------------------
+
+    /** Destructor
+
+        Any params, segments, iterators, or
+        views which reference this object are
+        invalidated. The underlying character
+        buffer is destroyed, invalidating all
+        references to it.
+    */
+    ~small_url() = default;
+
+    /** Constructor
+
+        Default constructed urls contain
+        a zero-length string. This matches
+        the grammar for a relative-ref with
+        an empty path and no query or
+        fragment.
+
+        @par Example
+        @code
+        small_url< 64 > u;
+        @endcode
+
+        @par Postconditions
+        @code
+        this->empty() == true && this->is_inline() == true
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @par BNF
+        @code
+        relative-ref  = relative-part [ "?" query ] [ "#" fragment ]
+        @endcode
+
+        @par Specification
+        <a href="https://datatracker.ietf.org/doc/html/rfc3986#section-4.2"
+            >4.2. Relative Reference (rfc3986)</a>
+    */
+    small_url() noexcept
+        : small_url_base(
+            buf_, Capacity)
+    {
+    }
+
+    /** Constructor
+
+        This function constructs a url from
+        the string `s`, which must contain a
+        valid <em>URI</em> or <em>relative-ref</em>
+        or else an exception is thrown.
+        The new url retains ownership by
+        making a copy of the passed string,
+        which is only allocated when it is
+        longer than `Capacity`.
+
+        @par Example
+        @code
+        small_url< 64 > u( "https://www.example.com" );
+        @endcode
+
+        @par Effects
+        @code
+        return small_url( parse_uri_reference( s ).value() );
+        @endcode
+
+        @par Postconditions
+        @code
+        this->buffer().data() != s.data()
+        @endcode
+
+        @par Complexity
+        Linear in `s.size()`.
+
+        @par Exception Safety
+        Exceptions thrown on invalid input.
+
+        @throw system_error
+        The input does not contain a valid url.
+
+        @param s The string to parse.
+
+        @par BNF
+        @code
+        URI           = scheme ":" hier-part [ "?" query ] [ "#" fragment ]
+
+        relative-ref  = relative-part [ "?" query ] [ "#" fragment ]
+        @endcode
+
+        @par Specification
+        @li <a href="https://datatracker.ietf.org/doc/html/rfc3986#section-4.1"
+            >4.1. URI Reference</a>
+    */
+    explicit
+    small_url(
+        core::string_view s)
+        : small_url()
+    {
+        copy(parse_uri_reference(s
+            ).value(BOOST_URL_POS));
+    }
+
+    /** Constructor
+
+        The newly constructed object contains
+        a copy of `u`.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    small_url(
+        small_url const& u)
+        : small_url()
+    {
+        copy(u);
+    }
+
+    /** Constructor
+
+        This function performs a move-construction
+        from `u`. When `u` is stored on the heap,
+        its storage is transferred, otherwise the
+        inline buffer is copied.
+        After the move, the state of `u`
+        will be as-if default constructed.
+
+        @par Postconditions
+        @code
+        u.empty() == true
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param u The url to move from.
+    */
+    small_url(small_url&& u) noexcept
+        : small_url()
+    {
+        steal(u);
+    }
+
+    /** Constructor
+
+        The newly constructed object contains
+        a copy of `u`.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    small_url(
+        url_view_base const& u)
+        : small_url()
+    {
+        copy(u);
+    }
+
+    /** Assignment
+
+        The contents of `u` are copied and
+        the previous contents of `this` are
+        discarded.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    small_url&
+    operator=(
+        small_url const& u)
+    {
+        if (this != &u)
+            copy(u);
+        return *this;
+    }
+
+    /** Assignment
+
+        The contents of `u` are moved into
+        `this`, and the previous contents of
+        `this` are discarded.
+        After the move, the state of `u`
+        will be as-if default constructed.
+
+        @par Postconditions
+        @code
+        u.empty() == true
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param u The url to move from.
+    */
+    small_url&
+    operator=(small_url&& u) noexcept
+    {
+        if(this != &u)
+        {
+            release();
+            steal(u);
+        }
+        return *this;
+    }
+
+    /** Assignment
+
+        The contents of `u` are copied and
+        the previous contents of `this` are
+        discarded.
+
+        @par Postconditions
+        @code
+        this->buffer() == u.buffer() && this->buffer().data() != u.buffer().data()
+        @endcode
+
+        @par Complexity
+        Linear in `u.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url to copy.
+    */
+    small_url&
+    operator=(
+        url_view_base const& u)
+    {
+        copy(u);
+        return *this;
+    }
+
+    //--------------------------------------------
+
+    /** Swap the contents.
+
+        Exchanges the contents of this url with another
+        url. Urls stored on the heap exchange their
+        storage, while inline buffers are copied.
+        Views, iterators and references into the
+        inline buffers are invalidated.
+
+        If `this == &other`, this function call has no effect.
+
+        @par Example
+        @code
+        small_url< 64 > u1( "https://www.example.com" );
+        small_url< 64 > u2( "https://www.boost.org" );
+        u1.swap(u2);
+        assert(u1.buffer() == "https://www.boost.org" );
+        assert(u2.buffer() == "https://www.example.com" );
+        @endcode
+
+        @par Complexity
+        Linear in `this->size() + other.size()`.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param other The object to swap with
+
+    */
+    void
+    swap(small_url& other) noexcept
+    {
+        if(this == &other)
+            return;
+        small_url tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    /** Swap
+
+        Exchanges the contents of `v0` with another `v1`.
+
+        If `&v0 == &v1`, this function call has no effect.
+
+        @par Complexity
+        Linear in `v0.size() + v1.size()`.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param v0 The first object to swap
+        @param v1 The second object to swap
+
+        @see
+            @ref small_url::swap
+    */
+    friend
+    void
+    swap(small_url& v0, small_url& v1) noexcept
+    {
+        v0.swap(v1);
+    }
+
+    //--------------------------------------------
+
+    /** Return the storage counters
+
+        The counters are shared by every url
+        of this type, in all threads, and
+        are updated each time one of them
+        moves from its inline buffer to the
+        heap. A high number of spills
+        relative to the number of urls
+        suggests a larger `Capacity`.
+
+        @par Example
+        @code
+        small_url< 16 > u( "https://www.example.com/index.htm" );
+        assert( small_url< 16 >::stats().spills > 0 );
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    static
+    small_url_stats
+    stats() noexcept
+    {
+        return stats_impl(shared_counters());
+    }
+
+    /** Set the storage counters to zero
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    static
+    void
+    reset_stats() noexcept
+    {
+        auto& c = shared_counters();
+        c.spills.store(0, std::memory_order_relaxed);
+        c.max_spill_size.store(0, std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------
+    //
+    // fluent api
+    //
+
+    /// @copydoc url_base::set_scheme
+    small_url& set_scheme(core::string_view s) { url_base::set_scheme(s); return *this; }
+    /// @copydoc url_base::set_scheme_id
+    small_url& set_scheme_id(urls::scheme id) { url_base::set_scheme_id(id); return *this; }
+    /// @copydoc url_base::remove_scheme
+    small_url& remove_scheme() { url_base::remove_scheme(); return *this; }
+
+    /// @copydoc url_base::set_encoded_authority
+    small_url& set_encoded_authority(pct_string_view s) { url_base::set_encoded_authority(s); return *this; }
+    /// @copydoc url_base::remove_authority
+    small_url& remove_authority() { url_base::remove_authority(); return *this; }
+
+    /// @copydoc url_base::set_userinfo
+    small_url& set_userinfo(core::string_view s) { url_base::set_userinfo(s); return *this; }
+    /// @copydoc url_base::set_encoded_userinfo
+    small_url& set_encoded_userinfo(pct_string_view s) { url_base::set_encoded_userinfo(s); return *this; }
+    /// @copydoc url_base::remove_userinfo
+    small_url& remove_userinfo() noexcept { url_base::remove_userinfo(); return *this; }
+    /// @copydoc url_base::set_user
+    small_url& set_user(core::string_view s) { url_base::set_user(s); return *this; }
+    /// @copydoc url_base::set_encoded_user
+    small_url& set_encoded_user(pct_string_view s) { url_base::set_encoded_user(s); return *this; }
+    /// @copydoc url_base::set_password
+    small_url& set_password(core::string_view s) { url_base::set_password(s); return *this; }
+    /// @copydoc url_base::set_encoded_password
+    small_url& set_encoded_password(pct_string_view s) { url_base::set_encoded_password(s); return *this; }
+    /// @copydoc url_base::remove_password
+    small_url& remove_password() noexcept { url_base::remove_password(); return *this; }
+
+    /// @copydoc url_base::set_host
+    small_url& set_host(core::string_view s) { url_base::set_host(s); return *this; }
+    /// @copydoc url_base::set_encoded_host
+    small_url& set_encoded_host(pct_string_view s) { url_base::set_encoded_host(s); return *this; }
+    /// @copydoc url_base::set_host_address
+    small_url& set_host_address(core::string_view s) { url_base::set_host_address(s); return *this; }
+    /// @copydoc url_base::set_encoded_host_address
+    small_url& set_encoded_host_address(pct_string_view s) { url_base::set_encoded_host_address(s); return *this; }
+    /// @copydoc url_base::set_host_ipv4
+    small_url& set_host_ipv4(ipv4_address const& addr) { url_base::set_host_ipv4(addr); return *this; }
+    /// @copydoc url_base::set_host_ipv6
+    small_url& set_host_ipv6(ipv6_address const& addr) { url_base::set_host_ipv6(addr); return *this; }
+    /// @copydoc url_base::set_host_ipvfuture
+    small_url& set_host_ipvfuture(core::string_view s) { url_base::set_host_ipvfuture(s); return *this; }
+    /// @copydoc url_base::set_host_name
+    small_url& set_host_name(core::string_view s) { url_base::set_host_name(s); return *this; }
+    /// @copydoc url_base::set_encoded_host_name
+    small_url& set_encoded_host_name(pct_string_view s) { url_base::set_encoded_host_name(s); return *this; }
+    /// @copydoc url_base::set_port_number
+    small_url& set_port_number(std::uint16_t n) { url_base::set_port_number(n); return *this; }
+    /// @copydoc url_base::set_port
+    small_url& set_port(core::string_view s) { url_base::set_port(s); return *this; }
+    /// @copydoc url_base::remove_port
+    small_url& remove_port() noexcept { url_base::remove_port(); return *this; }
+
+    /// @copydoc url_base::set_path_absolute
+    //bool set_path_absolute(bool absolute);
+    /// @copydoc url_base::set_path
+    small_url& set_path(core::string_view s) { url_base::set_path(s); return *this; }
+    /// @copydoc url_base::set_encoded_path
+    small_url& set_encoded_path(pct_string_view s) { url_base::set_encoded_path(s); return *this; }
+
+    /// @copydoc url_base::set_query
+    small_url& set_query(core::string_view s) { url_base::set_query(s); return *this; }
+    /// @copydoc url_base::set_encoded_query
+    small_url& set_encoded_query(pct_string_view s) { url_base::set_encoded_query(s); return *this; }
+    /// @copydoc url_base::set_params
+    small_url& set_params(std::initializer_list<param_view> ps, encoding_opts opts = {}) { url_base::set_params(ps, opts); return *this; }
+    /// @copydoc url_base::remove_query
+    small_url& remove_query() noexcept { url_base::remove_query(); return *this; }
+
+    /// @copydoc url_base::remove_fragment
+    small_url& remove_fragment() noexcept { url_base::remove_fragment(); return *this; }
+    /// @copydoc url_base::set_fragment
+    small_url& set_fragment(core::string_view s) { url_base::set_fragment(s); return *this; }
+    /// @copydoc url_base::set_encoded_fragment
+    small_url& set_encoded_fragment(pct_string_view s) { url_base::set_encoded_fragment(s); return *this; }
+
+    /// @copydoc url_base::remove_origin
+    small_url& remove_origin() { url_base::remove_origin(); return *this; }
+
+    /// @copydoc url_base::normalize
+    small_url& normalize() { url_base::normalize(); return *this; }
+    /// @copydoc url_base::normalize_scheme
+    small_url& normalize_scheme() { url_base::normalize_scheme(); return *this; }
+    /// @copydoc url_base::normalize_authority
+    small_url& normalize_authority() { url_base::normalize_authority(); return *this; }
+    /// @copydoc url_base::normalize_path
+    small_url& normalize_path() { url_base::normalize_path(); return *this; }
+    /// @copydoc url_base::normalize_query
+    small_url& normalize_query() { url_base::normalize_query(); return *this; }
+    /// @copydoc url_base::normalize_fragment
+    small_url& normalize_fragment() { url_base::normalize_fragment(); return *this; }
+
+    //--------------------------------------------
+};
+
+} // urls
+} // boost
+
+//------------------------------------------------
+
+// std::hash specialization
+#ifndef BOOST_URL_DOCS
+namespace std {
+template<std::size_t N>
+struct hash< ::boost::urls::small_url<N> >
+{
+    hash() = default;
+    hash(hash const&) = default;
+    hash& operator=(hash const&) = default;
+
+    explicit
+    hash(std::size_t salt) noexcept
+        : salt_(salt)
+    {
+    }
+
+    hash(
+        std::size_t salt,
+        ::boost::urls::hash_algorithm alg) noexcept
+        : salt_(salt)
+        , alg_(alg)
+    {
+    }
+
+    std::size_t
+    operator()(::boost::urls::small_url<N> const& u) const noexcept
+    {
+        return u.digest(salt_, alg_);
+    }
+
+private:
+    std::size_t salt_ = 0;
+    ::boost::urls::hash_algorithm alg_ =
+        ::boost::urls::hash_algorithm::block;
+};
+} // std
+#endif
+
+#endif
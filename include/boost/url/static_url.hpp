@@ -85,6 +85,12 @@ class BOOST_URL_DECL
     invariant: changes to the url always
     leave it in a valid state.
 
+    Changes which exceed the capacity throw.
+    When long urls are rare, a @ref small_url
+    with a smaller inline buffer moves them
+    to the heap instead, and counts how often
+    this happens.
+
     @par Example
     @code
     static_url< 1024 > u( "https://www.example.com" );
@@ -100,6 +106,7 @@ class BOOST_URL_DECL
     null terminator.
 
     @see
+        @ref small_url,
         @ref url,
         @ref url_view.
 */
@@ -458,14 +465,24 @@ struct hash< ::boost::urls::static_url<N> >
     {
     }
 
+    hash(
+        std::size_t salt,
+        ::boost::urls::hash_algorithm alg) noexcept
+        : salt_(salt)
+        , alg_(alg)
+    {
+    }
+
     std::size_t
     operator()(::boost::urls::static_url<N> const& u) const noexcept
     {
-        return u.digest(salt_);
+        return u.digest(salt_, alg_);
     }
 
 private:
     std::size_t salt_ = 0;
+    ::boost::urls::hash_algorithm alg_ =
+        ::boost::urls::hash_algorithm::block;
 };
 } // std
 #endif
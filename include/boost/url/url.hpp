@@ -532,14 +532,24 @@ struct hash< ::boost::urls::url >
     {
     }
 
+    hash(
+        std::size_t salt,
+        ::boost::urls::hash_algorithm alg) noexcept
+        : salt_(salt)
+        , alg_(alg)
+    {
+    }
+
     std::size_t
     operator()(::boost::urls::url const& u) const noexcept
     {
-        return u.digest(salt_);
+        return u.digest(salt_, alg_);
     }
 
 private:
     std::size_t salt_ = 0;
+    ::boost::urls::hash_algorithm alg_ =
+        ::boost::urls::hash_algorithm::block;
 };
 } // std
 #endif
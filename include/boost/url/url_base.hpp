@@ -20,6 +20,7 @@
 #include <boost/url/scheme.hpp>
 #include <boost/url/segments_encoded_ref.hpp>
 #include <boost/url/segments_ref.hpp>
+#include <boost/url/url_editor.hpp>
 #include <boost/url/url_view_base.hpp>
 #include <cstdint>
 #include <initializer_list>
@@ -67,12 +68,19 @@ class BOOST_URL_DECL
     char* s_ = nullptr;
     std::size_t cap_ = 0;
 
+    // incremented each time the
+    // contents of the url change
+    std::size_t gen_ = 0;
+
     friend class url;
+    friend class basic_url_base;
+    friend class small_url_base;
     friend class static_url_base;
     friend class params_ref;
     friend class segments_ref;
     friend class segments_encoded_ref;
     friend class params_encoded_ref;
+    friend class url_editor;
 #ifndef BOOST_URL_DOCS
     friend struct detail::pattern;
 #endif
@@ -195,6 +203,42 @@ public:
     //
     // Fluent API
     //
+    //--------------------------------------------
+
+    /** Return an editor for this url
+
+        This function returns an object which
+        collects changes to several components
+        and applies them together, computing
+        the layout of the modified url once.
+
+        @par Example
+        @code
+        url u( "http://www.example.com/index.htm?id=1" );
+
+        u.edit()
+            .set_scheme( "https" )
+            .set_host( "proxy.example.com" )
+            .set_path( "/upstream/index.htm" )
+            .commit();
+
+        assert( u.buffer() == "https://proxy.example.com/upstream/index.htm?id=1" );
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @see
+            @ref url_editor.
+    */
+    url_editor
+    edit() noexcept
+    {
+        return url_editor(*this);
+    }
 
     //--------------------------------------------
     //
@@ -1887,10 +1931,7 @@ public:
 
     /// @copydoc url_view_base::segments
     segments_view
-    segments() const noexcept
-    {
-        return url_view_base::segments();
-    }
+    segments() const noexcept;
 
     /** Return the path as a container of segments
 
@@ -1948,10 +1989,7 @@ public:
 
     /// @copydoc url_view_base::encoded_segments
     segments_encoded_view
-    encoded_segments() const noexcept
-    {
-        return url_view_base::encoded_segments();
-    }
+    encoded_segments() const noexcept;
 
     //--------------------------------------------
     //
@@ -2112,10 +2150,7 @@ public:
 
     /// @copydoc url_view_base::params
     params_view
-    params() const noexcept
-    {
-        return url_view_base::params();
-    }
+    params() const noexcept;
 
     /** Return the query as a container of parameters
 
@@ -2172,10 +2207,7 @@ public:
 
     /// @copydoc url_view_base::encoded_params
     params_encoded_view
-    encoded_params() const noexcept
-    {
-        return url_view_base::encoded_params();
-    }
+    encoded_params() const noexcept;
 
     /** Return the query as a container of parameters
 
@@ -0,0 +1,665 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_BATCH_HPP
+#define BOOST_URL_URL_BATCH_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error_types.hpp>
+#include <boost/url/host_type.hpp>
+#include <boost/url/pct_string_view.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/parts_base.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+class url_batch;
+
+BOOST_URL_DECL
+void
+parse_uri_batch(
+    core::string_view const* items,
+    std::size_t n,
+    url_batch& out);
+
+BOOST_URL_DECL
+void
+parse_uri_batch(
+    core::string_view lines,
+    url_batch& out);
+
+BOOST_URL_DECL
+void
+parse_uri_reference_batch(
+    core::string_view const* items,
+    std::size_t n,
+    url_batch& out);
+
+BOOST_URL_DECL
+void
+parse_uri_reference_batch(
+    core::string_view lines,
+    url_batch& out);
+
+/** The results of parsing many URLs
+
+    Objects of this type hold the results of
+    @ref parse_uri_batch and
+    @ref parse_uri_reference_batch as a
+    structure of arrays: one column for each
+    component offset, the host type, the port
+    number, and the scheme, plus the error for
+    each item which failed to parse.
+    Offsets are stored as 32-bit integers.
+
+    Each item is parsed by the same rules as
+    @ref parse_uri or @ref parse_uri_reference
+    into a temporary @ref url_view, whose
+    offsets are then copied into the columns.
+    This saves the storage of a @ref url_view
+    for each item, but not the work of
+    parsing it. No @ref url_view is kept for
+    an item; one is constructed when
+    @ref view is called.
+    Components are returned as views into the
+    strings which were parsed; ownership is not
+    transferred. The caller is responsible for
+    ensuring that the lifetime of those
+    character buffers extends until the batch
+    is no longer being accessed.
+
+    @par Example
+    @code
+    url_batch b;
+    parse_uri_batch( "https://www.example.com/\nnot a url\n", b );
+
+    assert( b.size() == 2 );
+    assert( b.encoded_host( 0 ) == "www.example.com" );
+    assert( ! b.has_value( 1 ) );
+    @endcode
+
+    @see
+        @ref parse_uri_batch,
+        @ref parse_uri_reference_batch.
+*/
+class BOOST_URL_DECL url_batch
+    : private detail::parts_base
+{
+    // bits in flags_
+    static constexpr unsigned char failed_ = 1;
+    static constexpr unsigned char reference_ = 2;
+
+    std::vector<char const*> data_;
+    std::vector<std::uint32_t> offset_[id_end + 1];
+    std::vector<std::uint16_t> port_number_;
+    std::vector<unsigned char> host_type_;
+    std::vector<urls::scheme> scheme_;
+    std::vector<unsigned char> flags_;
+    std::vector<std::pair<
+        std::size_t, system::error_code>> errors_;
+
+    friend
+    BOOST_URL_DECL
+    void
+    parse_uri_batch(
+        core::string_view const*,
+        std::size_t, url_batch&);
+
+    friend
+    BOOST_URL_DECL
+    void
+    parse_uri_batch(
+        core::string_view, url_batch&);
+
+    friend
+    BOOST_URL_DECL
+    void
+    parse_uri_reference_batch(
+        core::string_view const*,
+        std::size_t, url_batch&);
+
+    friend
+    BOOST_URL_DECL
+    void
+    parse_uri_reference_batch(
+        core::string_view, url_batch&);
+
+    void push(core::string_view, bool);
+    std::size_t offset(
+        std::size_t, int) const noexcept;
+    core::string_view get(
+        std::size_t, int, int) const noexcept;
+
+public:
+    /** Constructor
+
+        Default constructed batches are empty.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    url_batch() noexcept = default;
+
+    /** Return the number of items
+
+        This includes the items which
+        failed to parse.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return data_.size();
+    }
+
+    /** Return true if there are no items
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    bool
+    empty() const noexcept
+    {
+        return data_.empty();
+    }
+
+    /** Return the number of items which failed to parse
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    std::size_t
+    error_count() const noexcept
+    {
+        return errors_.size();
+    }
+
+    /** Reserve space for items
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param n The number of items.
+    */
+    void
+    reserve(std::size_t n);
+
+    /** Remove all items
+
+        The capacity is retained, so the
+        batch can be reused without allocating.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    void
+    clear() noexcept;
+
+    /** Return true if an item was parsed successfully
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    bool
+    has_value(std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(i < size());
+        return (flags_[i] & failed_) == 0;
+    }
+
+    /** Return the error for an item
+
+        If the item was parsed successfully,
+        a default constructed error code is
+        returned.
+        Items longer than `UINT32_MAX` or
+        @ref url_view::max_size fail with
+        @ref error::no_space.
+
+        @par Complexity
+        Logarithmic in @ref error_count.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    system::error_code
+    error(std::size_t i) const noexcept;
+
+    /** Return the string for an item
+
+        This is the complete string which
+        was parsed, including for items which
+        failed to parse, except when the item
+        was too long for the batch.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    core::string_view
+    buffer(std::size_t i) const noexcept;
+
+    /** Return a view of an item
+
+        The string for the item is parsed
+        again to produce a @ref url_view.
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Complexity
+        Linear in `this->buffer( i ).size()`.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    url_view
+    view(std::size_t i) const noexcept;
+
+    /** Return the scheme of an item
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+
+        @see @ref url_view_base::scheme.
+    */
+    core::string_view
+    scheme(std::size_t i) const noexcept;
+
+    /** Return the known scheme of an item
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+
+        @see @ref url_view_base::scheme_id.
+    */
+    urls::scheme
+    scheme_id(std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(has_value(i));
+        return scheme_[i];
+    }
+
+    /** Return true if an item has an authority
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    bool
+    has_authority(std::size_t i) const noexcept;
+
+    /** Return the userinfo of an item
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+
+        @see @ref url_view_base::encoded_userinfo.
+    */
+    pct_string_view
+    encoded_userinfo(std::size_t i) const noexcept;
+
+    /** Return the host of an item
+
+        IP-literal hosts include the
+        enclosing brackets.
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+
+        @see @ref url_view_base::encoded_host.
+    */
+    pct_string_view
+    encoded_host(std::size_t i) const noexcept;
+
+    /** Return the host type of an item
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    urls::host_type
+    host_type(std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(has_value(i));
+        return static_cast<
+            urls::host_type>(host_type_[i]);
+    }
+
+    /** Return true if an item has a port
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    bool
+    has_port(std::size_t i) const noexcept;
+
+    /** Return the port of an item
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    core::string_view
+    port(std::size_t i) const noexcept;
+
+    /** Return the port number of an item
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    std::uint16_t
+    port_number(std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(has_value(i));
+        return port_number_[i];
+    }
+
+    /** Return the path of an item
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    pct_string_view
+    encoded_path(std::size_t i) const noexcept;
+
+    /** Return true if an item has a query
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    bool
+    has_query(std::size_t i) const noexcept;
+
+    /** Return the query of an item
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    pct_string_view
+    encoded_query(std::size_t i) const noexcept;
+
+    /** Return true if an item has a fragment
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    bool
+    has_fragment(std::size_t i) const noexcept;
+
+    /** Return the fragment of an item
+
+        @par Preconditions
+        @code
+        this->has_value( i )
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param i The index of the item.
+    */
+    pct_string_view
+    encoded_fragment(std::size_t i) const noexcept;
+};
+
+//------------------------------------------------
+
+/** Parse many strings as URIs
+
+    Each string is parsed as if by
+    @ref parse_uri, and the results are
+    appended to `out`.
+    Ownership of the strings is not
+    transferred; the caller is responsible
+    for ensuring that the lifetime of the
+    character buffers extends until the
+    batch is no longer being accessed.
+
+    @par Example
+    @code
+    core::string_view v[] = { "https://a.com/", "mailto:b@c.com" };
+    url_batch b;
+    parse_uri_batch( v, 2, b );
+    @endcode
+
+    @par Exception Safety
+    Basic guarantee.
+    Calls to allocate may throw.
+
+    @param items A pointer to the strings.
+
+    @param n The number of strings.
+
+    @param out The batch to append to.
+
+    @see
+        @ref parse_uri,
+        @ref url_batch.
+*/
+BOOST_URL_DECL
+void
+parse_uri_batch(
+    core::string_view const* items,
+    std::size_t n,
+    url_batch& out);
+
+/** Parse each line of a buffer as a URI
+
+    The buffer is split at each newline and
+    each line is parsed as if by @ref parse_uri,
+    with the results appended to `out`.
+    A trailing carriage return on each line is
+    ignored, and no item is appended for the
+    empty string after a final newline.
+
+    @par Example
+    @code
+    url_batch b;
+    parse_uri_batch( "https://a.com/\r\nmailto:b@c.com\r\n", b );
+    assert( b.size() == 2 );
+    @endcode
+
+    @par Exception Safety
+    Basic guarantee.
+    Calls to allocate may throw.
+
+    @param lines The newline-delimited buffer.
+
+    @param out The batch to append to.
+
+    @see
+        @ref parse_uri,
+        @ref url_batch.
+*/
+BOOST_URL_DECL
+void
+parse_uri_batch(
+    core::string_view lines,
+    url_batch& out);
+
+/** Parse many strings as URI-references
+
+    Each string is parsed as if by
+    @ref parse_uri_reference, and the results
+    are appended to `out`.
+    Ownership of the strings is not
+    transferred; the caller is responsible
+    for ensuring that the lifetime of the
+    character buffers extends until the
+    batch is no longer being accessed.
+
+    @par Exception Safety
+    Basic guarantee.
+    Calls to allocate may throw.
+
+    @param items A pointer to the strings.
+
+    @param n The number of strings.
+
+    @param out The batch to append to.
+
+    @see
+        @ref parse_uri_reference,
+        @ref url_batch.
+*/
+BOOST_URL_DECL
+void
+parse_uri_reference_batch(
+    core::string_view const* items,
+    std::size_t n,
+    url_batch& out);
+
+/** Parse each line of a buffer as a URI-reference
+
+    The buffer is split at each newline and
+    each line is parsed as if by
+    @ref parse_uri_reference, with the results
+    appended to `out`.
+    A trailing carriage return on each line is
+    ignored, and no item is appended for the
+    empty string after a final newline.
+
+    @par Exception Safety
+    Basic guarantee.
+    Calls to allocate may throw.
+
+    @param lines The newline-delimited buffer.
+
+    @param out The batch to append to.
+
+    @see
+        @ref parse_uri_reference,
+        @ref url_batch.
+*/
+BOOST_URL_DECL
+void
+parse_uri_reference_batch(
+    core::string_view lines,
+    url_batch& out);
+
+} // urls
+} // boost
+
+#endif
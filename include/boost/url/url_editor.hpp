@@ -0,0 +1,367 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_EDITOR_HPP
+#define BOOST_URL_URL_EDITOR_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/host_type.hpp>
+#include <boost/url/ipv6_address.hpp>
+#include <boost/url/pct_string_view.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+class url_base;
+#endif
+
+/** A batch of modifications to a url
+
+    Objects of this type collect changes to
+    several components of a url and apply
+    them together when @ref commit is called.
+    Each modifier of @ref url_base resizes the
+    url separately, which can reallocate the
+    buffer and move every character after the
+    modified component. An editor computes
+    the final layout of the url once, grows
+    the buffer at most once, moves each kept
+    component at most once, and then writes
+    the new components in place.
+
+    Objects of this type are obtained by
+    calling @ref url_base::edit.
+    The result of a commit is the same as
+    calling the corresponding modifiers of
+    the url in this order: scheme, host,
+    port, path, query, fragment.
+
+    @par Example
+    @code
+    url u( "http://www.example.com:8080/index.htm?id=1" );
+
+    u.edit()
+        .set_scheme( "https" )
+        .set_host( "proxy.example.com" )
+        .set_port_number( 443 )
+        .set_path( "/upstream/index.htm" )
+        .remove_query()
+        .commit();
+
+    assert( u.buffer() == "https://proxy.example.com:443/upstream/index.htm" );
+    @endcode
+
+    @par Lifetime
+    The editor refers to the url it was
+    obtained from, and to the strings passed
+    to its modifiers; ownership is not
+    transferred. The caller is responsible
+    for ensuring that the url and the strings
+    remain valid until @ref commit returns.
+    The strings may refer to the url itself.
+
+    @par Exception Safety
+    Modifiers which validate their argument
+    throw immediately, leaving the url
+    unchanged.
+
+    @see
+        @ref url_base::edit.
+*/
+class BOOST_URL_DECL url_editor
+{
+    struct part
+    {
+        core::string_view s;
+        std::size_t dn = 0;
+        unsigned char how = 0;
+    };
+
+    url_base* u_;
+    part scheme_;
+    part host_;
+    part port_;
+    part path_;
+    part query_;
+    part frag_;
+    urls::scheme scheme_id_ =
+        urls::scheme::none;
+    urls::host_type host_type_ =
+        urls::host_type::none;
+    std::uint16_t port_number_ = 0;
+    unsigned char ip_addr_[16] = {};
+    char host_buf_[2 +
+        ipv6_address::max_str_len] = {};
+    char port_buf_[6] = {};
+
+    friend class url_base;
+
+    explicit
+    url_editor(url_base& u) noexcept
+        : u_(&u)
+    {
+    }
+
+    void set_host_impl(
+        core::string_view, unsigned char, std::size_t);
+    core::string_view get(
+        part const&, char const*) const noexcept;
+
+public:
+    /** Constructor
+
+        Copies of an editor refer to the same
+        url and hold the same pending changes.
+    */
+    url_editor(
+        url_editor const&) = default;
+
+    /** Assignment
+    */
+    url_editor& operator=(
+        url_editor const&) = default;
+
+    /** Set the scheme
+
+        @par Exception Safety
+        Exceptions thrown on invalid input.
+
+        @throw system_error
+        `s` is not a valid scheme.
+
+        @param s The scheme to set.
+
+        @see
+            @ref url_base::set_scheme.
+    */
+    url_editor&
+    set_scheme(core::string_view s);
+
+    /** Set the host
+
+        Depending on the contents of the
+        passed string, the host is an IP
+        address, an IPvFuture, or a reg-name.
+        Reserved characters in a reg-name
+        are percent-escaped.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param s The string to set.
+
+        @see
+            @ref url_base::set_host.
+    */
+    url_editor&
+    set_host(core::string_view s);
+
+    /** Set the host
+
+        This function is the same as
+        @ref set_host, except that percent
+        escapes in a reg-name are kept.
+
+        @par Exception Safety
+        Exceptions thrown on invalid input.
+
+        @throw system_error
+        `s` contains an invalid percent-encoding.
+
+        @param s The string to set.
+
+        @see
+            @ref url_base::set_encoded_host.
+    */
+    url_editor&
+    set_encoded_host(pct_string_view s);
+
+    /** Set the port
+
+        @par Exception Safety
+        Exceptions thrown on invalid input.
+
+        @throw system_error
+        `s` does not contain a valid port.
+
+        @param s The port string to set.
+
+        @see
+            @ref url_base::set_port.
+    */
+    url_editor&
+    set_port(core::string_view s);
+
+    /** Set the port
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param n The port number to set.
+
+        @see
+            @ref url_base::set_port_number.
+    */
+    url_editor&
+    set_port_number(std::uint16_t n);
+
+    /** Set the path
+
+        Reserved characters are percent-escaped.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param s The string to set.
+
+        @see
+            @ref url_base::set_path.
+    */
+    url_editor&
+    set_path(core::string_view s);
+
+    /** Set the path
+
+        Percent escapes in the string are kept.
+
+        @par Exception Safety
+        Exceptions thrown on invalid input.
+
+        @throw system_error
+        `s` contains an invalid percent-encoding.
+
+        @param s The string to set.
+
+        @see
+            @ref url_base::set_encoded_path.
+    */
+    url_editor&
+    set_encoded_path(pct_string_view s);
+
+    /** Set the query
+
+        Reserved characters are percent-escaped.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param s The string to set.
+
+        @see
+            @ref url_base::set_query.
+    */
+    url_editor&
+    set_query(core::string_view s);
+
+    /** Set the query
+
+        Percent escapes in the string are kept.
+
+        @par Exception Safety
+        Exceptions thrown on invalid input.
+
+        @throw system_error
+        `s` contains an invalid percent-encoding.
+
+        @param s The string to set.
+
+        @see
+            @ref url_base::set_encoded_query.
+    */
+    url_editor&
+    set_encoded_query(pct_string_view s);
+
+    /** Remove the query
+
+        @par Exception Safety
+        Throws nothing.
+
+        @see
+            @ref url_base::remove_query.
+    */
+    url_editor&
+    remove_query() noexcept;
+
+    /** Set the fragment
+
+        Reserved characters are percent-escaped.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param s The string to set.
+
+        @see
+            @ref url_base::set_fragment.
+    */
+    url_editor&
+    set_fragment(core::string_view s);
+
+    /** Set the fragment
+
+        Percent escapes in the string are kept.
+
+        @par Exception Safety
+        Exceptions thrown on invalid input.
+
+        @throw system_error
+        `s` contains an invalid percent-encoding.
+
+        @param s The string to set.
+
+        @see
+            @ref url_base::set_encoded_fragment.
+    */
+    url_editor&
+    set_encoded_fragment(pct_string_view s);
+
+    /** Remove the fragment
+
+        @par Exception Safety
+        Throws nothing.
+
+        @see
+            @ref url_base::remove_fragment.
+    */
+    url_editor&
+    remove_fragment() noexcept;
+
+    /** Apply the changes to the url
+
+        All pending changes are applied to the
+        url, after which the editor has no
+        pending changes and may be reused.
+
+        @par Complexity
+        Linear in the size of the url and of
+        the new components.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+        Exceptions thrown on invalid input.
+
+        @throw std::length_error
+        The resulting url is too large.
+
+        @return A reference to the url.
+    */
+    url_base&
+    commit();
+};
+
+} // urls
+} // boost
+
+#endif
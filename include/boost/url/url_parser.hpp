@@ -0,0 +1,259 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#ifndef BOOST_URL_URL_PARSER_HPP
+#define BOOST_URL_URL_PARSER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error_types.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/url_impl.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+/** An incremental parser for URL strings
+
+    Objects of this type parse a URL which
+    arrives in pieces, such as the request
+    target of an HTTP request read from a
+    socket in arbitrary chunks. Each call to
+    @ref write appends a chunk to an internal
+    buffer and validates only the new
+    characters, while the offsets of the
+    components found so far are kept. When
+    the input is complete, @ref finish
+    returns a @ref url_view of the buffer
+    without parsing the string again.
+
+    The grammar is the same as the one used
+    by @ref parse_uri_reference, and the
+    resulting view is identical to the one
+    returned by that function for the
+    concatenated chunks.
+
+    @par Example
+    @code
+    url_parser p;
+    p.write( "https://www.exa" );
+    p.write( "mple.com/index.h" );
+    p.write( "tm?id=1" );
+    assert( p.result().error() == grammar::error::need_more );
+
+    system::result< url_view > rv = p.finish();
+    assert( rv->encoded_host() == "www.example.com" );
+    assert( rv->encoded_path() == "/index.htm" );
+    @endcode
+
+    @par BNF
+    @code
+    URI-reference = URI / relative-ref
+    @endcode
+
+    @par Specification
+    @li <a href="https://datatracker.ietf.org/doc/html/rfc3986#section-4.1"
+        >4.1. URI Reference</a>
+
+    @see
+        @ref parse_uri_reference,
+        @ref url_view.
+*/
+class BOOST_URL_DECL url_parser
+{
+    std::string buf_;
+    detail::url_impl u_{
+        detail::url_impl::from::string};
+    system::error_code ec_;
+
+    // start of the pending part
+    std::size_t pos_ = 0;
+    // percent-escapes in the pending part
+    std::size_t npct_ = 0;
+    // slashes or ampersands in the pending part
+    std::size_t nsep_ = 0;
+    // hex digits owed by a percent-escape
+    unsigned char hex_ = 0;
+    unsigned char st_ = 0;
+
+    void scan(char const*, char const*) noexcept;
+    void end_authority(std::size_t) noexcept;
+    void end_path(std::size_t) noexcept;
+    void end_query(std::size_t) noexcept;
+    void end_frag(std::size_t) noexcept;
+
+public:
+    /** Constructor
+
+        Default constructed parsers have not
+        received any input.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    url_parser() noexcept;
+
+    /** Constructor
+
+        The parser is constructed with at
+        least `n` characters of capacity in
+        its buffer, so that URLs up to this
+        size do not allocate.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @param n The number of characters
+        to reserve.
+    */
+    explicit
+    url_parser(
+        std::size_t n);
+
+    /** Append characters to the URL
+
+        The characters are appended to the
+        buffer and validated. Characters
+        received in earlier calls are not
+        examined again.
+        Once an error is returned, the same
+        error is returned by every subsequent
+        call until the parser is reset.
+
+        @par Example
+        @code
+        url_parser p;
+        assert( p.write( "/path?" ).has_value() );
+        assert( p.write( "%zz" ).has_error() );
+        @endcode
+
+        @par Complexity
+        Amortized linear in `s.size()`.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @return An error if the characters
+        received so far are not the beginning
+        of a valid URL, or if the parser
+        has finished.
+
+        @param s The characters to append.
+
+        @throw std::length_error The total size
+        exceeds @ref url_view::max_size.
+    */
+    system::result<void>
+    write(core::string_view s);
+
+    /** Signal the end of the URL
+
+        This function tells the parser that
+        no more characters will be appended,
+        and returns the parsed URL.
+        The returned view references the
+        buffer of the parser, and remains
+        valid until the parser is reset or
+        destroyed.
+
+        @par Example
+        @code
+        url_parser p;
+        p.write( "//example.com" );
+        assert( p.finish()->encoded_host() == "example.com" );
+        @endcode
+
+        @par Complexity
+        Linear in the size of the authority,
+        if the URL ends inside it. Otherwise
+        constant.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @return A view of the URL, or an error
+        if the characters received are not a
+        valid URL.
+    */
+    system::result<url_view>
+    finish() noexcept;
+
+    /** Return the parsed URL
+
+        Before @ref finish is called, this
+        returns `grammar::error::need_more`
+        unless an error was found.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    system::result<url_view>
+    result() const noexcept;
+
+    /** Return true if finish was called
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    bool
+    is_done() const noexcept;
+
+    /** Return the characters received
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    core::string_view
+    buffer() const noexcept
+    {
+        return buf_;
+    }
+
+    /** Prepare to parse a new URL
+
+        All characters are discarded, while
+        the capacity of the buffer is kept.
+        Views returned by the parser are
+        invalidated.
+
+        @par Example
+        @code
+        url_parser p;
+        p.write( "/a" );
+        p.finish();
+        p.reset();
+        p.write( "/b" );
+        assert( p.finish()->buffer() == "/b" );
+        @endcode
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    void
+    reset() noexcept;
+};
+
+} // urls
+} // boost
+
+#endif
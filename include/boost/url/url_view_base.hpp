@@ -41,6 +41,37 @@ struct pattern;
 }
 #endif
 
+/** The algorithm used to hash a url
+
+    Values of this type select how the
+    specializations of `std::hash` for the
+    url containers compute their digest.
+    Both algorithms hash the url as if it
+    were normalized, so urls which compare
+    equal always produce equal hashes.
+
+    @see
+        @ref url_view_base::compare.
+*/
+enum class hash_algorithm
+{
+    /** Hash the normalized url in blocks
+
+        The normalized characters are consumed
+        sixteen at a time and mixed with a wide
+        multiplication. This is the default.
+    */
+    block,
+
+    /** Hash the normalized url one char at a time
+
+        This is the FNV-1a algorithm. It produces
+        the values of earlier versions of the
+        library.
+    */
+    fnv_1a
+};
+
 
 /** Common functionality for containers
 
@@ -70,7 +101,11 @@ class BOOST_URL_DECL
     detail::url_impl const* pi_;
 
     friend class url;
+    friend class basic_url_base;
+    friend class small_url_base;
     friend class url_base;
+    friend class url_batch;
+    friend class url_editor;
     friend class url_view;
     friend class static_url_base;
     friend class params_base;
@@ -123,11 +158,16 @@ protected:
         @param salt An initial value to add to
         the hash
 
+        @param alg The hash algorithm to use.
+
         @return A hash value suitable for use
         in hash-based containers.
     */
     std::size_t
-    digest(std::size_t salt = 0) const noexcept;
+    digest(
+        std::size_t salt = 0,
+        hash_algorithm alg =
+            hash_algorithm::block) const noexcept;
 
 public:
     //--------------------------------------------
@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/basic_url.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+void
+basic_url_base::
+release() noexcept
+{
+    if(s_)
+    {
+        BOOST_ASSERT(
+            cap_ != 0);
+        deallocate(s_, cap_);
+        s_ = nullptr;
+        cap_ = 0;
+    }
+    impl_ = {from::url};
+    ++gen_;
+}
+
+void
+basic_url_base::
+steal(basic_url_base& u) noexcept
+{
+    BOOST_ASSERT(s_ == nullptr);
+    impl_ = u.impl_;
+    ++gen_;
+    s_ = u.s_;
+    cap_ = u.cap_;
+    u.s_ = nullptr;
+    u.cap_ = 0;
+    u.impl_ = {from::url};
+    ++u.gen_;
+}
+
+void
+basic_url_base::
+swap_impl(basic_url_base& u) noexcept
+{
+    std::swap(s_, u.s_);
+    std::swap(cap_, u.cap_);
+    std::swap(impl_, u.impl_);
+    ++gen_;
+    ++u.gen_;
+}
+
+void
+basic_url_base::
+clear_impl() noexcept
+{
+    if(s_)
+    {
+        // preserve capacity
+        impl_ = {from::url};
+        ++gen_;
+        s_[0] = '\0';
+        impl_.cs_ = s_;
+    }
+    else
+    {
+        BOOST_ASSERT(impl_.cs_[0] == 0);
+    }
+}
+
+void
+basic_url_base::
+reserve_impl(
+    std::size_t n,
+    op_t& op)
+{
+    if(n > max_size())
+        detail::throw_length_error();
+    if(n <= cap_)
+        return;
+    char* s;
+    if(s_ != nullptr)
+    {
+        // 50% growth policy
+        auto const h = cap_ / 2;
+        std::size_t new_cap;
+        if(cap_ <= max_size() - h)
+            new_cap = cap_ + h;
+        else
+            new_cap = max_size();
+        if( new_cap < n)
+            new_cap = n;
+        s = allocate(new_cap);
+        std::memcpy(s, s_, size() + 1);
+        BOOST_ASSERT(! op.old);
+        op.old = s_;
+        old_cap_ = cap_;
+        s_ = s;
+        cap_ = new_cap;
+    }
+    else
+    {
+        s_ = allocate(n);
+        cap_ = n;
+        s_[0] = '\0';
+    }
+    impl_.cs_ = s_;
+}
+
+void
+basic_url_base::
+cleanup(
+    op_t& op)
+{
+    if(op.old)
+        deallocate(op.old, old_cap_);
+}
+
+} // urls
+} // boost
@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/compiled_format.hpp>
+#include "detail/pattern.hpp"
+
+namespace boost {
+namespace urls {
+
+compiled_format::
+compiled_format(
+    core::string_view fmt)
+    : s_(fmt)
+{
+    using parts = detail::parts_base;
+    detail::pattern const p =
+        detail::parse_pattern(s_
+            ).value(BOOST_URL_POS);
+
+    // store offsets rather than views,
+    // so that copies remain valid
+    auto const set = [this](
+        int id, core::string_view v)
+    {
+        if (v.empty())
+            return;
+        pos_[id + 1] = v.data() - s_.data();
+        len_[id + 1] = v.size();
+    };
+    set(parts::id_scheme, p.scheme);
+    set(parts::id_user, p.user);
+    set(parts::id_pass, p.pass);
+    set(parts::id_host, p.host);
+    set(parts::id_port, p.port);
+    set(parts::id_path, p.path);
+    set(parts::id_query, p.query);
+    set(parts::id_frag, p.frag);
+    has_authority_ = p.has_authority;
+    has_user_ = p.has_user;
+    has_pass_ = p.has_pass;
+    has_port_ = p.has_port;
+    has_query_ = p.has_query;
+    has_frag_ = p.has_frag;
+
+    detail::compile_pattern(
+        p, pieces_, first_);
+}
+
+} // urls
+} // boost
+
@@ -12,8 +12,19 @@
 #include "decode.hpp"
 #include <boost/url/grammar/charset.hpp>
 #include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/url/grammar/detail/charset.hpp>
+#include <boost/core/bit.hpp>
+#include <cstring>
 #include <memory>
 
+#ifdef BOOST_URL_USE_SSE2
+# include <immintrin.h>
+#endif
+
+#ifdef BOOST_URL_USE_NEON
+# include <arm_neon.h>
+#endif
+
 namespace boost {
 namespace urls {
 namespace detail {
@@ -31,28 +42,19 @@ decode_one(
             unsigned char>(d1))));
 }
 
-std::size_t
-decode_bytes_unsafe(
-    core::string_view s) noexcept
-{
-    auto p = s.begin();
-    auto const end = s.end();
-    std::size_t dn = 0;
-    if(s.size() >= 3)
-    {
-        auto const safe_end = end - 2;
-        while(p < safe_end)
-        {
-            if(*p != '%')
-                p += 1;
-            else
-                p += 3;
-            ++dn;
-        }
-    }
-    dn += end - p;
-    return dn;
-}
+namespace {
+
+/*  Strings shorter than this are decoded
+    one character at a time, since the
+    kernels would not see a full block.
+*/
+constexpr std::size_t min_block_size = 16;
+
+//------------------------------------------------
+//
+// scalar
+//
+//------------------------------------------------
 
 template <bool SpaceAsPlus>
 std::size_t
@@ -72,18 +74,15 @@ decode_unsafe_is_plus_impl<false>(char)
     return false;
 }
 
-
 template <bool SpaceAsPlus>
 std::size_t
 decode_unsafe_impl(
     char* const dest0,
+    char* dest,
     char const* end,
-    core::string_view s) noexcept
+    char const* it,
+    char const* const last) noexcept
 {
-    auto it = s.data();
-    auto const last = it + s.size();
-    auto dest = dest0;
-
     while(it != last)
     {
         // LCOV_EXCL_START
@@ -131,6 +130,518 @@ decode_unsafe_impl(
     return dest - dest0;
 }
 
+template <bool SpaceAsPlus>
+std::size_t
+decode_scalar(
+    char* const dest0,
+    char const* end,
+    core::string_view s) noexcept
+{
+    return decode_unsafe_impl<SpaceAsPlus>(
+        dest0, dest0, end, s.data(),
+        s.data() + s.size());
+}
+
+/*  Scan [p, last) counting the `%` into n,
+    and return true if each one is followed
+    by two hex digits. Bit i of `need` means
+    that p[i] must be a hex digit, for an
+    escape which started before p.
+*/
+bool
+scan_scalar(
+    char const* p,
+    char const* const last,
+    unsigned need,
+    std::size_t& n) noexcept
+{
+    for(; p != last; ++p, need >>= 1)
+    {
+        if(*p == '%')
+        {
+            need |= 6;
+            ++n;
+        }
+        if( (need & 1) &&
+            grammar::hexdig_value(*p) < 0)
+            return false;
+    }
+    return need == 0;
+}
+
+#ifdef BOOST_URL_USE_SSE2
+
+//------------------------------------------------
+//
+// x86
+//
+//------------------------------------------------
+
+// Return 0xFF in each byte which is a hex digit
+inline
+__m128i
+hexdig_sse2(__m128i v) noexcept
+{
+    // unsigned c - '0' <= 9, or
+    // unsigned (c | 0x20) - 'a' <= 5
+    __m128i const d = _mm_sub_epi8(
+        v, _mm_set1_epi8('0'));
+    __m128i const a = _mm_sub_epi8(
+        _mm_or_si128(v, _mm_set1_epi8(0x20)),
+        _mm_set1_epi8('a'));
+    return _mm_or_si128(
+        _mm_cmpeq_epi8(_mm_min_epu8(
+            d, _mm_set1_epi8(9)), d),
+        _mm_cmpeq_epi8(_mm_min_epu8(
+            a, _mm_set1_epi8(5)), a));
+}
+
+bool
+scan_sse2(
+    char const* p,
+    char const* const last,
+    unsigned need,
+    std::size_t& n) noexcept
+{
+    __m128i const pct = _mm_set1_epi8('%');
+    while(last - p >= 16)
+    {
+        __m128i const v = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p));
+        std::uint32_t const esc =
+            static_cast<std::uint32_t>(
+                _mm_movemask_epi8(
+                    _mm_cmpeq_epi8(v, pct)));
+        std::uint32_t const hex =
+            static_cast<std::uint32_t>(
+                _mm_movemask_epi8(
+                    hexdig_sse2(v)));
+        // the two bytes after each `%`
+        std::uint32_t const want =
+            (esc << 1) | (esc << 2) | need;
+        if((want & ~hex & 0xFFFF) != 0)
+            return false;
+        need = want >> 16;
+        n += boost::core::popcount(esc);
+        p += 16;
+    }
+    return scan_scalar(p, last, need, n);
+}
+
+/*  Copy 16-byte blocks from it to dest,
+    stopping at each `%` to decode it,
+    until either buffer has less than
+    a block left.
+*/
+template<bool SpaceAsPlus>
+void
+decode_blocks_sse2(
+    char*& dest,
+    char const* end,
+    char const*& it,
+    char const* const last) noexcept
+{
+    __m128i const pct = _mm_set1_epi8('%');
+    __m128i const plus = _mm_set1_epi8('+');
+    // '+' ^ ' '
+    __m128i const flip = _mm_set1_epi8(0x0B);
+    while(
+        last - it >= 16 &&
+        end - dest >= 16)
+    {
+        __m128i v = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(it));
+        if(SpaceAsPlus)
+            v = _mm_xor_si128(v, _mm_and_si128(
+                _mm_cmpeq_epi8(v, plus), flip));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dest), v);
+        unsigned const esc = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(v, pct)));
+        if(esc == 0)
+        {
+            it += 16;
+            dest += 16;
+            continue;
+        }
+        auto const k =
+            boost::core::countr_zero(esc);
+        it += k;
+        dest += k;
+        // LCOV_EXCL_START
+        if(last - it < 3)
+            return;
+        // LCOV_EXCL_STOP
+        // escapes often come in runs,
+        // such as UTF-8 sequences
+        do
+        {
+            *dest++ = decode_one(it + 1);
+            it += 3;
+        }
+        while(
+            last - it >= 3 &&
+            *it == '%');
+    }
+}
+
+template<bool SpaceAsPlus>
+std::size_t
+decode_sse2(
+    char* const dest0,
+    char const* end,
+    core::string_view s) noexcept
+{
+    char* dest = dest0;
+    char const* it = s.data();
+    char const* const last = it + s.size();
+    decode_blocks_sse2<SpaceAsPlus>(
+        dest, end, it, last);
+    return decode_unsafe_impl<SpaceAsPlus>(
+        dest0, dest, end, it, last);
+}
+
+BOOST_URL_TARGET("avx2")
+inline
+__m256i
+hexdig_avx2(__m256i v) noexcept
+{
+    __m256i const d = _mm256_sub_epi8(
+        v, _mm256_set1_epi8('0'));
+    __m256i const a = _mm256_sub_epi8(
+        _mm256_or_si256(v, _mm256_set1_epi8(0x20)),
+        _mm256_set1_epi8('a'));
+    return _mm256_or_si256(
+        _mm256_cmpeq_epi8(_mm256_min_epu8(
+            d, _mm256_set1_epi8(9)), d),
+        _mm256_cmpeq_epi8(_mm256_min_epu8(
+            a, _mm256_set1_epi8(5)), a));
+}
+
+BOOST_URL_TARGET("avx2")
+bool
+scan_avx2(
+    char const* p,
+    char const* const last,
+    unsigned need,
+    std::size_t& n) noexcept
+{
+    __m256i const pct = _mm256_set1_epi8('%');
+    while(last - p >= 32)
+    {
+        __m256i const v = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(p));
+        std::uint64_t const esc =
+            static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(v, pct)));
+        std::uint64_t const hex =
+            static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(
+                    hexdig_avx2(v)));
+        std::uint64_t const want =
+            (esc << 1) | (esc << 2) | need;
+        if((want & ~hex & 0xFFFFFFFF) != 0)
+            return false;
+        need = static_cast<unsigned>(want >> 32);
+        n += boost::core::popcount(esc);
+        p += 32;
+    }
+    return scan_sse2(p, last, need, n);
+}
+
+template<bool SpaceAsPlus>
+BOOST_URL_TARGET("avx2")
+std::size_t
+decode_avx2(
+    char* const dest0,
+    char const* end,
+    core::string_view s) noexcept
+{
+    char* dest = dest0;
+    char const* it = s.data();
+    char const* const last = it + s.size();
+    __m256i const pct = _mm256_set1_epi8('%');
+    __m256i const plus = _mm256_set1_epi8('+');
+    __m256i const flip = _mm256_set1_epi8(0x0B);
+    while(
+        last - it >= 32 &&
+        end - dest >= 32)
+    {
+        __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(it));
+        if(SpaceAsPlus)
+            v = _mm256_xor_si256(v, _mm256_and_si256(
+                _mm256_cmpeq_epi8(v, plus), flip));
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(dest), v);
+        std::uint32_t const esc =
+            static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(v, pct)));
+        if(esc == 0)
+        {
+            it += 32;
+            dest += 32;
+            continue;
+        }
+        auto const k =
+            boost::core::countr_zero(esc);
+        it += k;
+        dest += k;
+        // LCOV_EXCL_START
+        if(last - it < 3)
+            break;
+        // LCOV_EXCL_STOP
+        do
+        {
+            *dest++ = decode_one(it + 1);
+            it += 3;
+        }
+        while(
+            last - it >= 3 &&
+            *it == '%');
+    }
+    // avoid the transition penalty
+    // when running SSE code next
+    _mm256_zeroupper();
+    decode_blocks_sse2<SpaceAsPlus>(
+        dest, end, it, last);
+    return decode_unsafe_impl<SpaceAsPlus>(
+        dest0, dest, end, it, last);
+}
+
+#endif
+
+#ifdef BOOST_URL_USE_NEON
+
+//------------------------------------------------
+//
+// NEON
+//
+//------------------------------------------------
+
+inline
+uint8x16_t
+hexdig_neon(uint8x16_t v) noexcept
+{
+    return vorrq_u8(
+        vcleq_u8(vsubq_u8(v,
+            vdupq_n_u8('0')), vdupq_n_u8(9)),
+        vcleq_u8(vsubq_u8(vorrq_u8(v,
+            vdupq_n_u8(0x20)), vdupq_n_u8('a')),
+            vdupq_n_u8(5)));
+}
+
+// Return four bits for each 0xFF byte
+inline
+std::uint64_t
+movemask_neon(uint8x16_t m) noexcept
+{
+    return vget_lane_u64(vreinterpret_u64_u8(
+        vshrn_n_u16(vreinterpretq_u16_u8(
+            m), 4)), 0);
+}
+
+bool
+scan_neon(
+    char const* p,
+    char const* const last,
+    unsigned need,
+    std::size_t& n) noexcept
+{
+    uint8x16_t const pct = vdupq_n_u8('%');
+    // the escapes of the previous block,
+    // shifted into the current one
+    uint8x16_t prev = vdupq_n_u8(0);
+    if(need & 2)
+        prev = vsetq_lane_u8(0xFF, prev, 15);
+    if(need & 1)
+        prev = vsetq_lane_u8(0xFF, prev, 14);
+    while(last - p >= 16)
+    {
+        uint8x16_t const v = vld1q_u8(
+            reinterpret_cast<std::uint8_t const*>(p));
+        uint8x16_t const esc = vceqq_u8(v, pct);
+        uint8x16_t const want = vorrq_u8(
+            vextq_u8(prev, esc, 15),
+            vextq_u8(prev, esc, 14));
+        if(vmaxvq_u8(vbicq_u8(
+                want, hexdig_neon(v))) != 0)
+            return false;
+        n += vaddvq_u8(vandq_u8(
+            esc, vdupq_n_u8(1)));
+        prev = esc;
+        p += 16;
+    }
+    need =
+        (vgetq_lane_u8(prev, 15) ? 3u : 0u) |
+        (vgetq_lane_u8(prev, 14) ? 1u : 0u);
+    return scan_scalar(p, last, need, n);
+}
+
+template<bool SpaceAsPlus>
+std::size_t
+decode_neon(
+    char* const dest0,
+    char const* end,
+    core::string_view s) noexcept
+{
+    char* dest = dest0;
+    char const* it = s.data();
+    char const* const last = it + s.size();
+    uint8x16_t const pct = vdupq_n_u8('%');
+    uint8x16_t const plus = vdupq_n_u8('+');
+    uint8x16_t const flip = vdupq_n_u8(0x0B);
+    while(
+        last - it >= 16 &&
+        end - dest >= 16)
+    {
+        uint8x16_t v = vld1q_u8(
+            reinterpret_cast<std::uint8_t const*>(it));
+        if(SpaceAsPlus)
+            v = veorq_u8(v, vandq_u8(
+                vceqq_u8(v, plus), flip));
+        vst1q_u8(reinterpret_cast<
+            std::uint8_t*>(dest), v);
+        std::uint64_t const esc =
+            movemask_neon(vceqq_u8(v, pct));
+        if(esc == 0)
+        {
+            it += 16;
+            dest += 16;
+            continue;
+        }
+        auto const k =
+            boost::core::countr_zero(esc) >> 2;
+        it += k;
+        dest += k;
+        // LCOV_EXCL_START
+        if(last - it < 3)
+            break;
+        // LCOV_EXCL_STOP
+        do
+        {
+            *dest++ = decode_one(it + 1);
+            it += 3;
+        }
+        while(
+            last - it >= 3 &&
+            *it == '%');
+    }
+    return decode_unsafe_impl<SpaceAsPlus>(
+        dest0, dest, end, it, last);
+}
+
+#endif
+
+//------------------------------------------------
+
+using scan_fn = bool(*)(
+    char const*, char const*,
+    unsigned, std::size_t&);
+
+using decode_fn = std::size_t(*)(
+    char*, char const*, core::string_view);
+
+// The kernels for the best isa
+// supported at runtime
+struct kernels
+{
+    scan_fn scan;
+    decode_fn decode;
+    decode_fn decode_plus;
+};
+
+kernels
+make_kernels() noexcept
+{
+    using grammar::detail::lut_isa;
+    switch(grammar::detail::lut_best_isa())
+    {
+#ifdef BOOST_URL_USE_SSE2
+    case lut_isa::avx2:
+        return { &scan_avx2,
+            &decode_avx2<false>,
+            &decode_avx2<true> };
+    case lut_isa::ssse3:
+    case lut_isa::scalar:
+        return { &scan_sse2,
+            &decode_sse2<false>,
+            &decode_sse2<true> };
+#endif
+#ifdef BOOST_URL_USE_NEON
+    case lut_isa::neon:
+        return { &scan_neon,
+            &decode_neon<false>,
+            &decode_neon<true> };
+#endif
+    default:
+        return { &scan_scalar,
+            &decode_scalar<false>,
+            &decode_scalar<true> };
+    }
+}
+
+kernels const&
+best_kernels() noexcept
+{
+    static kernels const k = make_kernels();
+    return k;
+}
+
+} // (anon)
+
+std::size_t
+decode_bytes_unsafe(
+    core::string_view s) noexcept
+{
+    if(s.size() >= min_block_size)
+    {
+        // every `%` starts an escape
+        // in a valid string
+        std::size_t n = 0;
+        if(best_kernels().scan(
+            s.data(), s.data() + s.size(), 0, n))
+            return s.size() - 2 * n;
+    }
+    auto p = s.begin();
+    auto const end = s.end();
+    std::size_t dn = 0;
+    if(s.size() >= 3)
+    {
+        auto const safe_end = end - 2;
+        while(p < safe_end)
+        {
+            if(*p != '%')
+                p += 1;
+            else
+                p += 3;
+            ++dn;
+        }
+    }
+    dn += end - p;
+    return dn;
+}
+
+bool
+validate_pct(
+    core::string_view s,
+    std::size_t& dn) noexcept
+{
+    std::size_t n = 0;
+    bool const ok =
+        s.size() >= min_block_size ?
+        best_kernels().scan(
+            s.data(), s.data() + s.size(), 0, n) :
+        scan_scalar(
+            s.data(), s.data() + s.size(), 0, n);
+    if(! ok)
+        return false;
+    dn = s.size() - 2 * n;
+    return true;
+}
+
 std::size_t
 decode_unsafe(
     char* const dest0,
@@ -138,12 +649,18 @@ decode_unsafe(
     core::string_view s,
     encoding_opts opt) noexcept
 {
-    if(opt.space_as_plus)
+    if(s.size() < min_block_size)
     {
-        return decode_unsafe_impl<true>(
+        if(opt.space_as_plus)
+            return decode_scalar<true>(
+                dest0, end, s);
+        return decode_scalar<false>(
             dest0, end, s);
     }
-    return decode_unsafe_impl<false>(
+    if(opt.space_as_plus)
+        return best_kernels().decode_plus(
+            dest0, end, s);
+    return best_kernels().decode(
         dest0, end, s);
 }
 
@@ -29,6 +29,14 @@ std::size_t
 decode_bytes_unsafe(
     core::string_view s) noexcept;
 
+// Return true and set dn to the decoded size
+// if each `%` in s begins a valid escape
+BOOST_URL_DECL
+bool
+validate_pct(
+    core::string_view s,
+    std::size_t& dn) noexcept;
+
 BOOST_URL_DECL
 std::size_t
 decode_unsafe(
@@ -17,6 +17,8 @@
 #include <boost/url/grammar/parse.hpp>
 #include <boost/url/grammar/tuple_rule.hpp>
 #include <boost/url/grammar/unsigned_rule.hpp>
+#include <cstring>
+#include <limits>
 
 namespace boost {
 namespace urls {
@@ -141,9 +143,9 @@ parse(format_parse_context& ctx)
 
 std::size_t
 formatter<core::string_view>::
-measure(
+bound(
     core::string_view str,
-    measure_context& ctx,
+    format_context& ctx,
     grammar::lut_chars const& cs) const
 {
     std::size_t w = width;
@@ -154,11 +156,11 @@ measure(
             width_idx, width_name, ctx.args(), w);
     }
 
-    std::size_t n = ctx.out();
+    // each char is at most escaped
+    std::size_t n = str.size() * 3;
     if (str.size() < w)
         n += measure_one(fill, cs) * (w - str.size());
-
-    return n + encoded_size(str, cs);
+    return n;
 }
 
 char*
@@ -353,33 +355,10 @@ parse(format_parse_context& ctx)
 
 std::size_t
 integer_formatter_impl::
-measure(
-    long long int v,
-    measure_context& ctx,
+bound(
+    format_context& ctx,
     grammar::lut_chars const& cs) const
 {
-    std::size_t dn = 0;
-    std::size_t n = 0;
-    if (v < 0)
-    {
-        dn += measure_one('-', cs);
-        ++n;
-        v *= -1;
-    }
-    else if (sign != '-')
-    {
-        dn += measure_one(sign, cs);
-        ++n;
-    }
-    do
-    {
-        int d = v % 10;
-        v /= 10;
-        dn += measure_one('0' + static_cast<char>(d), cs);
-        ++n;
-    }
-    while (v > 0);
-
     std::size_t w = width;
     if (width_idx != std::size_t(-1) ||
         !width_name.empty())
@@ -387,54 +366,16 @@ measure(
         get_width_from_args(
             width_idx, width_name, ctx.args(), w);
     }
-    if (w > n)
-    {
-        if (!zeros)
-            dn += measure_one(fill, cs) * (w - n);
-        else
-            dn += measure_one('0', cs) * (w - n);
-    }
-    return ctx.out() + dn;
-}
-
-std::size_t
-integer_formatter_impl::
-measure(
-    unsigned long long int v,
-    measure_context& ctx,
-    grammar::lut_chars const& cs) const
-{
-    std::size_t dn = 0;
-    std::size_t n = 0;
-    if (sign != '-')
-    {
-        dn += measure_one(sign, cs);
-        ++n;
-    }
-    do
-    {
-        int d = v % 10;
-        v /= 10;
-        dn += measure_one('0' + static_cast<char>(d), cs);
-        ++n;
-    }
-    while (v != 0);
 
-    std::size_t w = width;
-    if (width_idx != std::size_t(-1) ||
-        !width_name.empty())
-    {
-        get_width_from_args(
-            width_idx, width_name, ctx.args(), w);
-    }
-    if (w > n)
-    {
-        if (!zeros)
-            dn += measure_one(fill, cs) * (w - n);
-        else
-            dn += measure_one('0', cs) * (w - n);
-    }
-    return ctx.out() + dn;
+    // the sign and digits of the largest
+    // value, each at most escaped
+    std::size_t n = 3 * (std::numeric_limits<
+        unsigned long long int>::digits10 + 2);
+    if (!zeros)
+        n += measure_one(fill, cs) * w;
+    else
+        n += measure_one('0', cs) * w;
+    return n;
 }
 
 char*
@@ -642,6 +583,30 @@ grammar::lut_chars const& cs) const
     return out;
 }
 
+char*
+format_buffer::
+grow(
+    char* out,
+    std::size_t n)
+{
+    std::size_t const used = out - p_;
+    if (n <= cap_ - used)
+        return out;
+    if (n > std::size_t(-1) - used)
+        detail::throw_length_error();
+    // 50% growth policy
+    std::size_t new_cap = cap_ + cap_ / 2;
+    if (new_cap < used + n)
+        new_cap = used + n;
+    char* p = new char[new_cap];
+    std::memcpy(p, p_, used);
+    if (p_ != buf_)
+        delete[] p_;
+    p_ = p;
+    cap_ = new_cap;
+    return p_ + used;
+}
+
 } // detail
 } // urls
 } // boost
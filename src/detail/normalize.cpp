@@ -16,6 +16,7 @@
 #include <boost/url/grammar/ci_string.hpp>
 #include <boost/assert.hpp>
 #include <boost/core/ignore_unused.hpp>
+#include <cstdint>
 #include <cstring>
 #include "normalize.hpp"
 
@@ -74,16 +75,113 @@ compare_encoded(
     return 1;
 }
 
+namespace {
+
+// reverse the order of the bytes
+// in memory, whatever the endianness
+inline
+std::uint64_t
+reverse_bytes(std::uint64_t v) noexcept
+{
+    v = ((v & 0x00ff00ff00ff00ffULL) << 8) |
+        ((v >> 8) & 0x00ff00ff00ff00ffULL);
+    v = ((v & 0x0000ffff0000ffffULL) << 16) |
+        ((v >> 16) & 0x0000ffff0000ffffULL);
+    return (v << 32) | (v >> 32);
+}
+
+// collects single chars and passes
+// them to the hasher in chunks
+template<class Hasher>
+class chunk_writer
+{
+    Hasher& h_;
+    std::size_t n_ = 0;
+    char buf_[64];
+
+public:
+    explicit
+    chunk_writer(Hasher& h) noexcept
+        : h_(h)
+    {
+    }
+
+    void
+    put(char c) noexcept
+    {
+        if(n_ == sizeof(buf_))
+            flush();
+        buf_[n_++] = c;
+    }
+
+    // put the chars of s from last to first
+    void
+    put_reversed(core::string_view s) noexcept
+    {
+        auto const first = s.data();
+        auto p = first + s.size();
+        while(p != first)
+        {
+            if(n_ == sizeof(buf_))
+                flush();
+            std::size_t const m = (std::min)(
+                sizeof(buf_) - n_,
+                static_cast<std::size_t>(p - first));
+            char* out = buf_ + n_;
+            std::size_t i = 0;
+            for(; i + 8 <= m; i += 8)
+            {
+                p -= 8;
+                std::uint64_t v;
+                std::memcpy(&v, p, 8);
+                v = reverse_bytes(v);
+                std::memcpy(out + i, &v, 8);
+            }
+            for(; i < m; ++i)
+                out[i] = *--p;
+            n_ += m;
+        }
+    }
+
+    void
+    flush() noexcept
+    {
+        if(n_ == 0)
+            return;
+        h_.put(core::string_view(buf_, n_));
+        n_ = 0;
+    }
+};
+
+} // (anon)
+
+template<class Hasher>
 void
 digest_encoded(
     core::string_view s,
-    fnv_1a& hasher) noexcept
+    Hasher& hasher) noexcept
 {
-    char c = 0;
-    std::size_t n = 0;
+    // runs without escapes are
+    // passed through unchanged
     while(!s.empty())
     {
-        pop_encoded_front(s, c, n);
+        auto const p = static_cast<char const*>(
+            std::memchr(s.data(), '%', s.size()));
+        if(! p)
+        {
+            hasher.put(s);
+            return;
+        }
+        std::size_t const n = p - s.data();
+        if(n > 0)
+        {
+            hasher.put(s.substr(0, n));
+            s.remove_prefix(n);
+        }
+        char c = 0;
+        detail::decode_unsafe(
+            &c, &c + 1, s.substr(0, 3));
+        s.remove_prefix(3);
         hasher.put(c);
     }
 }
@@ -119,19 +217,39 @@ ci_compare_encoded(
     return 1;
 }
 
+template<class Hasher>
 void
 ci_digest_encoded(
     core::string_view s,
-    fnv_1a& hasher) noexcept
+    Hasher& hasher) noexcept
 {
-    char c = 0;
+    char buf[64];
     std::size_t n = 0;
-    while(!s.empty())
+    auto p = s.data();
+    auto const end = p + s.size();
+    while(p != end)
     {
-        pop_encoded_front(s, c, n);
-        c = grammar::to_lower(c);
-        hasher.put(c);
+        if(n == sizeof(buf))
+        {
+            hasher.put(core::string_view(buf, n));
+            n = 0;
+        }
+        char c = *p;
+        if(c != '%')
+        {
+            ++p;
+        }
+        else
+        {
+            detail::decode_unsafe(
+                &c, &c + 1,
+                core::string_view(p, 3));
+            p += 3;
+        }
+        buf[n++] = grammar::to_lower(c);
     }
+    if(n > 0)
+        hasher.put(core::string_view(buf, n));
 }
 
 int
@@ -178,15 +296,21 @@ ci_compare(
     return 1;
 }
 
+template<class Hasher>
 void
 ci_digest(
     core::string_view s,
-    fnv_1a& hasher) noexcept
+    Hasher& hasher) noexcept
 {
-    for (char c: s)
+    char buf[64];
+    while(! s.empty())
     {
-        c = grammar::to_lower(c);
-        hasher.put(c);
+        std::size_t const n = (std::min)(
+            sizeof(buf), s.size());
+        for(std::size_t i = 0; i < n; ++i)
+            buf[i] = grammar::to_lower(s[i]);
+        hasher.put(core::string_view(buf, n));
+        s.remove_prefix(n);
     }
 }
 
@@ -689,12 +813,87 @@ pop_last_segment(
     seg = {};
 }
 
+namespace {
+
+// return true if any segment of the path
+// could be "." or "..", that is, if any
+// segment starts with a dot
+bool
+has_dot_segment(
+    core::string_view s) noexcept
+{
+    auto const first = s.data();
+    auto const end = first + s.size();
+    auto p = first;
+    while(p != end)
+    {
+        p = static_cast<char const*>(
+            std::memchr(p, '.', end - p));
+        if(! p)
+            break;
+        if( p == first ||
+            p[-1] == '/')
+            return true;
+        ++p;
+    }
+    p = first;
+    while(p != end)
+    {
+        p = static_cast<char const*>(
+            std::memchr(p, '%', end - p));
+        if(! p)
+            break;
+        BOOST_ASSERT(end - p >= 3);
+        if( p[1] == '2' &&
+            (p[2] == 'E' || p[2] == 'e') &&
+            (p == first || p[-1] == '/'))
+            return true;
+        p += 3;
+    }
+    return false;
+}
+
+} // (anon)
+
+template<class Hasher>
 void
 normalized_path_digest(
     core::string_view str,
     bool remove_unmatched,
-    fnv_1a& hasher) noexcept
+    Hasher& hasher) noexcept
 {
+    chunk_writer<Hasher> w(hasher);
+    if(! has_dot_segment(str))
+    {
+        // without dot segments, the
+        // normalized path is the path
+        while (!str.empty())
+        {
+            auto const i = std::memchr(
+                str.data(), '%', str.size()) ?
+                    str.rfind('%') :
+                    core::string_view::npos;
+            if(i == core::string_view::npos)
+            {
+                w.put_reversed(str);
+                break;
+            }
+            w.put_reversed(str.substr(i + 3));
+            str.remove_suffix(str.size() - i - 3);
+            // an encoded '/' is kept
+            // as it is, like path_pop_back
+            char c = 0;
+            detail::decode_unsafe(
+                &c, &c + 1, str.substr(i));
+            if(c == '/')
+                w.put_reversed(str.substr(i));
+            else
+                w.put(c);
+            str.remove_suffix(3);
+        }
+        w.flush();
+        return;
+    }
     core::string_view seg;
     std::size_t level = 0;
     do
@@ -702,147 +901,201 @@ normalized_path_digest(
         pop_last_segment(
             str, seg, level, remove_unmatched);
         while (!seg.empty())
-        {
-            char c = path_pop_back(seg);
-            hasher.put(c);
-        }
+            w.put(path_pop_back(seg));
     }
     while (!str.empty());
+    w.flush();
 }
 
-// compare segments as if there were a normalized
-int
-segments_compare(
-    segments_encoded_view seg0,
-    segments_encoded_view seg1) noexcept
+#define BOOST_URL_INSTANTIATE_DIGEST(Hasher) \
+    template void digest_encoded<Hasher>( \
+        core::string_view, Hasher&) noexcept; \
+    template void ci_digest_encoded<Hasher>( \
+        core::string_view, Hasher&) noexcept; \
+    template void ci_digest<Hasher>( \
+        core::string_view, Hasher&) noexcept; \
+    template void normalized_path_digest<Hasher>( \
+        core::string_view, bool, Hasher&) noexcept;
+
+BOOST_URL_INSTANTIATE_DIGEST(fnv_1a)
+BOOST_URL_INSTANTIATE_DIGEST(block_hash)
+
+#undef BOOST_URL_INSTANTIATE_DIGEST
+
+namespace {
+
+// calculate path size as if it were normalized
+std::size_t
+normalized_size(
+    segments_encoded_view seg) noexcept
 {
-    // calculate path size as if it were normalized
-    auto normalized_size =
-        [](segments_encoded_view seg) -> std::size_t
-    {
-        if (seg.empty())
-            return seg.is_absolute();
+    if (seg.empty())
+        return seg.is_absolute();
 
-        std::size_t n = 0;
-        std::size_t skip = 0;
-        auto begin = seg.begin();
-        auto it = seg.end();
-        while (it != begin)
+    std::size_t n = 0;
+    std::size_t skip = 0;
+    auto begin = seg.begin();
+    auto it = seg.end();
+    while (it != begin)
+    {
+        --it;
+        decode_view dseg = **it;
+        if (dseg == "..")
+            ++skip;
+        else if (dseg != ".")
         {
-            --it;
-            decode_view dseg = **it;
-            if (dseg == "..")
-                ++skip;
-            else if (dseg != ".")
-            {
-                if (skip)
-                    --skip;
-                else
-                    n += dseg.size() + 1;
-            }
+            if (skip)
+                --skip;
+            else
+                n += dseg.size() + 1;
         }
-        n += skip * 3;
+    }
+    n += skip * 3;
+    // a relative path which normalizes
+    // to nothing has no leading slash
+    // to remove
+    if (n > 0)
         n -= !seg.is_absolute();
-        return n;
-    };
+    return n;
+}
 
-    // find the normalized size for the comparison
-    std::size_t n0 = normalized_size(seg0);
-    std::size_t n1 = normalized_size(seg1);
-    std::size_t n00 = n0;
-    std::size_t n10 = n1;
+// consume the last char from a segment range
+char
+consume_last(
+    std::size_t& n,
+    decode_view& dseg,
+    segments_encoded_view::iterator& begin,
+    segments_encoded_view::iterator& it,
+    decode_view::iterator& cit,
+    std::size_t& skip,
+    bool& at_slash) noexcept
+{
+    if (cit != dseg.begin())
+    {
+        // return last char from current segment
+        at_slash = false;
+        --cit;
+        --n;
+        return *cit;
+    }
 
-    // consume the last char from a segment range
-    auto consume_last =
-        [](
-            std::size_t& n,
-            decode_view& dseg,
-            segments_encoded_view::iterator& begin,
-            segments_encoded_view::iterator& it,
-            decode_view::iterator& cit,
-            std::size_t& skip,
-            bool& at_slash) -> char
-    {
-        if (cit != dseg.begin())
-        {
-            // return last char from current segment
-            at_slash = false;
-            --cit;
-            --n;
-            return *cit;
-        }
+    if (!at_slash)
+    {
+        // current segment dseg is over and
+        // previous char was not a slash
+        // so we output one
+        at_slash = true;
+        --n;
+        return '/';
+    }
 
-        if (!at_slash)
+    // current segment dseg is over and
+    // last char was already the slash
+    // between segments, so take the
+    // next final segment to consume
+    at_slash = false;
+    while (cit == dseg.begin())
+    {
+        // take next segment
+        if (it != begin)
+            --it;
+        else
+            break;
+        if (**it == "..")
         {
-            // current segment dseg is over and
-            // previous char was not a slash
-            // so we output one
-            at_slash = true;
-            --n;
-            return '/';
+            // skip next if this is ".."
+            ++skip;
         }
-
-        // current segment dseg is over and
-        // last char was already the slash
-        // between segments, so take the
-        // next final segment to consume
-        at_slash = false;
-        while (cit == dseg.begin())
+        else if (**it != ".")
         {
-            // take next segment
-            if (it != begin)
-                --it;
-            else
-                break;
-            if (**it == "..")
+            if (skip)
             {
-                // skip next if this is ".."
-                ++skip;
+                // discount skips
+                --skip;
             }
-            else if (**it != ".")
+            else
             {
-                if (skip)
-                {
-                    // discount skips
-                    --skip;
-                }
-                else
-                {
-                    // or update current seg
-                    dseg = **it;
-                    cit = dseg.end();
-                    break;
-                }
+                // or update current seg
+                dseg = **it;
+                cit = dseg.end();
+                break;
             }
         }
-        // consume from the new current
-        // segment
-        --n;
-        if (cit != dseg.begin())
-        {
-            // in the general case, we consume
-            // one more character from the end
-            --cit;
-            return *cit;
-        }
+    }
+    // consume from the new current
+    // segment
+    --n;
+    if (cit != dseg.begin())
+    {
+        // in the general case, we consume
+        // one more character from the end
+        --cit;
+        return *cit;
+    }
 
-        // nothing left to consume in the
-        // current and new segment
-        if (it == begin)
-        {
-            // if this is the first
-            // segment, the segments are
-            // over and there can only
-            // be repetitions of "../" to
-            // output
-            return "/.."[n % 3];
-        }
-        // at other segments, we need
-        // a slash to transition to the
-        // next segment
-        at_slash = true;
-        return '/';
-    };
+    // nothing left to consume in the
+    // current and new segment
+    if (it == begin)
+    {
+        // if this is the first
+        // segment, the segments are
+        // over and there can only
+        // be repetitions of "../" to
+        // output
+        return "/.."[n % 3];
+    }
+    // at other segments, we need
+    // a slash to transition to the
+    // next segment
+    at_slash = true;
+    return '/';
+}
+
+} // (anon)
+
+std::size_t
+segments_normalized_size(
+    segments_encoded_view seg) noexcept
+{
+    return normalized_size(seg);
+}
+
+void
+segments_normalized(
+    segments_encoded_view seg,
+    char* dest) noexcept
+{
+    std::size_t n = normalized_size(seg);
+    auto begin = seg.begin();
+    auto it = seg.end();
+    decode_view dseg;
+    if (it != begin)
+    {
+        --it;
+        dseg = **it;
+    }
+    decode_view::iterator cit = dseg.end();
+    std::size_t skip = 0;
+    bool at_slash = true;
+    while (n)
+    {
+        char const c = consume_last(
+            n, dseg, begin, it, cit, skip, at_slash);
+        dest[n] = c;
+    }
+}
+
+// compare segments as if there were a normalized
+int
+segments_compare(
+    segments_encoded_view seg0,
+    segments_encoded_view seg1) noexcept
+{
+    // find the normalized size for the comparison
+    std::size_t n0 = normalized_size(seg0);
+    std::size_t n1 = normalized_size(seg1);
+    std::size_t n00 = n0;
+    std::size_t n10 = n1;
 
     // consume final segments from seg0 that
     // should not influence the comparison
@@ -13,6 +13,12 @@
 
 #include <boost/core/detail/string_view.hpp>
 #include "boost/url/segments_encoded_view.hpp"
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 namespace boost {
 namespace urls {
@@ -67,6 +73,163 @@ private:
     std::size_t h_;
 };
 
+// A streaming hash which consumes its input
+// in blocks of 16 bytes, mixing each block
+// with a 64x64->128 bit multiplication, in
+// the manner of wyhash. The result depends
+// only on the bytes and not on how they are
+// split between calls to put.
+class block_hash
+{
+public:
+    using digest_type = std::size_t;
+
+    explicit
+    block_hash(std::size_t salt) noexcept
+        : h_(static_cast<
+            std::uint64_t>(salt) ^ k0)
+    {
+    }
+
+    void
+    put(char c) noexcept
+    {
+        buf_[len_++] = static_cast<
+            unsigned char>(c);
+        if(len_ == sizeof(buf_))
+            flush();
+    }
+
+    void
+    put(core::string_view s) noexcept
+    {
+        auto p = reinterpret_cast<
+            unsigned char const*>(s.data());
+        std::size_t n = s.size();
+        if(len_ > 0)
+        {
+            std::size_t const m = (std::min)(
+                sizeof(buf_) - len_, n);
+            std::memcpy(buf_ + len_, p, m);
+            len_ += m;
+            p += m;
+            n -= m;
+            if(len_ < sizeof(buf_))
+                return;
+            flush();
+        }
+        while(n >= sizeof(buf_))
+        {
+            block(p);
+            p += sizeof(buf_);
+            n -= sizeof(buf_);
+        }
+        if(n > 0)
+            std::memcpy(buf_, p, n);
+        len_ = n;
+    }
+
+    digest_type
+    digest() const noexcept
+    {
+        // the unused part of
+        // buf_ is always zero
+        std::uint64_t h = mix(
+            read(buf_) ^ k1 ^ h_,
+            read(buf_ + 8) ^ h_ ^ k2);
+        h = mix(h ^ k2, (n_ + len_) ^ k3);
+#if BOOST_URL_ARCH == 64
+        return static_cast<digest_type>(h);
+#else
+        return static_cast<digest_type>(
+            h ^ (h >> 32));
+#endif
+    }
+
+private:
+    static constexpr std::uint64_t k0 =
+        0xa0761d6478bd642fULL;
+    static constexpr std::uint64_t k1 =
+        0xe7037ed1a0b428dbULL;
+    static constexpr std::uint64_t k2 =
+        0x8ebc6af09c88c6e3ULL;
+    static constexpr std::uint64_t k3 =
+        0x589965cc75374cc3ULL;
+
+    static
+    std::uint64_t
+    read(unsigned char const* p) noexcept
+    {
+        std::uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    // fold the 128-bit product
+    static
+    std::uint64_t
+    mix(
+        std::uint64_t a,
+        std::uint64_t b) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ using u128 = unsigned __int128;
+        u128 const r = static_cast<u128>(a) * b;
+        return static_cast<std::uint64_t>(r) ^
+            static_cast<std::uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        std::uint64_t hi;
+        std::uint64_t const lo =
+            _umul128(a, b, &hi);
+        return lo ^ hi;
+#else
+        std::uint64_t const a0 = a & 0xffffffff;
+        std::uint64_t const a1 = a >> 32;
+        std::uint64_t const b0 = b & 0xffffffff;
+        std::uint64_t const b1 = b >> 32;
+        std::uint64_t const p00 = a0 * b0;
+        std::uint64_t const p01 = a0 * b1;
+        std::uint64_t const p10 = a1 * b0;
+        std::uint64_t const p11 = a1 * b1;
+        std::uint64_t const mid =
+            (p00 >> 32) + (p01 & 0xffffffff) +
+            (p10 & 0xffffffff);
+        std::uint64_t const lo =
+            (mid << 32) | (p00 & 0xffffffff);
+        std::uint64_t const hi = p11 +
+            (p01 >> 32) + (p10 >> 32) +
+            (mid >> 32);
+        return lo ^ hi;
+#endif
+    }
+
+    // the state goes into both operands,
+    // or a block whose first half equals
+    // k1 would zero the product and erase
+    // the salt and all earlier input
+    void
+    block(unsigned char const* p) noexcept
+    {
+        h_ = mix(
+            read(p) ^ k1 ^ h_,
+            read(p + 8) ^ h_ ^ k2);
+        n_ += sizeof(buf_);
+    }
+
+    void
+    flush() noexcept
+    {
+        block(buf_);
+        std::memset(buf_, 0, sizeof(buf_));
+        len_ = 0;
+    }
+
+    std::uint64_t h_;
+    std::uint64_t n_ = 0;
+    std::size_t len_ = 0;
+    unsigned char buf_[16] = {};
+};
+
 void
 pop_encoded_front(
     core::string_view& s,
@@ -82,15 +245,11 @@ compare_encoded(
 
 // digest a core::string_view as if it were
 // percent-decoded
+template<class Hasher>
 void
 digest_encoded(
     core::string_view s,
-    fnv_1a& hasher) noexcept;
-
-void
-digest(
-    core::string_view s,
-    fnv_1a& hasher) noexcept;
+    Hasher& hasher) noexcept;
 
 // check if core::string_view lhs starts with core::string_view
 // rhs as if they are both percent-decoded. If
@@ -119,10 +278,11 @@ ci_compare_encoded(
 
 // digest a core::string_view as if it were decoded
 // and lowercase
+template<class Hasher>
 void
 ci_digest_encoded(
     core::string_view s,
-    fnv_1a& hasher) noexcept;
+    Hasher& hasher) noexcept;
 
 // compare two ascii core::string_views
 int
@@ -138,10 +298,11 @@ ci_compare(
     core::string_view rhs) noexcept;
 
 // digest a core::string_view as if it were lowercase
+template<class Hasher>
 void
 ci_digest(
     core::string_view s,
-    fnv_1a& hasher) noexcept;
+    Hasher& hasher) noexcept;
 
 BOOST_URL_DECL
 std::size_t
@@ -160,17 +321,33 @@ pop_last_segment(
 char
 path_pop_back( core::string_view& s );
 
+template<class Hasher>
 void
 normalized_path_digest(
     core::string_view str,
     bool remove_unmatched,
-    fnv_1a& hasher) noexcept;
+    Hasher& hasher) noexcept;
 
 int
 segments_compare(
     segments_encoded_view seg0,
     segments_encoded_view seg1) noexcept;
 
+// return the size of the path as
+// it is seen by segments_compare
+std::size_t
+segments_normalized_size(
+    segments_encoded_view seg) noexcept;
+
+// write the path as it is seen by
+// segments_compare. dest must have
+// room for segments_normalized_size
+// chars.
+void
+segments_normalized(
+    segments_encoded_view seg,
+    char* dest) noexcept;
+
 } // detail
 } // urls
 } // boost
@@ -10,6 +10,8 @@
 
 #include <boost/url/detail/config.hpp>
 #include "pattern.hpp"
+#include <boost/url/compiled_format.hpp>
+#include <boost/url/url.hpp>
 #include "pct_format.hpp"
 #include "boost/url/detail/replacement_field_rule.hpp"
 #include <boost/url/grammar/alpha_chars.hpp>
@@ -20,6 +22,7 @@
 #include "boost/url/rfc/detail/path_rules.hpp"
 #include "../rfc/detail/port_rule.hpp"
 #include "../rfc/detail/scheme_rule.hpp"
+#include <cstring>
 
 namespace boost {
 namespace urls {
@@ -33,124 +36,146 @@ apply(
     url_base& u,
     format_args const& args) const
 {
-    // measure total
-    struct sizes
+    // format every component into the
+    // buffer, encoding each argument once
+    struct formatted
     {
-        std::size_t scheme = 0;
-        std::size_t user = 0;
-        std::size_t pass = 0;
-        std::size_t host = 0;
-        std::size_t port = 0;
-        std::size_t path = 0;
-        std::size_t query = 0;
-        std::size_t frag = 0;
+        std::size_t pos = 0;
+        std::size_t n = 0;
+    };
+    struct components
+    {
+        formatted scheme;
+        formatted user;
+        formatted pass;
+        formatted host;
+        formatted port;
+        formatted path;
+        formatted query;
+        formatted frag;
+    };
+    components n;
+
+    // use the pieces of a compiled
+    // format when there are any
+    using parts = parts_base;
+    format_buffer buf;
+    format_context fctx(buf, args);
+    auto const vformat = [this, &buf, &fctx](
+        int id,
+        grammar::lut_chars const& cs,
+        format_parse_context& pctx) -> formatted
+    {
+        formatted p;
+        p.pos = fctx.out() - buf.data();
+        if (pieces)
+            pct_vformat(cs,
+                pieces + first[id + 1],
+                pieces + first[id + 2],
+                pctx, fctx);
+        else
+            pct_vformat(cs, pctx, fctx);
+        p.n = fctx.out() - buf.data() - p.pos;
+        return p;
     };
-    sizes n;
 
     format_parse_context pctx(nullptr, nullptr, 0);
-    measure_context mctx(args);
     if (!scheme.empty())
     {
         pctx = {scheme, pctx.next_arg_id()};
-        n.scheme = pct_vmeasure(
-            grammar::alpha_chars, pctx, mctx);
-        mctx.advance_to(0);
+        n.scheme = vformat(parts::id_scheme,
+            grammar::alpha_chars, pctx);
     }
     if (has_authority)
     {
         if (has_user)
         {
             pctx = {user, pctx.next_arg_id()};
-            n.user = pct_vmeasure(
-                user_chars, pctx, mctx);
-            mctx.advance_to(0);
+            n.user = vformat(parts::id_user,
+                user_chars, pctx);
             if (has_pass)
             {
                 pctx = {pass, pctx.next_arg_id()};
-                n.pass = pct_vmeasure(
-                    password_chars, pctx, mctx);
-                mctx.advance_to(0);
+                n.pass = vformat(parts::id_pass,
+                    password_chars, pctx);
             }
         }
         if (host.starts_with('['))
         {
             BOOST_ASSERT(host.ends_with(']'));
             pctx = {host.substr(1, host.size() - 2), pctx.next_arg_id()};
-            n.host = pct_vmeasure(
-                lhost_chars, pctx, mctx) + 2;
-            mctx.advance_to(0);
+            n.host = vformat(parts::id_host,
+                lhost_chars, pctx);
         }
         else
         {
             pctx = {host, pctx.next_arg_id()};
-            n.host = pct_vmeasure(
-                host_chars, pctx, mctx);
-            mctx.advance_to(0);
+            n.host = vformat(parts::id_host,
+                host_chars, pctx);
         }
         if (has_port)
         {
             pctx = {port, pctx.next_arg_id()};
-            n.port = pct_vmeasure(
-                grammar::digit_chars, pctx, mctx);
-            mctx.advance_to(0);
+            n.port = vformat(parts::id_port,
+                grammar::digit_chars, pctx);
         }
     }
     if (!path.empty())
     {
         pctx = {path, pctx.next_arg_id()};
-        n.path = pct_vmeasure(
-            path_chars, pctx, mctx);
-        mctx.advance_to(0);
+        n.path = vformat(parts::id_path,
+            path_chars, pctx);
     }
     if (has_query)
     {
         pctx = {query, pctx.next_arg_id()};
-        n.query = pct_vmeasure(
-            query_chars, pctx, mctx);
-        mctx.advance_to(0);
+        n.query = vformat(parts::id_query,
+            query_chars, pctx);
     }
     if (has_frag)
     {
         pctx = {frag, pctx.next_arg_id()};
-        n.frag = pct_vmeasure(
-            fragment_chars, pctx, mctx);
-        mctx.advance_to(0);
+        n.frag = vformat(parts::id_frag,
+            fragment_chars, pctx);
     }
+    bool const host_ip_literal =
+        host.starts_with('[');
     std::size_t const n_total =
-        n.scheme +
-        (n.scheme != 0) * 1 + // ":"
-        has_authority * 2 +   // "//"
-        n.user +
-        has_pass * 1 +        // ":"
-        n.pass +
-        has_user * 1 +        // "@"
-        n.host +
-        has_port * 1 +        // ":"
-        n.port +
-        n.path +
-        has_query * 1 +       // "?"
-        n.query +
-        has_frag * 1 +        // "#"
-        n.frag;
+        n.scheme.n +
+        (n.scheme.n != 0) * 1 + // ":"
+        has_authority * 2 +     // "//"
+        n.user.n +
+        has_pass * 1 +          // ":"
+        n.pass.n +
+        has_user * 1 +          // "@"
+        n.host.n +
+        host_ip_literal * 2 +   // "[]"
+        has_port * 1 +          // ":"
+        n.port.n +
+        n.path.n +
+        has_query * 1 +         // "?"
+        n.query.n +
+        has_frag * 1 +          // "#"
+        n.frag.n;
     u.reserve(n_total);
+    // the components below assume an empty
+    // url. Clear it only once the reserve
+    // succeeded, so a length error leaves
+    // u untouched.
+    u.clear();
 
     // Apply
-    pctx = {nullptr, nullptr, 0};
-    format_context fctx(nullptr, args);
+    char const* const src = buf.data();
     url_base::op_t op(u);
-    using parts = parts_base;
     if (!scheme.empty())
     {
         auto dest = u.resize_impl(
             parts::id_scheme,
-            n.scheme + 1, op);
-        pctx = {scheme, pctx.next_arg_id()};
-        fctx.advance_to(dest);
-        const char* dest1 = pct_vformat(
-            grammar::alpha_chars, pctx, fctx);
-        dest[n.scheme] = ':';
+            n.scheme.n + 1, op);
+        std::memcpy(dest, src + n.scheme.pos, n.scheme.n);
+        dest[n.scheme.n] = ':';
         // validate
-        if (!grammar::parse({dest, dest1}, scheme_rule()))
+        if (!grammar::parse({dest, n.scheme.n}, scheme_rule()))
         {
             throw_invalid_argument();
         }
@@ -160,50 +185,37 @@ apply(
         if (has_user)
         {
             auto dest = u.set_user_impl(
-                n.user, op);
-            pctx = {user, pctx.next_arg_id()};
-            fctx.advance_to(dest);
-            char const* dest1 = pct_vformat(
-                user_chars, pctx, fctx);
+                n.user.n, op);
+            std::memcpy(dest, src + n.user.pos, n.user.n);
             u.impl_.decoded_[parts::id_user] =
-                pct_string_view(dest, dest1 - dest)
+                pct_string_view(dest, n.user.n)
                     ->decoded_size();
             if (has_pass)
             {
                 char* destp = u.set_password_impl(
-                    n.pass, op);
-                pctx = {pass, pctx.next_arg_id()};
-                fctx.advance_to(destp);
-                dest1 = pct_vformat(
-                    password_chars, pctx, fctx);
+                    n.pass.n, op);
+                std::memcpy(destp, src + n.pass.pos, n.pass.n);
                 u.impl_.decoded_[parts::id_pass] =
-                    pct_string_view({destp, dest1})
+                    pct_string_view(destp, n.pass.n)
                         ->decoded_size() + 1;
             }
         }
         auto dest = u.set_host_impl(
-            n.host, op);
-        if (host.starts_with('['))
+            n.host.n + host_ip_literal * 2, op);
+        if (host_ip_literal)
         {
-            BOOST_ASSERT(host.ends_with(']'));
-            pctx = {host.substr(1, host.size() - 2), pctx.next_arg_id()};
             *dest++ = '[';
-            fctx.advance_to(dest);
-            char* dest1 =
-                pct_vformat(lhost_chars, pctx, fctx);
-            *dest1++ = ']';
+            std::memcpy(dest, src + n.host.pos, n.host.n);
+            dest[n.host.n] = ']';
             u.impl_.decoded_[parts::id_host] =
-                pct_string_view(dest - 1, dest1 - dest)
+                pct_string_view(dest - 1, n.host.n + 1)
                     ->decoded_size();
         }
         else
         {
-            pctx = {host, pctx.next_arg_id()};
-            fctx.advance_to(dest);
-            char const* dest1 =
-                pct_vformat(host_chars, pctx, fctx);
+            std::memcpy(dest, src + n.host.pos, n.host.n);
             u.impl_.decoded_[parts::id_host] =
-                pct_string_view(dest, dest1 - dest)
+                pct_string_view(dest, n.host.n)
                     ->decoded_size();
         }
         auto uh = u.encoded_host();
@@ -215,15 +227,12 @@ apply(
         u.impl_.host_type_ = h.host_type;
         if (has_port)
         {
-            dest = u.set_port_impl(n.port, op);
-            pctx = {port, pctx.next_arg_id()};
-            fctx.advance_to(dest);
-            char const* dest1 = pct_vformat(
-                grammar::digit_chars, pctx, fctx);
+            dest = u.set_port_impl(n.port.n, op);
+            std::memcpy(dest, src + n.port.pos, n.port.n);
             u.impl_.decoded_[parts::id_port] =
-                pct_string_view(dest, dest1 - dest)
+                pct_string_view(dest, n.port.n)
                     ->decoded_size() + 1;
-            core::string_view up = {dest - 1, dest1};
+            core::string_view up = {dest - 1, n.port.n + 1};
             auto p = grammar::parse(up, detail::port_part_rule).value();
             if (p.has_port)
                 u.impl_.port_number_ = p.port_number;
@@ -233,12 +242,9 @@ apply(
     {
         auto dest = u.resize_impl(
             parts::id_path,
-            n.path, op);
-        pctx = {path, pctx.next_arg_id()};
-        fctx.advance_to(dest);
-        auto dest1 = pct_vformat(
-            path_chars, pctx, fctx);
-        pct_string_view npath(dest, dest1 - dest);
+            n.path.n, op);
+        std::memcpy(dest, src + n.path.pos, n.path.n);
+        pct_string_view npath(dest, n.path.n);
         u.impl_.decoded_[parts::id_path] +=
             npath.decoded_size();
         if (!npath.empty())
@@ -264,9 +270,9 @@ apply(
                 u.reserve(n_total + diff);
                 dest = u.resize_impl(
                     parts::id_path,
-                    n.path + diff, op);
+                    n.path.n + diff, op);
                 char* dest0 = dest + diff;
-                std::memmove(dest0, dest, n.path);
+                std::memmove(dest0, dest, n.path.n);
                 while (dest0 != dest)
                 {
                     if (*dest0 != ':')
@@ -291,8 +297,8 @@ apply(
             u.reserve(n_total + 2);
             dest = u.resize_impl(
                 parts::id_path,
-                n.path + 2, op);
-            std::memmove(dest + 2, dest, n.path);
+                n.path.n + 2, op);
+            std::memmove(dest + 2, dest, n.path.n);
             *dest++ = '/';
             *dest = '.';
         }
@@ -301,39 +307,45 @@ apply(
     {
         auto dest = u.resize_impl(
             parts::id_query,
-            n.query + 1, op);
+            n.query.n + 1, op);
         *dest++ = '?';
-        pctx = {query, pctx.next_arg_id()};
-        fctx.advance_to(dest);
-        auto dest1 = pct_vformat(
-            query_chars, pctx, fctx);
-        pct_string_view nquery(dest, dest1 - dest);
+        std::memcpy(dest, src + n.query.pos, n.query.n);
+        pct_string_view nquery(dest, n.query.n);
         u.impl_.decoded_[parts::id_query] +=
             nquery.decoded_size() + 1;
-        if (!nquery.empty())
-        {
-            u.impl_.nparam_ = std::count(
-                nquery.begin(),
-                nquery.end(), '&') + 1;
-        }
+        // "?" alone is one empty param
+        u.impl_.nparam_ = std::count(
+            nquery.begin(),
+            nquery.end(), '&') + 1;
     }
     if (has_frag)
     {
         auto dest = u.resize_impl(
             parts::id_frag,
-            n.frag + 1, op);
+            n.frag.n + 1, op);
         *dest++ = '#';
-        pctx = {frag, pctx.next_arg_id()};
-        fctx.advance_to(dest);
-        auto dest1 = pct_vformat(
-            fragment_chars, pctx, fctx);
+        std::memcpy(dest, src + n.frag.pos, n.frag.n);
         u.impl_.decoded_[parts::id_frag] +=
             make_pct_string_view(
-                core::string_view(dest, dest1 - dest))
+                core::string_view(dest, n.frag.n))
                 ->decoded_size() + 1;
     }
 }
 
+void
+pattern::
+assign(
+    url_base& u,
+    format_args const& args) const
+{
+    // apply only modifies u after its
+    // reserve, and can still throw for an
+    // invalid scheme or host afterwards
+    url tmp;
+    apply(tmp, args);
+    u.copy(tmp);
+}
+
 // This rule represents a pct-encoded string
 // that contains an arbitrary number of
 // replacement ids in it
@@ -941,6 +953,75 @@ parse_pattern(
         s, pattern_rule);
 }
 
+void
+compile_pattern(
+    pattern const& p,
+    std::vector<format_piece>& v,
+    std::size_t* first)
+{
+    // same components and charsets
+    // as pattern::apply
+    using parts = parts_base;
+    first[parts::id_scheme + 1] = v.size();
+    pct_vcompile(grammar::alpha_chars, p.scheme, v);
+    first[parts::id_user + 1] = v.size();
+    if (p.has_authority && p.has_user)
+        pct_vcompile(user_chars, p.user, v);
+    first[parts::id_pass + 1] = v.size();
+    if (p.has_authority && p.has_pass)
+        pct_vcompile(password_chars, p.pass, v);
+    first[parts::id_host + 1] = v.size();
+    if (p.has_authority)
+    {
+        if (p.host.starts_with('['))
+            pct_vcompile(lhost_chars,
+                p.host.substr(1, p.host.size() - 2), v);
+        else
+            pct_vcompile(host_chars, p.host, v);
+    }
+    first[parts::id_port + 1] = v.size();
+    if (p.has_authority && p.has_port)
+        pct_vcompile(grammar::digit_chars, p.port, v);
+    first[parts::id_path + 1] = v.size();
+    pct_vcompile(path_chars, p.path, v);
+    first[parts::id_query + 1] = v.size();
+    if (p.has_query)
+        pct_vcompile(query_chars, p.query, v);
+    first[parts::id_frag + 1] = v.size();
+    if (p.has_frag)
+        pct_vcompile(fragment_chars, p.frag, v);
+    first[parts::id_end + 1] = v.size();
+}
+
+pattern::
+pattern(
+    compiled_format const& f) noexcept
+    : pieces(f.pieces_.data())
+    , first(f.first_)
+{
+    using parts = parts_base;
+    auto const get = [&f](int id)
+    {
+        return core::string_view(
+            f.s_.data() + f.pos_[id + 1],
+            f.len_[id + 1]);
+    };
+    scheme = get(parts::id_scheme);
+    user = get(parts::id_user);
+    pass = get(parts::id_pass);
+    host = get(parts::id_host);
+    port = get(parts::id_port);
+    path = get(parts::id_path);
+    query = get(parts::id_query);
+    frag = get(parts::id_frag);
+    has_authority = f.has_authority_;
+    has_user = f.has_user_;
+    has_pass = f.has_pass_;
+    has_port = f.has_port_;
+    has_query = f.has_query_;
+    has_frag = f.has_frag_;
+}
+
 } // detail
 } // urls
 } // boost
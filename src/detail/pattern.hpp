@@ -13,15 +13,20 @@
 #include "boost/url/error_types.hpp"
 #include "boost/url/url_base.hpp"
 #include <boost/core/detail/string_view.hpp>
+#include <vector>
 
 // This file includes functions and classes
 // to parse uri templates or format strings
 
 namespace boost {
 namespace urls {
+
+class compiled_format;
+
 namespace detail {
 
 class format_args;
+struct format_piece;
 
 /* Stores the URL component patterns extracted by `urls::format`.
 
@@ -30,6 +35,9 @@ class format_args;
 
    `pattern::apply` sets all components of an `url_base`
     by applying `args` to each pattern.
+
+   `pattern::assign` does the same through a temporary
+    url, so the `url_base` is unchanged if this throws.
  */
 struct pattern
 {
@@ -49,11 +57,30 @@ struct pattern
     bool has_query = false;
     bool has_frag = false;
 
+    // The pre-split pieces of each component,
+    // when the pattern comes from a compiled
+    // format. Component id has the pieces
+    // [pieces + first[id + 1], pieces + first[id + 2])
+    format_piece const* pieces = nullptr;
+    std::size_t const* first = nullptr;
+
+    pattern() = default;
+
+    BOOST_URL_DECL
+    explicit
+    pattern(compiled_format const& f) noexcept;
+
     BOOST_URL_DECL
     void
     apply(
         url_base& u,
         format_args const& args) const;
+
+    BOOST_URL_DECL
+    void
+    assign(
+        url_base& u,
+        format_args const& args) const;
 };
 
 BOOST_URL_DECL
@@ -61,6 +88,15 @@ system::result<pattern>
 parse_pattern(
     core::string_view s);
 
+// split each component of the pattern
+// into pieces, appending them to v
+BOOST_URL_DECL
+void
+compile_pattern(
+    pattern const& p,
+    std::vector<format_piece>& v,
+    std::size_t* first);
+
 } // detail
 } // url
 } // boost
@@ -12,16 +12,17 @@
 #include "pct_format.hpp"
 #include <boost/url/grammar/parse.hpp>
 #include <boost/url/grammar/unsigned_rule.hpp>
+#include <cstring>
 
 namespace boost {
 namespace urls {
 namespace detail {
 
-std::size_t
-pct_vmeasure(
+char*
+pct_vformat(
     grammar::lut_chars const& cs,
     format_parse_context& pctx,
-    measure_context& mctx)
+    format_context& fctx)
 {
     auto it0 = pctx.begin();
     auto end = pctx.end();
@@ -39,8 +40,13 @@ pct_vmeasure(
         // output literal prefix
         if( it0 != it1 )
         {
+            fctx.grow((it1 - it0) * 3);
             for (char const* i = it0; i != it1; ++i)
-                mctx.advance_to( mctx.out() + measure_one(*i, cs));
+            {
+                char* o = fctx.out();
+                encode_one(o, *i, cs);
+                fctx.advance_to(o);
+            }
         }
 
         // over
@@ -60,7 +66,9 @@ pct_vmeasure(
         /*
         if( *it1 == '{' )
         {
-            mctx.advance_to( mctx.out() + measure_one('{', cs));
+            char* o = fctx.out();
+            encode_one(o, '{', cs);
+            fctx.advance_to(o);
             ++it1;
             // this was not a real replacement,
             // so we just keep moving
@@ -68,7 +76,6 @@ pct_vmeasure(
         }
         */
 
-
         // parse {id} or {id:specs}
         char const* id_start = it1;
         while (it1 != end &&
@@ -79,7 +86,7 @@ pct_vmeasure(
         }
         core::string_view id(id_start, it1);
 
-        // move to specs start
+        // move to specs part
         if (it1 != end &&
             *it1 == ':')
             ++it1;
@@ -90,35 +97,35 @@ pct_vmeasure(
             id, grammar::unsigned_rule<std::size_t>{});
         if (idv)
         {
-            mctx.arg( *idv ).measure( pctx, mctx, cs );
+            fctx.arg( *idv ).format( pctx, fctx, cs );
         }
         else if (!id.empty())
         {
-            mctx.arg( id ).measure( pctx, mctx, cs );
+            fctx.arg( id ).format( pctx, fctx, cs );
         }
         else
         {
             std::size_t arg_id = pctx.next_arg_id();
-            mctx.arg( arg_id ).measure( pctx, mctx, cs );
+            fctx.arg( arg_id ).format( pctx, fctx, cs );
         }
 
-
         it1 = pctx.begin();
         BOOST_ASSERT(*it1 == '}');
         it0 = it1 + 1;
     }
 
-    return mctx.out();
+    return fctx.out();
 }
 
-char*
-pct_vformat(
+void
+pct_vcompile(
     grammar::lut_chars const& cs,
-    format_parse_context& pctx,
-    format_context& fctx)
+    core::string_view s,
+    std::vector<format_piece>& v)
 {
-    auto it0 = pctx.begin();
-    auto end = pctx.end();
+    char const* const base = s.data();
+    auto it0 = s.begin();
+    auto end = s.end();
     while( it0 != end )
     {
         // look for replacement id
@@ -130,15 +137,16 @@ pct_vformat(
             ++it1;
         }
 
-        // output literal prefix
+        // literal prefix
         if( it0 != it1 )
         {
+            format_piece p;
+            p.kind = format_piece::literal;
+            p.pos = it0 - base;
+            p.n = it1 - it0;
             for (char const* i = it0; i != it1; ++i)
-            {
-                char* o = fctx.out();
-                encode_one(o, *i, cs);
-                fctx.advance_to(o);
-            }
+                p.value += measure_one(*i, cs);
+            v.push_back(p);
         }
 
         // over
@@ -150,23 +158,7 @@ pct_vformat(
         // enter replacement id
         ++it1;
         BOOST_ASSERT(it1 != end);
-
-        // handle escaped replacement (second '{')
-        // there's no "{{" in URL templates because
-        // '{'s are not allowed in URLs
         BOOST_ASSERT(*it1 != '{');
-        /*
-        if( *it1 == '{' )
-        {
-            char* o = fctx.out();
-            encode_one(o, '{', cs);
-            fctx.advance_to(o);
-            ++it1;
-            // this was not a real replacement,
-            // so we just keep moving
-            continue;
-        }
-        */
 
         // parse {id} or {id:specs}
         char const* id_start = it1;
@@ -178,34 +170,101 @@ pct_vformat(
         }
         core::string_view id(id_start, it1);
 
-        // move to specs part
+        // move to specs start
         if (it1 != end &&
             *it1 == ':')
             ++it1;
-        pctx.advance_to( it1 );
 
-        // get format_arg to use
+        format_piece p;
+        p.spec = it1 - base;
         auto idv = grammar::parse(
             id, grammar::unsigned_rule<std::size_t>{});
         if (idv)
         {
-            fctx.arg( *idv ).format( pctx, fctx, cs );
+            p.kind = format_piece::index;
+            p.value = *idv;
         }
         else if (!id.empty())
         {
-            fctx.arg( id ).format( pctx, fctx, cs );
+            p.kind = format_piece::name;
+            p.pos = id_start - base;
+            p.n = id.size();
         }
         else
         {
-            std::size_t arg_id = pctx.next_arg_id();
-            fctx.arg( arg_id ).format( pctx, fctx, cs );
+            p.kind = format_piece::next;
         }
+        v.push_back(p);
 
-        it1 = pctx.begin();
-        BOOST_ASSERT(*it1 == '}');
+        // skip the specs, which may contain
+        // nested replacement fields
+        std::size_t depth = 0;
+        while (it1 != end)
+        {
+            if (*it1 == '{')
+                ++depth;
+            else if (*it1 == '}')
+            {
+                if (depth == 0)
+                    break;
+                --depth;
+            }
+            ++it1;
+        }
+        BOOST_ASSERT(it1 != end);
+        if (it1 == end)
+            break;
         it0 = it1 + 1;
     }
+}
 
+char*
+pct_vformat(
+    grammar::lut_chars const& cs,
+    format_piece const* first,
+    format_piece const* last,
+    format_parse_context& pctx,
+    format_context& fctx)
+{
+    char const* const base = pctx.begin();
+    for (; first != last; ++first)
+    {
+        format_piece const& p = *first;
+        if (p.kind == format_piece::literal)
+        {
+            fctx.grow(p.value);
+            char* o = fctx.out();
+            if (p.value == p.n)
+            {
+                // nothing to escape
+                std::memcpy(o, base + p.pos, p.n);
+                o += p.n;
+            }
+            else
+            {
+                char const* i = base + p.pos;
+                char const* const end = i + p.n;
+                for (; i != end; ++i)
+                    encode_one(o, *i, cs);
+            }
+            fctx.advance_to(o);
+            continue;
+        }
+        pctx.advance_to( base + p.spec );
+        switch (p.kind)
+        {
+        case format_piece::index:
+            fctx.arg( p.value ).format( pctx, fctx, cs );
+            break;
+        case format_piece::name:
+            fctx.arg( core::string_view(
+                base + p.pos, p.n) ).format( pctx, fctx, cs );
+            break;
+        default:
+            fctx.arg( pctx.next_arg_id() ).format( pctx, fctx, cs );
+            break;
+        }
+    }
     return fctx.out();
 }
 
@@ -14,24 +14,37 @@
 #include "boost/url/url.hpp"
 #include "boost/url/grammar/lut_chars.hpp"
 #include "boost/url/detail/format_args.hpp"
+#include <vector>
 
 namespace boost {
 namespace urls {
 namespace detail {
 
-// measure a single string
+// format a single string, growing
+// the buffer of the context as needed
 BOOST_URL_DECL
-std::size_t
-pct_vmeasure(
+char*
+pct_vformat(
     grammar::lut_chars const& cs,
     format_parse_context& pctx,
-    measure_context& mctx);
+    format_context& fctx);
+
+// split a single string into pieces
+BOOST_URL_DECL
+void
+pct_vcompile(
+    grammar::lut_chars const& cs,
+    core::string_view s,
+    std::vector<format_piece>& v);
 
-// format a single string
+// format a single string split
+// into [first, last)
 BOOST_URL_DECL
 char*
 pct_vformat(
     grammar::lut_chars const& cs,
+    format_piece const* first,
+    format_piece const* last,
     format_parse_context& pctx,
     format_context& fctx);
 
@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/detail/range_buffer.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+char*
+range_buffer::
+prepare(std::size_t n)
+{
+    if(s_.empty())
+        s_.acquire();
+    std::string& s = *s_;
+    // room for the separator
+    if(n >= s.max_size() - size_)
+        detail::throw_length_error();
+    std::size_t const need =
+        size_ + n + 1;
+    if(s.size() < need)
+    {
+        // the size of a recycled string
+        // is kept, so it is only filled
+        // when it grows
+        std::size_t const n2 =
+            s.size() + s.size() / 2;
+        s.resize(n2 > need &&
+            n2 <= s.max_size() ? n2 : need);
+    }
+    return &s[size_];
+}
+
+std::size_t
+range_buffer::
+commit(char const* end) noexcept
+{
+    std::string& s = *s_;
+    std::size_t const n =
+        end - &s[size_];
+    BOOST_ASSERT(size_ + n < s.size());
+    BOOST_ASSERT(std::memchr(
+        &s[size_], sep_, n) == nullptr);
+    s[size_ + n] = sep_;
+    size_ += n + 1;
+    return n;
+}
+
+void
+range_buffer::
+copy(
+    char*& dest,
+    char const* end) noexcept
+{
+    BOOST_ASSERT(pos_ < size_);
+    char const* const p =
+        s_->data() + pos_;
+    auto const q = static_cast<
+        char const*>(std::memchr(
+            p, sep_, size_ - pos_));
+    BOOST_ASSERT(q != nullptr);
+    std::size_t const n = q - p;
+    BOOST_ASSERT(
+        n <= static_cast<std::size_t>(
+            end - dest));
+    ignore_unused(end);
+    std::memcpy(dest, p, n);
+    dest += n;
+    pos_ += n + 1;
+}
+
+} // detail
+} // urls
+} // boost
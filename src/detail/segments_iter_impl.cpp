@@ -43,24 +43,33 @@ segments_iter_impl(
 
 segments_iter_impl::
 segments_iter_impl(
-    url_impl const& u_,
+    detail::path_ref const& ref_,
     std::size_t pos_,
     std::size_t index_) noexcept
-    : ref(u_)
+    : ref(ref_)
     , pos(pos_)
     , index(index_)
 {
     if(index == 0)
     {
         pos = path_prefix(ref.buffer());
+        update();
     }
     else if(pos != ref.size())
     {
         BOOST_ASSERT(
             ref.data()[pos] == '/');
+        // pos stays on the '/', as
+        // after an increment, so that
+        // decrement works from here
         ++pos; // skip '/'
+        update();
+        --pos;
+    }
+    else
+    {
+        update();
     }
-    update();
 }
 
 void
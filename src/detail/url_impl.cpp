@@ -338,6 +338,16 @@ path_ref(
     }
 }
 
+path_ref::
+path_ref(
+    url_impl const& impl,
+    std::size_t const* gen) noexcept
+    : path_ref(impl)
+{
+    if(impl_)
+        gen_ = gen;
+}
+
 path_ref::
 path_ref(
     core::string_view s,
@@ -443,6 +453,16 @@ query_ref(
     }
 }
 
+query_ref::
+query_ref(
+    url_impl const& impl,
+    std::size_t const* gen) noexcept
+    : query_ref(impl)
+{
+    if(impl_)
+        gen_ = gen;
+}
+
 pct_string_view
 query_ref::
 buffer() const noexcept
@@ -22,8 +22,16 @@ vformat_to(
     core::string_view fmt,
     detail::format_args args)
 {
-    parse_pattern(fmt)
-        .value().apply(u, args);
+    parse_pattern(fmt).value().assign(u, args);
+}
+
+void
+vformat_to(
+    url_base& u,
+    compiled_format const& fmt,
+    detail::format_args args)
+{
+    pattern(fmt).apply(u, args);
 }
 
 
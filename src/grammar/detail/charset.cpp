@@ -0,0 +1,574 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/grammar/detail/charset.hpp>
+#include <boost/core/bit.hpp>
+
+#ifdef BOOST_URL_USE_SSE2
+# include <immintrin.h>
+# ifdef _MSC_VER
+#  include <intrin.h>
+# endif
+#endif
+
+#ifdef BOOST_URL_USE_NEON
+# include <arm_neon.h>
+#endif
+
+namespace boost {
+namespace urls {
+namespace grammar {
+namespace detail {
+
+namespace {
+
+//------------------------------------------------
+//
+// scalar
+//
+//------------------------------------------------
+
+template<bool Match>
+char const*
+find_scalar(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last)
+{
+    while(first != last)
+    {
+        auto const c = static_cast<
+            unsigned char>(*first);
+        if(((mask[lut_word(c)] &
+                lut_bit(c)) != 0) == Match)
+            break;
+        ++first;
+    }
+    return first;
+}
+
+std::size_t
+count_scalar(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last)
+{
+    std::size_t n = 0;
+    while(first != last)
+    {
+        auto const c = static_cast<
+            unsigned char>(*first++);
+        n += (mask[lut_word(c)] &
+            lut_bit(c)) != 0;
+    }
+    return n;
+}
+
+#ifdef BOOST_URL_USE_SSE2
+
+//------------------------------------------------
+//
+// x86
+//
+//------------------------------------------------
+
+bool
+has_ssse3() noexcept
+{
+#if defined(__SSSE3__)
+    return true;
+#elif defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 1);
+    return (r[2] & (1 << 9)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+bool
+has_avx2() noexcept
+{
+#if defined(__AVX2__)
+    return true;
+#elif defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    if(r[0] < 7)
+        return false;
+    // OSXSAVE and AVX
+    __cpuid(r, 1);
+    if((r[2] & 0x18000000) != 0x18000000)
+        return false;
+    // OS saves the XMM and YMM state
+    if((_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(r, 7, 0);
+    return (r[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+// Return a bit for each member of the set
+BOOST_URL_TARGET("ssse3")
+inline
+unsigned
+members_ssse3(
+    __m128i v,
+    __m128i t0,
+    __m128i t1) noexcept
+{
+    __m128i const bits = _mm_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128);
+    // row for c < 0x80 from t0, else from t1;
+    // pshufb yields zero when bit 7 is set
+    __m128i const i0 = _mm_and_si128(
+        v, _mm_set1_epi8(char(0x8F)));
+    __m128i const i1 = _mm_xor_si128(
+        i0, _mm_set1_epi8(char(0x80)));
+    __m128i const row = _mm_or_si128(
+        _mm_shuffle_epi8(t0, i0),
+        _mm_shuffle_epi8(t1, i1));
+    __m128i const bit = _mm_shuffle_epi8(
+        bits, _mm_and_si128(_mm_srli_epi16(
+            v, 4), _mm_set1_epi8(0x0F)));
+    __m128i const miss = _mm_cmpeq_epi8(
+        _mm_and_si128(row, bit),
+        _mm_setzero_si128());
+    return ~static_cast<unsigned>(
+        _mm_movemask_epi8(miss)) & 0xFFFF;
+}
+
+template<bool Match>
+BOOST_URL_TARGET("ssse3")
+char const*
+find_ssse3(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last)
+{
+    if(last - first < 16)
+        return find_scalar<Match>(
+            mask, first, last);
+    __m128i const t0 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(mask));
+    __m128i const t1 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(mask + 2));
+    while(last - first >= 16)
+    {
+        unsigned m = members_ssse3(
+            _mm_loadu_si128(reinterpret_cast<
+                __m128i const*>(first)), t0, t1);
+        if(! Match)
+            m ^= 0xFFFF;
+        if(m)
+            return first + boost::core::countr_zero(m);
+        first += 16;
+    }
+    if(first == last)
+        return last;
+    // Re-read the last 16 bytes and
+    // skip the ones already checked
+    char const* const p = last - 16;
+    unsigned m = members_ssse3(
+        _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(p)), t0, t1);
+    if(! Match)
+        m ^= 0xFFFF;
+    m >>= first - p;
+    if(m)
+        return first + boost::core::countr_zero(m);
+    return last;
+}
+
+BOOST_URL_TARGET("ssse3")
+std::size_t
+count_ssse3(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last)
+{
+    if(last - first < 16)
+        return count_scalar(
+            mask, first, last);
+    __m128i const t0 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(mask));
+    __m128i const t1 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(mask + 2));
+    std::size_t n = 0;
+    while(last - first >= 16)
+    {
+        n += boost::core::popcount(members_ssse3(
+            _mm_loadu_si128(reinterpret_cast<
+                __m128i const*>(first)), t0, t1));
+        first += 16;
+    }
+    if(first == last)
+        return n;
+    // Re-read the last 16 bytes and
+    // skip the ones already counted
+    char const* const p = last - 16;
+    unsigned const m = members_ssse3(
+        _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(p)), t0, t1);
+    return n + boost::core::popcount(
+        m >> (first - p));
+}
+
+BOOST_URL_TARGET("avx2")
+inline
+std::uint32_t
+members_avx2(
+    __m256i v,
+    __m256i t0,
+    __m256i t1) noexcept
+{
+    __m256i const bits = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128);
+    __m256i const i0 = _mm256_and_si256(
+        v, _mm256_set1_epi8(char(0x8F)));
+    __m256i const i1 = _mm256_xor_si256(
+        i0, _mm256_set1_epi8(char(0x80)));
+    __m256i const row = _mm256_or_si256(
+        _mm256_shuffle_epi8(t0, i0),
+        _mm256_shuffle_epi8(t1, i1));
+    __m256i const bit = _mm256_shuffle_epi8(
+        bits, _mm256_and_si256(_mm256_srli_epi16(
+            v, 4), _mm256_set1_epi8(0x0F)));
+    __m256i const miss = _mm256_cmpeq_epi8(
+        _mm256_and_si256(row, bit),
+        _mm256_setzero_si256());
+    return ~static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(miss));
+}
+
+template<bool Match>
+BOOST_URL_TARGET("avx2")
+char const*
+find_avx2(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last)
+{
+    if(last - first < 32)
+        return find_ssse3<Match>(
+            mask, first, last);
+    // vpshufb looks up within each
+    // 128-bit lane, so repeat the tables
+    __m256i const t0 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(mask)));
+    __m256i const t1 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(mask + 2)));
+    while(last - first >= 32)
+    {
+        std::uint32_t m = members_avx2(
+            _mm256_loadu_si256(reinterpret_cast<
+                __m256i const*>(first)), t0, t1);
+        if(! Match)
+            m = ~m;
+        if(m)
+            return first + boost::core::countr_zero(m);
+        first += 32;
+    }
+    if(first == last)
+        return last;
+    char const* const p = last - 32;
+    std::uint32_t m = members_avx2(
+        _mm256_loadu_si256(reinterpret_cast<
+            __m256i const*>(p)), t0, t1);
+    if(! Match)
+        m = ~m;
+    m >>= first - p;
+    if(m)
+        return first + boost::core::countr_zero(m);
+    return last;
+}
+
+BOOST_URL_TARGET("avx2")
+std::size_t
+count_avx2(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last)
+{
+    if(last - first < 32)
+        return count_ssse3(
+            mask, first, last);
+    __m256i const t0 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(mask)));
+    __m256i const t1 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(mask + 2)));
+    std::size_t n = 0;
+    while(last - first >= 32)
+    {
+        n += boost::core::popcount(members_avx2(
+            _mm256_loadu_si256(reinterpret_cast<
+                __m256i const*>(first)), t0, t1));
+        first += 32;
+    }
+    if(first == last)
+        return n;
+    char const* const p = last - 32;
+    std::uint32_t const m = members_avx2(
+        _mm256_loadu_si256(reinterpret_cast<
+            __m256i const*>(p)), t0, t1);
+    return n + boost::core::popcount(
+        m >> (first - p));
+}
+
+#endif
+
+#ifdef BOOST_URL_USE_NEON
+
+//------------------------------------------------
+//
+// NEON
+//
+//------------------------------------------------
+
+// Return four bits for each member of the set
+inline
+std::uint64_t
+members_neon(
+    uint8x16_t v,
+    uint8x16_t t0,
+    uint8x16_t t1) noexcept
+{
+    static constexpr std::uint8_t bits_[16] = {
+        1, 2, 4, 8, 16, 32, 64, 128,
+        1, 2, 4, 8, 16, 32, 64, 128 };
+    // tbl yields zero for indexes past 15
+    uint8x16_t const i0 = vandq_u8(
+        v, vdupq_n_u8(0x8F));
+    uint8x16_t const i1 = veorq_u8(
+        i0, vdupq_n_u8(0x80));
+    uint8x16_t const row = vorrq_u8(
+        vqtbl1q_u8(t0, i0),
+        vqtbl1q_u8(t1, i1));
+    uint8x16_t const bit = vqtbl1q_u8(
+        vld1q_u8(bits_), vshrq_n_u8(v, 4));
+    uint8x16_t const hit = vtstq_u8(row, bit);
+    return vget_lane_u64(vreinterpret_u64_u8(
+        vshrn_n_u16(vreinterpretq_u16_u8(
+            hit), 4)), 0);
+}
+
+template<bool Match>
+char const*
+find_neon(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last)
+{
+    if(last - first < 16)
+        return find_scalar<Match>(
+            mask, first, last);
+    uint8x16_t const t0 = vld1q_u8(
+        reinterpret_cast<std::uint8_t const*>(mask));
+    uint8x16_t const t1 = vld1q_u8(
+        reinterpret_cast<std::uint8_t const*>(mask + 2));
+    while(last - first >= 16)
+    {
+        std::uint64_t m = members_neon(vld1q_u8(
+            reinterpret_cast<std::uint8_t const*>(
+                first)), t0, t1);
+        if(! Match)
+            m = ~m;
+        if(m)
+            return first + (
+                boost::core::countr_zero(m) >> 2);
+        first += 16;
+    }
+    if(first == last)
+        return last;
+    char const* const p = last - 16;
+    std::uint64_t m = members_neon(vld1q_u8(
+        reinterpret_cast<std::uint8_t const*>(
+            p)), t0, t1);
+    if(! Match)
+        m = ~m;
+    m >>= 4 * (first - p);
+    if(m)
+        return first + (
+            boost::core::countr_zero(m) >> 2);
+    return last;
+}
+
+std::size_t
+count_neon(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last)
+{
+    if(last - first < 16)
+        return count_scalar(
+            mask, first, last);
+    uint8x16_t const t0 = vld1q_u8(
+        reinterpret_cast<std::uint8_t const*>(mask));
+    uint8x16_t const t1 = vld1q_u8(
+        reinterpret_cast<std::uint8_t const*>(mask + 2));
+    std::size_t n = 0;
+    while(last - first >= 16)
+    {
+        n += boost::core::popcount(members_neon(
+            vld1q_u8(reinterpret_cast<
+                std::uint8_t const*>(first)),
+            t0, t1)) >> 2;
+        first += 16;
+    }
+    if(first == last)
+        return n;
+    char const* const p = last - 16;
+    std::uint64_t const m = members_neon(vld1q_u8(
+        reinterpret_cast<std::uint8_t const*>(
+            p)), t0, t1);
+    return n + (boost::core::popcount(
+        m >> (4 * (first - p))) >> 2);
+}
+
+#endif
+
+template<bool Match>
+lut_find_fn
+kernel(lut_isa isa) noexcept
+{
+    switch(isa)
+    {
+    case lut_isa::scalar:
+        return &find_scalar<Match>;
+#ifdef BOOST_URL_USE_SSE2
+    case lut_isa::ssse3:
+        if(has_ssse3())
+            return &find_ssse3<Match>;
+        return nullptr;
+    case lut_isa::avx2:
+        if(has_avx2())
+            return &find_avx2<Match>;
+        return nullptr;
+#endif
+#ifdef BOOST_URL_USE_NEON
+    case lut_isa::neon:
+        return &find_neon<Match>;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+lut_count_fn
+count_kernel(lut_isa isa) noexcept
+{
+    switch(isa)
+    {
+    case lut_isa::scalar:
+        return &count_scalar;
+#ifdef BOOST_URL_USE_SSE2
+    case lut_isa::ssse3:
+        if(has_ssse3())
+            return &count_ssse3;
+        return nullptr;
+    case lut_isa::avx2:
+        if(has_avx2())
+            return &count_avx2;
+        return nullptr;
+#endif
+#ifdef BOOST_URL_USE_NEON
+    case lut_isa::neon:
+        return &count_neon;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+} // (anon)
+
+lut_find_fn
+lut_find_if_kernel(lut_isa isa) noexcept
+{
+    return kernel<true>(isa);
+}
+
+lut_find_fn
+lut_find_if_not_kernel(lut_isa isa) noexcept
+{
+    return kernel<false>(isa);
+}
+
+lut_count_fn
+lut_count_kernel(lut_isa isa) noexcept
+{
+    return count_kernel(isa);
+}
+
+lut_isa
+lut_best_isa() noexcept
+{
+#ifdef BOOST_URL_USE_SSE2
+    if(has_avx2())
+        return lut_isa::avx2;
+    if(has_ssse3())
+        return lut_isa::ssse3;
+#endif
+#ifdef BOOST_URL_USE_NEON
+    return lut_isa::neon;
+#else
+    return lut_isa::scalar;
+#endif
+}
+
+char const*
+lut_find_if(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last) noexcept
+{
+    static lut_find_fn const f =
+        kernel<true>(lut_best_isa());
+    return f(mask, first, last);
+}
+
+char const*
+lut_find_if_not(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last) noexcept
+{
+    static lut_find_fn const f =
+        kernel<false>(lut_best_isa());
+    return f(mask, first, last);
+}
+
+std::size_t
+lut_count(
+    std::uint64_t const* mask,
+    char const* first,
+    char const* last) noexcept
+{
+    static lut_count_fn const f =
+        count_kernel(lut_best_isa());
+    return f(mask, first, last);
+}
+
+} // detail
+} // grammar
+} // urls
+} // boost
@@ -57,6 +57,21 @@ static all_reports all_reports_;
 } // detail
 
 namespace see_below {
+std::size_t
+recycled_thread_index() noexcept
+{
+#if !defined(BOOST_URL_DISABLE_THREADS) && \
+    !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+    static std::atomic<std::size_t> next{0};
+    static thread_local std::size_t const i =
+        next.fetch_add(1,
+            std::memory_order_relaxed);
+    return i;
+#else
+    return 0;
+#endif
+}
+
 void
 recycled_add_impl(
     std::size_t n) noexcept
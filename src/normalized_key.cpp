@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/normalized_key.hpp>
+#include <boost/url/authority_view.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include "detail/decode.hpp"
+#include "detail/normalize.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+/*  The key is a sequence of presence
+    flags and fields, in the order in
+    which url_view_base::compare visits
+    the components. A zero byte in a
+    field is written as "\0\1" and each
+    field ends with "\0\0", so that no
+    field is a prefix of another one.
+*/
+class key_writer
+{
+    std::string& s_;
+
+    // escape the zeros from pos on
+    void
+    escape(std::size_t pos)
+    {
+        if(! std::memchr(
+            s_.data() + pos, 0, s_.size() - pos))
+            return;
+        std::string t(s_, pos);
+        s_.resize(pos);
+        for(char c : t)
+        {
+            s_.push_back(c);
+            if(c == '\0')
+                s_.push_back('\1');
+        }
+    }
+
+    void
+    end()
+    {
+        s_.push_back('\0');
+        s_.push_back('\0');
+    }
+
+public:
+    explicit
+    key_writer(std::string& s) noexcept
+        : s_(s)
+    {
+    }
+
+    void
+    flag(bool b)
+    {
+        s_.push_back(b ? '\1' : '\0');
+    }
+
+    // compared by detail::compare
+    void
+    plain(core::string_view s)
+    {
+        auto const pos = s_.size();
+        s_.append(s.data(), s.size());
+        escape(pos);
+        end();
+    }
+
+    // compared by detail::ci_compare
+    void
+    ci_plain(core::string_view s)
+    {
+        auto const pos = s_.size();
+        for(char c : s)
+            s_.push_back(grammar::to_lower(c));
+        escape(pos);
+        end();
+    }
+
+    // compared by detail::compare_encoded
+    void
+    encoded(core::string_view s)
+    {
+        auto const pos = s_.size();
+        auto const n =
+            detail::decode_bytes_unsafe(s);
+        s_.resize(pos + n);
+        detail::decode_unsafe(
+            &s_[pos], &s_[pos] + n, s);
+        escape(pos);
+        end();
+    }
+
+    // compared by detail::ci_compare_encoded
+    void
+    ci_encoded(core::string_view s)
+    {
+        auto const pos = s_.size();
+        auto const n =
+            detail::decode_bytes_unsafe(s);
+        s_.resize(pos + n);
+        detail::decode_unsafe(
+            &s_[pos], &s_[pos] + n, s);
+        for(auto i = pos; i < s_.size(); ++i)
+            s_[i] = grammar::to_lower(s_[i]);
+        escape(pos);
+        end();
+    }
+
+    // compared by detail::segments_compare
+    void
+    path(segments_encoded_view ps)
+    {
+        auto const pos = s_.size();
+        auto const n =
+            detail::segments_normalized_size(ps);
+        s_.resize(pos + n);
+        if(n > 0)
+            detail::segments_normalized(
+                ps, &s_[pos]);
+        escape(pos);
+        end();
+    }
+};
+
+} // (anon)
+
+normalized_key::
+normalized_key()
+    : normalized_key(url_view())
+{
+}
+
+normalized_key::
+normalized_key(
+    url_view_base const& u)
+{
+    s_.reserve(u.size() + 16);
+    key_writer w(s_);
+    w.flag(u.has_scheme());
+    if(u.has_scheme())
+        w.ci_plain(u.scheme());
+    w.flag(u.has_authority());
+    if(u.has_authority())
+    {
+        authority_view const a =
+            u.authority();
+        w.flag(a.has_userinfo());
+        if(a.has_userinfo())
+        {
+            w.encoded(a.encoded_user());
+            w.flag(a.has_password());
+            if(a.has_password())
+                w.encoded(a.encoded_password());
+        }
+        w.ci_encoded(a.encoded_host());
+        w.flag(a.has_port());
+        if(a.has_port())
+            w.plain(a.port());
+    }
+    w.path(u.encoded_segments());
+    w.flag(u.has_query());
+    if(u.has_query())
+        w.encoded(u.encoded_query());
+    w.flag(u.has_fragment());
+    if(u.has_fragment())
+        w.encoded(u.encoded_fragment());
+
+    detail::block_hash h(0);
+    h.put(s_);
+    hash_ = h.digest();
+}
+
+int
+normalized_key::
+compare(
+    normalized_key const& other) const noexcept
+{
+    auto const n0 = s_.size();
+    auto const n1 = other.s_.size();
+    auto const n = (std::min)(n0, n1);
+    if(n > 0)
+    {
+        int const r = std::memcmp(
+            s_.data(), other.s_.data(), n);
+        if(r != 0)
+            return r < 0 ? -1 : 1;
+    }
+    if(n0 == n1)
+        return 0;
+    return n0 < n1 ? -1 : 1;
+}
+
+} // urls
+} // boost
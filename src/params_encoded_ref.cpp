@@ -30,7 +30,8 @@ namespace urls {
 params_encoded_ref::
 params_encoded_ref(
     url_base& u) noexcept
-    : params_encoded_base(u.impl_)
+    : params_encoded_base(
+        detail::query_ref(u.impl_, &u.gen_))
     , u_(&u)
 {
 }
@@ -0,0 +1,263 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/params_index.hpp>
+#include <boost/url/detail/params_iter_impl.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/assert.hpp>
+#include "detail/normalize.hpp"
+#include <utility>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+constexpr std::size_t npos = std::size_t(-1);
+
+} // (anon)
+
+params_index::
+params_index(
+    params_encoded_base const& ps,
+    ignore_case_param ic) noexcept
+    : ref_(ps.ref_)
+    , ic_(ic)
+{
+}
+
+params_index::
+params_index(
+    params_base const& ps,
+    ignore_case_param ic) noexcept
+    : ref_(ps.ref_)
+    , ic_(ic)
+{
+}
+
+void
+params_index::
+build() const
+{
+    if(built_)
+        return;
+    auto const n = ref_.nparam();
+    std::vector<entry> entries;
+    std::vector<slot> slots;
+    if(n > 0)
+    {
+        // keep the load factor at
+        // one half or less
+        std::size_t cap = 8;
+        while(cap < 2 * n)
+            cap *= 2;
+        entries.reserve(n);
+        slots.resize(cap, { 0, npos, npos, 0 });
+        auto const mask = cap - 1;
+        detail::params_iter_impl it(ref_);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            entries.push_back({
+                it.pos, it.nk, it.dk, npos });
+            core::string_view const key(
+                ref_.begin() + it.pos,
+                it.nk - 1);
+            detail::block_hash h(0);
+            if(ic_)
+                detail::ci_digest_encoded(key, h);
+            else
+                detail::digest_encoded(key, h);
+            auto const hv = h.digest();
+            for(auto j = hv & mask;; j = (j + 1) & mask)
+            {
+                slot& s = slots[j];
+                if(s.first == npos)
+                {
+                    s = { hv, i, i, 1 };
+                    break;
+                }
+                if(s.hash != hv)
+                    continue;
+                entry const& e = entries[s.first];
+                if(e.dk != it.dk)
+                    continue;
+                core::string_view const k(
+                    ref_.begin() + e.pos,
+                    e.nk - 1);
+                if((ic_ ?
+                    detail::ci_compare_encoded(k, key) :
+                    detail::compare_encoded(k, key)) != 0)
+                    continue;
+                entries[s.last].next = i;
+                s.last = i;
+                ++s.count;
+                break;
+            }
+            it.increment();
+        }
+    }
+    entries_ = std::move(entries);
+    slots_ = std::move(slots);
+    built_ = true;
+}
+
+auto
+params_index::
+begin() const noexcept ->
+    iterator
+{
+    return iterator(ref_);
+}
+
+auto
+params_index::
+end() const noexcept ->
+    iterator
+{
+    return iterator(ref_, 0);
+}
+
+std::size_t
+params_index::
+count(
+    core::string_view key) const
+{
+    auto const s = lookup(key);
+    if(! s)
+        return 0;
+    return s->count;
+}
+
+auto
+params_index::
+find(
+    core::string_view key) const ->
+        iterator
+{
+    auto const s = lookup(key);
+    if(! s)
+        return end();
+    return iterator(detail::params_iter_impl(
+        ref_, entries_[s->first].pos, s->first));
+}
+
+auto
+params_index::
+find_last(
+    core::string_view key) const ->
+        iterator
+{
+    auto const s = lookup(key);
+    if(! s)
+        return end();
+    return iterator(detail::params_iter_impl(
+        ref_, entries_[s->last].pos, s->last));
+}
+
+auto
+params_index::
+find_next(
+    iterator it) const noexcept ->
+        iterator
+{
+    BOOST_ASSERT(built_);
+    BOOST_ASSERT(it.it_.index < entries_.size());
+    auto const i = entries_[it.it_.index].next;
+    if(i == npos)
+        return end();
+    return iterator(detail::params_iter_impl(
+        ref_, entries_[i].pos, i));
+}
+
+//------------------------------------------------
+
+auto
+params_index::
+lookup(
+    core::string_view key) const ->
+        slot const*
+{
+    build();
+    if(slots_.empty())
+        return nullptr;
+    auto const hv = digest(key);
+    auto const mask = slots_.size() - 1;
+    for(auto j = hv & mask;; j = (j + 1) & mask)
+    {
+        slot const& s = slots_[j];
+        if(s.first == npos)
+            return nullptr;
+        if( s.hash == hv &&
+            key_equal(entries_[s.first], key))
+            return &s;
+    }
+}
+
+// compare the decoded key of
+// an entry to a plain string
+bool
+params_index::
+key_equal(
+    entry const& e,
+    core::string_view key) const noexcept
+{
+    if(e.dk != key.size())
+        return false;
+    auto p = ref_.begin() + e.pos;
+    auto const end = p + e.nk - 1;
+    auto k = key.data();
+    while(p != end)
+    {
+        char c;
+        if(*p != '%')
+        {
+            c = *p++;
+        }
+        else
+        {
+            BOOST_ASSERT(end - p >= 3);
+            c = static_cast<char>(
+                (grammar::hexdig_value(p[1]) << 4) +
+                grammar::hexdig_value(p[2]));
+            p += 3;
+        }
+        if(ic_)
+        {
+            if( grammar::to_lower(c) !=
+                grammar::to_lower(*k))
+                return false;
+        }
+        else if(c != *k)
+        {
+            return false;
+        }
+        ++k;
+    }
+    return true;
+}
+
+std::size_t
+params_index::
+digest(
+    core::string_view key) const noexcept
+{
+    detail::block_hash h(0);
+    if(ic_)
+        detail::ci_digest(key, h);
+    else
+        h.put(key);
+    return h.digest();
+}
+
+} // urls
+} // boost
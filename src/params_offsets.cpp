@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/params_offsets.hpp>
+#include <boost/url/detail/params_iter_impl.hpp>
+#include <boost/assert.hpp>
+
+namespace boost {
+namespace urls {
+
+params_offsets::
+params_offsets(
+    params_encoded_base const& ps) noexcept
+    : ref_(ps.ref_)
+{
+}
+
+params_offsets::
+params_offsets(
+    params_base const& ps) noexcept
+    : ref_(ps.ref_)
+{
+}
+
+void
+params_offsets::
+build() const
+{
+    if( built_ &&
+        gen_ == ref_.gen() &&
+        ! ref_.untracked())
+        return;
+    auto const n = ref_.nparam();
+    pos_.clear();
+    pos_.reserve(n);
+    detail::params_iter_impl it(ref_);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        pos_.push_back(it.pos);
+        it.increment();
+    }
+    gen_ = ref_.gen();
+    built_ = true;
+}
+
+auto
+params_offsets::
+begin() const noexcept ->
+    iterator
+{
+    return iterator(ref_);
+}
+
+auto
+params_offsets::
+end() const noexcept ->
+    iterator
+{
+    return iterator(ref_, 0);
+}
+
+auto
+params_offsets::
+nth(std::size_t i) const ->
+    iterator
+{
+    BOOST_ASSERT(i <= size());
+    if(i == size())
+        return end();
+    build();
+    return iterator(detail::params_iter_impl(
+        ref_, pos_[i], i));
+}
+
+param_pct_view
+params_offsets::
+operator[](std::size_t i) const
+{
+    BOOST_ASSERT(i < size());
+    build();
+    return detail::params_iter_impl(
+        ref_, pos_[i], i).dereference();
+}
+
+} // urls
+} // boost
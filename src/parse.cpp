@@ -11,20 +11,363 @@
 
 #include <boost/url/detail/config.hpp>
 #include <boost/url/parse.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/except.hpp>
 #include <boost/url/rfc/absolute_uri_rule.hpp>
 #include <boost/url/rfc/relative_ref_rule.hpp>
 #include <boost/url/rfc/uri_rule.hpp>
 #include <boost/url/rfc/uri_reference_rule.hpp>
 #include <boost/url/rfc/origin_form_rule.hpp>
+#include <boost/url/grammar/alpha_chars.hpp>
+#include <boost/url/grammar/charset.hpp>
+#include <boost/url/grammar/digit_chars.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/url/grammar/lut_chars.hpp>
 #include <boost/url/grammar/parse.hpp>
+#include "rfc/detail/charsets.hpp"
+#include "rfc/detail/ip_literal_rule.hpp"
+#include <algorithm>
 
 namespace boost {
 namespace urls {
 
+namespace {
+
+// Skip a run of characters in cs, with
+// percent-escapes, counting the separators.
+// Returns false on an invalid escape.
+bool
+skip_encoded(
+    char const*& it,
+    char const* const end,
+    grammar::lut_chars const& cs,
+    char sep,
+    std::size_t& nsep,
+    std::size_t& npct) noexcept
+{
+    for(;;)
+    {
+        auto const it0 = it;
+        it = grammar::find_if_not(it, end, cs);
+        nsep += static_cast<std::size_t>(
+            std::count(it0, it, sep));
+        if( it == end ||
+            *it != '%')
+            return true;
+        if( end - it < 3 ||
+            ! grammar::hexdig_chars(it[1]) ||
+            ! grammar::hexdig_chars(it[2]))
+            return false;
+        it += 3;
+        ++npct;
+    }
+}
+
+// Same grammar and error codes as
+// origin_form_rule, with the path and the
+// query each validated and counted in a
+// single loop instead of a range of rules.
+system::result<url_view>
+parse_origin_form_impl(
+    core::string_view s) noexcept
+{
+    // origin-form   = absolute-path [ "?" query ]
+    // absolute-path = 1*( "/" segment )
+    char const* it = s.data();
+    char const* const end = it + s.size();
+    if( it == end ||
+        *it != '/')
+    {
+        BOOST_URL_RETURN_EC(
+            grammar::error::mismatch);
+    }
+    detail::url_impl u(
+        detail::url_impl::from::string);
+    u.cs_ = it;
+
+    std::size_t nseg = 0;
+    std::size_t npct = 0;
+    auto const p0 = it;
+    if(! skip_encoded(it, end,
+            detail::path_chars, '/', nseg, npct))
+    {
+        // the rule's range of segments
+        // stops before the bad segment
+        if(nseg > 1)
+        {
+            BOOST_URL_RETURN_EC(
+                grammar::error::leftover);
+        }
+        BOOST_URL_RETURN_EC(
+            grammar::error::mismatch);
+    }
+    std::size_t n = it - p0;
+    u.apply_path(
+        make_pct_string_view_unsafe(
+            p0, n, n - 2 * npct),
+        nseg);
+    if(it == end)
+        return u.construct();
+    if(*it != '?')
+    {
+        BOOST_URL_RETURN_EC(
+            grammar::error::leftover);
+    }
+
+    // a query has at least one param
+    std::size_t nparam = 1;
+    npct = 0;
+    auto const q0 = ++it;
+    if( ! skip_encoded(it, end,
+            detail::query_chars, '&', nparam, npct) ||
+        it != end)
+    {
+        BOOST_URL_RETURN_EC(
+            grammar::error::leftover);
+    }
+    n = it - q0;
+    u.apply_query(
+        make_pct_string_view_unsafe(
+            q0, n, n - 2 * npct),
+        nparam);
+    return u.construct();
+}
+
+//------------------------------------------------
+//
+// The functions below check the same grammar
+// as the rules used by parse_*, mirroring their
+// choices so that both always agree, but
+// nothing is counted, decoded or stored.
+//
+//------------------------------------------------
+
+// Skip a run of characters in cs, with
+// percent-escapes. Returns false on an
+// invalid escape.
+bool
+skip_valid(
+    char const*& it,
+    char const* const end,
+    grammar::lut_chars const& cs) noexcept
+{
+    for(;;)
+    {
+        it = grammar::find_if_not(it, end, cs);
+        if( it == end ||
+            *it != '%')
+            return true;
+        if( end - it < 3 ||
+            ! grammar::hexdig_chars(it[1]) ||
+            ! grammar::hexdig_chars(it[2]))
+            return false;
+        it += 3;
+    }
+}
+
+// scheme ":"
+bool
+check_scheme(
+    char const*& it,
+    char const* const end) noexcept
+{
+    static
+    constexpr
+    grammar::lut_chars scheme_chars(
+        "0123456789" "+-."
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "abcdefghijklmnopqrstuvwxyz");
+    if( it == end ||
+        ! grammar::alpha_chars(*it))
+        return false;
+    it = grammar::find_if_not(
+        it + 1, end, scheme_chars);
+    if( it == end ||
+        *it != ':')
+        return false;
+    ++it;
+    return true;
+}
+
+// authority = [ userinfo "@" ] host [ ":" port ]
+bool
+check_authority(
+    char const*& it,
+    char const* const end) noexcept
+{
+    // '%' is never a literal, so an invalid
+    // escape anywhere makes the string invalid
+    // no matter which rule backtracks over it
+    auto p = it;
+    if(! skip_valid(p, end, detail::userinfo_chars))
+        return false;
+    if( p != end &&
+        *p == '@')
+        it = p + 1;
+
+    // host
+    if( it != end &&
+        *it == '[')
+    {
+        if(! grammar::parse(
+                it, end, detail::ip_literal_rule))
+            return false;
+    }
+    else
+    {
+        // an IPv4address is also a reg-name
+        if(! skip_valid(it, end, detail::host_chars))
+            return false;
+    }
+
+    // port = *DIGIT
+    if( it != end &&
+        *it == ':')
+        it = grammar::find_if_not(
+            it + 1, end, grammar::digit_chars);
+    return true;
+}
+
+// hier-part = "//" authority path-abempty
+//           / path-absolute
+//           / path-rootless
+//           / path-empty
+bool
+check_hier_part(
+    char const*& it,
+    char const* const end) noexcept
+{
+    if( end - it > 1 &&
+        it[0] == '/' &&
+        it[1] == '/')
+    {
+        it += 2;
+        if(! check_authority(it, end))
+            return false;
+        if( it == end ||
+            *it != '/')
+            return true;
+    }
+    return skip_valid(it, end, detail::path_chars);
+}
+
+// relative-part = "//" authority path-abempty
+//               / path-absolute
+//               / path-noscheme
+//               / path-abempty
+//               / path-empty
+bool
+check_relative_part(
+    char const*& it,
+    char const* const end) noexcept
+{
+    if( end - it > 1 &&
+        it[0] == '/' &&
+        it[1] == '/')
+    {
+        it += 2;
+        if(! check_authority(it, end))
+            return false;
+        // like relative_part_rule, a segment may
+        // follow the authority without a '/'
+    }
+    if( it != end &&
+        *it != '/')
+    {
+        // the first segment has no colon
+        if(! skip_valid(
+                it, end, detail::nocolon_pchars))
+            return false;
+        if( it != end &&
+            *it == ':')
+            return false;
+    }
+    return skip_valid(it, end, detail::path_chars);
+}
+
+// [ "?" query ] [ "#" fragment ], to the end
+bool
+check_query_fragment(
+    char const* it,
+    char const* const end,
+    bool fragment) noexcept
+{
+    if( it != end &&
+        *it == '?')
+    {
+        ++it;
+        if(! skip_valid(
+                it, end, detail::query_chars))
+            return false;
+    }
+    if( fragment &&
+        it != end &&
+        *it == '#')
+    {
+        ++it;
+        if(! skip_valid(
+                it, end, detail::fragment_chars))
+            return false;
+    }
+    return it == end;
+}
+
+bool
+is_uri(
+    core::string_view s,
+    bool fragment) noexcept
+{
+    char const* it = s.data();
+    char const* const end = it + s.size();
+    return
+        check_scheme(it, end) &&
+        check_hier_part(it, end) &&
+        check_query_fragment(it, end, fragment);
+}
+
+bool
+is_relative_ref(
+    core::string_view s) noexcept
+{
+    char const* it = s.data();
+    char const* const end = it + s.size();
+    return
+        check_relative_part(it, end) &&
+        check_query_fragment(it, end, true);
+}
+
+bool
+is_origin_form(
+    core::string_view s) noexcept
+{
+    char const* it = s.data();
+    char const* const end = it + s.size();
+    return
+        it != end &&
+        *it == '/' &&
+        skip_valid(it, end, detail::path_chars) &&
+        check_query_fragment(it, end, false);
+}
+
+system::result<void>
+make_result(bool valid) noexcept
+{
+    if(! valid)
+    {
+        BOOST_URL_RETURN_EC(
+            grammar::error::invalid);
+    }
+    return {};
+}
+
+} // (anon)
+
 system::result<url_view>
 parse_absolute_uri(
     core::string_view s)
 {
+    if(s.size() > url_view::max_size())
+        detail::throw_length_error();
     return grammar::parse(
         s, absolute_uri_rule);
 }
@@ -33,14 +376,17 @@ system::result<url_view>
 parse_origin_form(
     core::string_view s)
 {
-    return grammar::parse(
-        s, origin_form_rule);
+    if(s.size() > url_view::max_size())
+        detail::throw_length_error();
+    return parse_origin_form_impl(s);
 }
 
 system::result<url_view>
 parse_relative_ref(
     core::string_view s)
 {
+    if(s.size() > url_view::max_size())
+        detail::throw_length_error();
     return grammar::parse(
         s, relative_ref_rule);
 }
@@ -48,6 +394,8 @@ system::result<url_view>
 parse_uri(
     core::string_view s)
 {
+    if(s.size() > url_view::max_size())
+        detail::throw_length_error();
     return grammar::parse(
         s, uri_rule);
 }
@@ -56,10 +404,68 @@ system::result<url_view>
 parse_uri_reference(
     core::string_view s)
 {
+    if(s.size() > url_view::max_size())
+        detail::throw_length_error();
     return grammar::parse(
         s, uri_reference_rule);
 }
 
+//------------------------------------------------
+
+system::result<void>
+validate_absolute_uri(
+    core::string_view s)
+{
+    if(s.size() > url_view::max_size())
+        detail::throw_length_error();
+    return make_result(
+        is_uri(s, false));
+}
+
+system::result<void>
+validate_origin_form(
+    core::string_view s)
+{
+    if(s.size() > url_view::max_size())
+        detail::throw_length_error();
+    return make_result(
+        is_origin_form(s));
+}
+
+system::result<void>
+validate_relative_ref(
+    core::string_view s)
+{
+    if(s.size() > url_view::max_size())
+        detail::throw_length_error();
+    return make_result(
+        is_relative_ref(s));
+}
+
+system::result<void>
+validate_uri(
+    core::string_view s)
+{
+    if(s.size() > url_view::max_size())
+        detail::throw_length_error();
+    return make_result(
+        is_uri(s, true));
+}
+
+system::result<void>
+validate_uri_reference(
+    core::string_view s)
+{
+    if(s.size() > url_view::max_size())
+        detail::throw_length_error();
+    // a string with a scheme is never a
+    // relative-ref, so trying both gives
+    // the same answer as uri_reference_rule
+    return make_result(
+        is_uri(s, true) ||
+        is_relative_ref(s));
+}
+
 } // urls
 } // boost
 
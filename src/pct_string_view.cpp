@@ -47,9 +47,15 @@ system::result<pct_string_view>
 make_pct_string_view(
     core::string_view s) noexcept
 {
+    std::size_t dn = 0;
+    if(detail::validate_pct(s, dn))
+        return make_pct_string_view_unsafe(
+            s.data(), s.size(), dn);
+
+    // find the error
     auto p = s.begin();
     auto const end = s.end();
-    std::size_t dn = 0;
+    dn = 0;
     if(s.size() >= 3)
     {
         auto const safe_end = end - 2;
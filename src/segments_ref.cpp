@@ -28,7 +28,7 @@ segments_ref::
 segments_ref(
     url_base& u) noexcept
     : segments_base(
-        detail::path_ref(u.impl_))
+        detail::path_ref(u.impl_, &u.gen_))
     , u_(&u)
 {
 }
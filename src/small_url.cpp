@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/small_url.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+small_url_base::
+~small_url_base()
+{
+    if(s_ != buf_)
+        delete[] s_;
+}
+
+small_url_base::
+small_url_base(
+    char* buf,
+    std::size_t cap) noexcept
+    : buf_(buf)
+    , buf_cap_(cap)
+{
+    s_ = buf;
+    cap_ = cap;
+    s_[0] = '\0';
+    impl_.cs_ = s_;
+}
+
+void
+small_url_base::
+release() noexcept
+{
+    if(s_ != buf_)
+    {
+        delete[] s_;
+        s_ = buf_;
+        cap_ = buf_cap_;
+    }
+    impl_ = {from::url};
+    ++gen_;
+    s_[0] = '\0';
+    impl_.cs_ = s_;
+}
+
+void
+small_url_base::
+steal(small_url_base& u) noexcept
+{
+    BOOST_ASSERT(s_ == buf_);
+    BOOST_ASSERT(buf_cap_ == u.buf_cap_);
+    if(u.s_ == u.buf_)
+    {
+        // fits in the inline buffer,
+        // so this cannot throw
+        copy(u);
+        u.clear_impl();
+        return;
+    }
+    impl_ = u.impl_;
+    ++gen_;
+    s_ = u.s_;
+    cap_ = u.cap_;
+    u.s_ = u.buf_;
+    u.cap_ = u.buf_cap_;
+    u.release();
+}
+
+void
+small_url_base::
+clear_impl() noexcept
+{
+    // preserve capacity
+    impl_ = {from::url};
+    ++gen_;
+    s_[0] = '\0';
+    impl_.cs_ = s_;
+}
+
+void
+small_url_base::
+reserve_impl(
+    std::size_t n,
+    op_t& op)
+{
+    if(n > max_size())
+        detail::throw_length_error();
+    if(n <= cap_)
+        return;
+    // 50% growth policy
+    auto const h = cap_ / 2;
+    std::size_t new_cap;
+    if(cap_ <= max_size() - h)
+        new_cap = cap_ + h;
+    else
+        new_cap = max_size();
+    if( new_cap < n)
+        new_cap = n;
+    char* s = new char[new_cap + 1];
+    std::memcpy(s, s_, size() + 1);
+    if(s_ != buf_)
+    {
+        BOOST_ASSERT(! op.old);
+        op.old = s_;
+    }
+    else
+    {
+        auto& c = counters();
+        c.spills.fetch_add(
+            1, std::memory_order_relaxed);
+        auto m = c.max_spill_size.load(
+            std::memory_order_relaxed);
+        while( m < n &&
+            ! c.max_spill_size.compare_exchange_weak(
+                m, n, std::memory_order_relaxed))
+        {
+        }
+    }
+    s_ = s;
+    cap_ = new_cap;
+    impl_.cs_ = s_;
+}
+
+small_url_stats
+small_url_base::
+stats_impl(
+    detail::small_url_counters const& c) noexcept
+{
+    small_url_stats st;
+    st.spills = c.spills.load(
+        std::memory_order_relaxed);
+    st.max_spill_size = c.max_spill_size.load(
+        std::memory_order_relaxed);
+    return st;
+}
+
+void
+small_url_base::
+cleanup(
+    op_t& op)
+{
+    if(op.old)
+        delete[] op.old;
+}
+
+} // urls
+} // boost
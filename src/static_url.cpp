@@ -45,6 +45,7 @@ static_url_base::
 clear_impl() noexcept
 {
     impl_ = {from::url};
+    ++gen_;
     s_[0] = '\0';
     impl_.cs_ = s_;
 }
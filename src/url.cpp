@@ -50,6 +50,7 @@ url(url&& u) noexcept
     u.s_ = nullptr;
     u.cap_ = 0;
     u.impl_ = {from::url};
+    ++u.gen_;
 }
 
 url&
@@ -59,11 +60,13 @@ operator=(url&& u) noexcept
     if(s_)
         deallocate(s_);
     impl_ = u.impl_;
+    ++gen_;
     s_ = u.s_;
     cap_ = u.cap_;
     u.s_ = nullptr;
     u.cap_ = 0;
     u.impl_ = {from::url};
+    ++u.gen_;
     return *this;
 }
 
@@ -93,6 +96,7 @@ clear_impl() noexcept
     {
         // preserve capacity
         impl_ = {from::url};
+        ++gen_;
         s_[0] = '\0';
         impl_.cs_ = s_;
     }
@@ -158,6 +162,8 @@ swap(url& other) noexcept
     std::swap(s_, other.s_);
     std::swap(cap_, other.cap_);
     std::swap(impl_, other.impl_);
+    ++gen_;
+    ++other.gen_;
     std::swap(pi_, other.pi_);
     if (pi_ == &other.impl_)
         pi_ = &impl_;
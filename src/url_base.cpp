@@ -56,6 +56,7 @@ op_t::
 {
     if(old)
         u.cleanup(*this);
+    ++u.gen_;
     u.check_invariants();
 }
 
@@ -1314,6 +1315,22 @@ encoded_segments() noexcept
     return {*this};
 }
 
+segments_view
+url_base::
+segments() const noexcept
+{
+    return segments_view(
+        detail::path_ref(impl_, &gen_));
+}
+
+segments_encoded_view
+url_base::
+encoded_segments() const noexcept
+{
+    return segments_encoded_view(
+        detail::path_ref(impl_, &gen_));
+}
+
 //------------------------------------------------
 //
 // Query
@@ -1411,6 +1428,24 @@ encoded_params() noexcept
     return {*this};
 }
 
+params_view
+url_base::
+params() const noexcept
+{
+    return params_view(
+        detail::query_ref(impl_, &gen_),
+        encoding_opts{
+            true, false, false});
+}
+
+params_encoded_view
+url_base::
+encoded_params() const noexcept
+{
+    return params_encoded_view(
+        detail::query_ref(impl_, &gen_));
+}
+
 url_base&
 url_base::
 set_params(
@@ -2090,6 +2125,7 @@ set_scheme_impl(
         impl_.set_size(
             id_path,
             impl_.len(id_path) - 2);
+        impl_.decoded_[id_path] -= 2;
         s_[size()] = '\0';
     }
 
@@ -2430,6 +2466,23 @@ edit_segments(
             prefix = 2 + absolute;
         }
     }
+    else if(
+        it1.index == 0 &&
+        impl_.nseg_ > 0)
+    {
+        // first segment unchanged,
+        // it1 is not on a '/'
+        auto const s = it1.dereference();
+        if(s.empty())
+            prefix = 2 + absolute;
+        else if(absolute)
+            prefix = 1;
+        else if(has_scheme() ||
+                ! s.contains(':'))
+            prefix = 0;
+        else
+            prefix = 2;
+    }
     else
     {
         // first segment from it1
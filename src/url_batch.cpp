@@ -0,0 +1,397 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_batch.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/parse.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+// the components have been validated,
+// so the decoded size follows from
+// the number of escapes
+pct_string_view
+make_pct(core::string_view s) noexcept
+{
+    std::size_t n = s.size();
+    for(char c : s)
+        if(c == '%')
+            n -= 2;
+    return make_pct_string_view_unsafe(
+        s.data(), s.size(), n);
+}
+
+template<class F>
+void
+for_each_line(
+    core::string_view lines,
+    F const& f)
+{
+    char const* it = lines.data();
+    char const* const end =
+        it + lines.size();
+    while(it != end)
+    {
+        auto p = static_cast<char const*>(
+            std::memchr(it, '\n', end - it));
+        char const* const eol =
+            p ? p : end;
+        std::size_t n = eol - it;
+        if( n > 0 &&
+            it[n - 1] == '\r')
+            --n;
+        f(core::string_view(it, n));
+        if(! p)
+            break;
+        it = p + 1;
+    }
+}
+
+} // (anon)
+
+void
+url_batch::
+reserve(std::size_t n)
+{
+    // data_ goes last: push checks only
+    // its capacity, so every other column
+    // must have room once data_ does
+    for(auto& v : offset_)
+        v.reserve(n);
+    port_number_.reserve(n);
+    host_type_.reserve(n);
+    scheme_.reserve(n);
+    flags_.reserve(n);
+    data_.reserve(n);
+}
+
+void
+url_batch::
+clear() noexcept
+{
+    data_.clear();
+    for(auto& v : offset_)
+        v.clear();
+    port_number_.clear();
+    host_type_.clear();
+    scheme_.clear();
+    flags_.clear();
+    errors_.clear();
+}
+
+system::error_code
+url_batch::
+error(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(i < size());
+    if(has_value(i))
+        return {};
+    auto it = std::lower_bound(
+        errors_.begin(), errors_.end(), i,
+        [](std::pair<std::size_t,
+            system::error_code> const& e,
+           std::size_t j)
+        {
+            return e.first < j;
+        });
+    BOOST_ASSERT(
+        it != errors_.end() &&
+        it->first == i);
+    return it->second;
+}
+
+core::string_view
+url_batch::
+buffer(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(i < size());
+    return core::string_view(
+        data_[i], offset_[id_end][i]);
+}
+
+url_view
+url_batch::
+view(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    auto rv = (flags_[i] & reference_)
+        ? parse_uri_reference(buffer(i))
+        : parse_uri(buffer(i));
+    BOOST_ASSERT(rv.has_value());
+    return *rv;
+}
+
+core::string_view
+url_batch::
+scheme(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    auto s = get(i, id_scheme, id_user);
+    if(! s.empty())
+    {
+        BOOST_ASSERT(s.ends_with(':'));
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+bool
+url_batch::
+has_authority(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    return offset(i, id_pass) >
+        offset(i, id_user);
+}
+
+pct_string_view
+url_batch::
+encoded_userinfo(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    auto s = get(i, id_user, id_host);
+    if(s.empty())
+        return s;
+    // leading "//"
+    s.remove_prefix(2);
+    if(s.empty())
+        return s;
+    // trailing '@'
+    BOOST_ASSERT(s.ends_with('@'));
+    s.remove_suffix(1);
+    return make_pct(s);
+}
+
+pct_string_view
+url_batch::
+encoded_host(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    return make_pct(
+        get(i, id_host, id_port));
+}
+
+bool
+url_batch::
+has_port(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    return offset(i, id_path) >
+        offset(i, id_port);
+}
+
+core::string_view
+url_batch::
+port(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    auto s = get(i, id_port, id_path);
+    if(! s.empty())
+        s.remove_prefix(1);
+    return s;
+}
+
+pct_string_view
+url_batch::
+encoded_path(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    return make_pct(
+        get(i, id_path, id_query));
+}
+
+bool
+url_batch::
+has_query(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    return offset(i, id_frag) >
+        offset(i, id_query);
+}
+
+pct_string_view
+url_batch::
+encoded_query(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    auto s = get(i, id_query, id_frag);
+    if(! s.empty())
+        s.remove_prefix(1);
+    return make_pct(s);
+}
+
+bool
+url_batch::
+has_fragment(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    return offset(i, id_end) >
+        offset(i, id_frag);
+}
+
+pct_string_view
+url_batch::
+encoded_fragment(std::size_t i) const noexcept
+{
+    BOOST_ASSERT(has_value(i));
+    auto s = get(i, id_frag, id_end);
+    if(! s.empty())
+        s.remove_prefix(1);
+    return make_pct(s);
+}
+
+//------------------------------------------------
+
+std::size_t
+url_batch::
+offset(
+    std::size_t i,
+    int id) const noexcept
+{
+    return id == id_scheme
+        ? 0
+        : offset_[id][i];
+}
+
+core::string_view
+url_batch::
+get(
+    std::size_t i,
+    int first,
+    int last) const noexcept
+{
+    auto const pos = offset(i, first);
+    return core::string_view(
+        data_[i] + pos,
+        offset(i, last) - pos);
+}
+
+void
+url_batch::
+push(
+    core::string_view s,
+    bool reference)
+{
+    system::result<url_view> rv;
+    if( s.size() > url_view::max_size() ||
+        s.size() > (std::numeric_limits<
+            std::uint32_t>::max)())
+    {
+        rv = BOOST_URL_ERR(error::no_space);
+        s = {};
+    }
+    else if(reference)
+    {
+        rv = parse_uri_reference(s);
+    }
+    else
+    {
+        rv = parse_uri(s);
+    }
+
+    // make room in every column first,
+    // so the columns stay the same size
+    auto const n = size() + 1;
+    if(n > data_.capacity())
+        reserve((std::max)(
+            2 * data_.capacity(), n));
+    if(! rv)
+        errors_.emplace_back(
+            size(), rv.error());
+
+    data_.push_back(s.data());
+    unsigned char flags =
+        reference ? reference_ : 0;
+    if(! rv)
+    {
+        for(int id = 0; id < id_end; ++id)
+            offset_[id].push_back(0);
+        offset_[id_end].push_back(
+            static_cast<std::uint32_t>(
+                s.size()));
+        port_number_.push_back(0);
+        host_type_.push_back(
+            static_cast<unsigned char>(
+                urls::host_type::none));
+        scheme_.push_back(urls::scheme::none);
+        flags_.push_back(flags | failed_);
+        return;
+    }
+    auto const& u = *rv->pi_;
+    for(int id = 0; id <= id_end; ++id)
+        offset_[id].push_back(
+            static_cast<std::uint32_t>(
+                u.offset(id)));
+    port_number_.push_back(u.port_number_);
+    host_type_.push_back(
+        static_cast<unsigned char>(
+            u.host_type_));
+    scheme_.push_back(u.scheme_);
+    flags_.push_back(flags);
+}
+
+//------------------------------------------------
+
+void
+parse_uri_batch(
+    core::string_view const* items,
+    std::size_t n,
+    url_batch& out)
+{
+    out.reserve(out.size() + n);
+    for(std::size_t i = 0; i < n; ++i)
+        out.push(items[i], false);
+}
+
+void
+parse_uri_batch(
+    core::string_view lines,
+    url_batch& out)
+{
+    for_each_line(lines,
+        [&out](core::string_view s)
+        {
+            out.push(s, false);
+        });
+}
+
+void
+parse_uri_reference_batch(
+    core::string_view const* items,
+    std::size_t n,
+    url_batch& out)
+{
+    out.reserve(out.size() + n);
+    for(std::size_t i = 0; i < n; ++i)
+        out.push(items[i], true);
+}
+
+void
+parse_uri_reference_batch(
+    core::string_view lines,
+    url_batch& out)
+{
+    for_each_line(lines,
+        [&out](core::string_view s)
+        {
+            out.push(s, true);
+        });
+}
+
+} // urls
+} // boost
@@ -0,0 +1,844 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_editor.hpp>
+#include <boost/url/encode.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/url/detail/encode.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include "detail/print.hpp"
+#include "rfc/detail/charsets.hpp"
+#include "rfc/detail/ipvfuture_rule.hpp"
+#include "rfc/detail/port_rule.hpp"
+#include "rfc/detail/scheme_rule.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+// how a pending part is applied
+enum : unsigned char
+{
+    keep = 0,   // leave the current value
+    erase,      // remove the part
+    copy,       // copy the string as-is
+    buffered,   // copy from a buffer in the editor
+    bracket,    // copy the string inside "[]"
+    plain,      // percent-encode the string
+    encoded     // re-encode the string
+};
+
+// a run of characters which is
+// kept, moved from src to dest
+struct kept
+{
+    std::size_t src;
+    std::size_t dest;
+    std::size_t n;
+};
+
+} // (anon)
+
+//------------------------------------------------
+
+url_editor&
+url_editor::
+set_scheme(core::string_view s)
+{
+    grammar::parse(
+        s, detail::scheme_rule()
+            ).value(BOOST_URL_POS);
+    scheme_.s = s;
+    scheme_.how = copy;
+    scheme_id_ = string_to_scheme(s);
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_host(core::string_view s)
+{
+    set_host_impl(s, plain, s.size());
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_encoded_host(pct_string_view s)
+{
+    set_host_impl(s, encoded, s.decoded_size());
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_port(core::string_view s)
+{
+    auto t = grammar::parse(s,
+        detail::port_rule{}
+            ).value(BOOST_URL_POS);
+    port_.s = t.str;
+    port_.how = copy;
+    if(t.has_number)
+        port_number_ = t.number;
+    else
+        port_number_ = 0;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_port_number(std::uint16_t n)
+{
+    auto p = detail::make_printed(n);
+    auto const s = p.string();
+    std::memcpy(port_buf_,
+        s.data(), s.size());
+    port_.s = core::string_view(
+        port_buf_, s.size());
+    port_.how = buffered;
+    port_number_ = n;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_path(core::string_view s)
+{
+    path_.s = s;
+    path_.dn = s.size();
+    path_.how = plain;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_encoded_path(pct_string_view s)
+{
+    path_.s = s;
+    path_.dn = s.decoded_size();
+    path_.how = encoded;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_query(core::string_view s)
+{
+    query_.s = s;
+    query_.dn = s.size();
+    query_.how = plain;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_encoded_query(pct_string_view s)
+{
+    query_.s = s;
+    query_.dn = s.decoded_size();
+    query_.how = encoded;
+    return *this;
+}
+
+url_editor&
+url_editor::
+remove_query() noexcept
+{
+    query_ = {};
+    query_.how = erase;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_fragment(core::string_view s)
+{
+    frag_.s = s;
+    frag_.dn = s.size();
+    frag_.how = plain;
+    return *this;
+}
+
+url_editor&
+url_editor::
+set_encoded_fragment(pct_string_view s)
+{
+    frag_.s = s;
+    frag_.dn = s.decoded_size();
+    frag_.how = encoded;
+    return *this;
+}
+
+url_editor&
+url_editor::
+remove_fragment() noexcept
+{
+    frag_ = {};
+    frag_.how = erase;
+    return *this;
+}
+
+//------------------------------------------------
+
+// same dispatch as url_base::set_host
+// and url_base::set_encoded_host
+void
+url_editor::
+set_host_impl(
+    core::string_view s,
+    unsigned char how,
+    std::size_t dn)
+{
+    if( s.size() > 2 &&
+        s.front() == '[' &&
+        s.back() == ']')
+    {
+        // IP-literal
+        {
+            // IPv6-address
+            auto rv = parse_ipv6_address(
+                s.substr(1, s.size() - 2));
+            if(rv)
+            {
+                auto t = rv->to_buffer(
+                    host_buf_ + 1,
+                    sizeof(host_buf_) - 2);
+                host_buf_[0] = '[';
+                host_buf_[t.size() + 1] = ']';
+                host_.s = core::string_view(
+                    host_buf_, t.size() + 2);
+                host_.dn = t.size() + 2;
+                host_.how = buffered;
+                host_type_ =
+                    urls::host_type::ipv6;
+                auto bytes = rv->to_bytes();
+                std::memcpy(ip_addr_,
+                    bytes.data(), bytes.size());
+                return;
+            }
+        }
+        {
+            // IPvFuture
+            auto rv = grammar::parse(
+                s.substr(1, s.size() - 2),
+                    detail::ipvfuture_rule);
+            if(rv)
+            {
+                host_.s = rv->str;
+                host_.dn = rv->str.size() + 2;
+                host_.how = bracket;
+                host_type_ =
+                    urls::host_type::ipvfuture;
+                return;
+            }
+        }
+    }
+    else if(s.size() >= 7) // "0.0.0.0"
+    {
+        // IPv4-address
+        auto rv = parse_ipv4_address(s);
+        if(rv)
+        {
+            auto t = rv->to_buffer(
+                host_buf_, sizeof(host_buf_));
+            host_.s = core::string_view(
+                host_buf_, t.size());
+            host_.dn = t.size();
+            host_.how = buffered;
+            host_type_ =
+                urls::host_type::ipv4;
+            auto bytes = rv->to_bytes();
+            std::memcpy(ip_addr_,
+                bytes.data(), bytes.size());
+            return;
+        }
+    }
+
+    // reg-name
+    host_.s = s;
+    host_.dn = dn;
+    host_.how = how;
+    host_type_ =
+        urls::host_type::name;
+}
+
+// return the string to write for a part
+core::string_view
+url_editor::
+get(
+    part const& p,
+    char const* buf) const noexcept
+{
+    if(p.how == buffered)
+        return core::string_view(
+            buf, p.s.size());
+    return p.s;
+}
+
+//------------------------------------------------
+
+url_base&
+url_editor::
+commit()
+{
+    using parts = detail::parts_base;
+    auto& u = *u_;
+    auto& impl = u.impl_;
+    url_base::op_t op(u);
+
+    // the strings to write
+    core::string_view scheme =
+        get(scheme_, nullptr);
+    core::string_view host =
+        get(host_, host_buf_);
+    core::string_view port =
+        get(port_, port_buf_);
+    core::string_view path = path_.s;
+    core::string_view query = query_.s;
+    core::string_view frag = frag_.s;
+
+    //--------------------------------------------
+    //
+    // Apply the rules of each modifier,
+    // as if called in order.
+    //
+
+    bool const has_scheme =
+        scheme_.how != keep ||
+        impl.len(parts::id_scheme) != 0;
+    bool const had_auth =
+        impl.len(parts::id_user) != 0;
+    bool const has_auth =
+        had_auth ||
+        host_.how != keep ||
+        port_.how != keep;
+
+    // a kept path loses its "./" prefix
+    // when a scheme is set, and becomes
+    // absolute when an authority is added.
+    std::size_t path_strip = 0;
+    bool path_slash = false;
+    if(path_.how == keep)
+    {
+        auto const p =
+            impl.offset(parts::id_path);
+        if( scheme_.how != keep &&
+            impl.nseg_ != 0 &&
+            u.first_segment().size() >= 2 &&
+            u.s_[p] == '.' &&
+            u.s_[p + 1] == '/')
+            path_strip = 2;
+        auto const pn =
+            impl.len(parts::id_path) - path_strip;
+        path_slash =
+            ! had_auth &&
+            has_auth &&
+            pn != 0 &&
+            u.s_[p + path_strip] != '/';
+    }
+
+    // a new path might need to have colons
+    // in its first segment re-encoded, or
+    // receive a "/" or "/." prefix.
+    core::string_view first_seg;
+    std::size_t n_reencode_colons = 0;
+    bool make_absolute = false;
+    bool add_dot_segment = false;
+    if(path_.how != keep)
+    {
+        if (!has_scheme &&
+            !has_auth &&
+            !path.starts_with('/'))
+        {
+            first_seg = path;
+            std::size_t p = path.find('/');
+            if (p != core::string_view::npos)
+                first_seg = path.substr(0, p);
+            n_reencode_colons = std::count(
+                first_seg.begin(), first_seg.end(), ':');
+        }
+        make_absolute =
+            has_auth &&
+            !path.starts_with('/') &&
+            !path.empty();
+        add_dot_segment =
+            !make_absolute &&
+            (path_.how == plain || !has_auth) &&
+            path.starts_with("//");
+    }
+
+    //--------------------------------------------
+    //
+    // Measure
+    //
+
+    encoding_opts opt;
+    encoding_opts query_opt;
+    query_opt.space_as_plus = false;
+
+    // new length of each part
+    std::size_t len[parts::id_end + 1] = {};
+    len[0] = scheme_.how == keep
+        ? impl.len(parts::id_scheme)
+        : scheme.size() + 1;
+    if(had_auth)
+    {
+        len[1 + parts::id_user] =
+            impl.len(parts::id_user);
+        len[1 + parts::id_pass] =
+            impl.len(parts::id_pass);
+    }
+    else if(has_auth)
+    {
+        len[1 + parts::id_user] = 2;
+    }
+    switch(host_.how)
+    {
+    case keep:
+        len[1 + parts::id_host] =
+            impl.len(parts::id_host);
+        break;
+    case bracket:
+        len[1 + parts::id_host] =
+            host.size() + 2;
+        break;
+    case plain:
+        len[1 + parts::id_host] =
+            encoded_size(host,
+                detail::host_chars, opt);
+        break;
+    case encoded:
+        len[1 + parts::id_host] =
+            detail::re_encoded_size_unsafe(
+                host, detail::host_chars);
+        break;
+    default:
+        len[1 + parts::id_host] =
+            host.size();
+        break;
+    }
+    len[1 + parts::id_port] =
+        port_.how == keep
+        ? impl.len(parts::id_port)
+        : port.size() + 1;
+    switch(path_.how)
+    {
+    case keep:
+        len[1 + parts::id_path] =
+            impl.len(parts::id_path) -
+            path_strip + path_slash;
+        break;
+    case plain:
+        len[1 + parts::id_path] =
+            encoded_size(path,
+                detail::path_chars, opt) +
+            make_absolute +
+            2 * n_reencode_colons +
+            2 * add_dot_segment;
+        break;
+    default:
+        len[1 + parts::id_path] =
+            detail::re_encoded_size_unsafe(
+                path, detail::path_chars) +
+            make_absolute +
+            2 * n_reencode_colons +
+            2 * add_dot_segment;
+        break;
+    }
+    switch(query_.how)
+    {
+    case keep:
+        len[1 + parts::id_query] =
+            impl.len(parts::id_query);
+        break;
+    case erase:
+        break;
+    case plain:
+        len[1 + parts::id_query] = 1 +
+            encoded_size(query,
+                detail::query_chars, query_opt);
+        break;
+    default:
+        len[1 + parts::id_query] = 1 +
+            detail::re_encoded_size_unsafe(
+                query, detail::query_chars);
+        break;
+    }
+    switch(frag_.how)
+    {
+    case keep:
+        len[1 + parts::id_frag] =
+            impl.len(parts::id_frag);
+        break;
+    case erase:
+        break;
+    case plain:
+        len[1 + parts::id_frag] = 1 +
+            encoded_size(frag,
+                detail::fragment_chars, opt);
+        break;
+    default:
+        len[1 + parts::id_frag] = 1 +
+            detail::re_encoded_size_unsafe(
+                frag, detail::fragment_chars);
+        break;
+    }
+
+    // new offset of each part
+    std::size_t off[parts::id_end + 2] = {};
+    for(int i = 1; i <= parts::id_end + 1; ++i)
+        off[i] = off[i - 1] + len[i - 1];
+    std::size_t const new_size =
+        off[1 + parts::id_end];
+
+    //--------------------------------------------
+    //
+    // Copy strings which refer to the url,
+    // since moving the kept parts can
+    // overwrite them.
+    //
+
+    std::string tmp;
+    {
+        auto const first = impl.cs_;
+        auto const last =
+            first + impl.offset(parts::id_end);
+        core::string_view* const ss[] = {
+            &scheme, &host, &port,
+            &path, &query, &frag };
+        auto const alias = [first, last](
+            core::string_view const& s)
+        {
+            return
+                s.data() &&
+                ! std::less<char const*>()(
+                    s.data(), first) &&
+                std::less<char const*>()(
+                    s.data(), last);
+        };
+        std::size_t n = 0;
+        for(auto s : ss)
+            if(alias(*s))
+                n += s->size();
+        if(n > 0)
+        {
+            tmp.reserve(n);
+            for(auto s : ss)
+            {
+                if(! alias(*s))
+                    continue;
+                auto const pos = tmp.size();
+                tmp.append(s->data(), s->size());
+                *s = core::string_view(
+                    tmp.data() + pos, s->size());
+            }
+            if(! first_seg.empty())
+                first_seg = path.substr(
+                    0, first_seg.size());
+        }
+    }
+
+    //--------------------------------------------
+    //
+    // Move the kept parts
+    //
+
+    u.reserve_impl(new_size, op);
+
+    kept ks[parts::id_end + 1];
+    std::size_t nk = 0;
+    auto const keep_run = [&](
+        int first, int last,
+        std::size_t skip,
+        std::size_t dest)
+    {
+        auto const src =
+            impl.offset(first) + skip;
+        auto const n =
+            impl.len(first, last) - skip;
+        if(n != 0 && src != dest)
+            ks[nk++] = { src, dest, n };
+    };
+    if(scheme_.how == keep)
+        keep_run(parts::id_scheme,
+            parts::id_user, 0, off[0]);
+    if(had_auth)
+        keep_run(parts::id_user,
+            parts::id_host, 0,
+            off[1 + parts::id_user]);
+    if(host_.how == keep)
+        keep_run(parts::id_host,
+            parts::id_port, 0,
+            off[1 + parts::id_host]);
+    if(port_.how == keep)
+        keep_run(parts::id_port,
+            parts::id_path, 0,
+            off[1 + parts::id_port]);
+    if(path_.how == keep)
+        keep_run(parts::id_path,
+            parts::id_query, path_strip,
+            off[1 + parts::id_path] +
+                path_slash);
+    if(query_.how == keep)
+        keep_run(parts::id_query,
+            parts::id_frag, 0,
+            off[1 + parts::id_query]);
+    if(frag_.how == keep)
+        keep_run(parts::id_frag,
+            parts::id_end, 0,
+            off[1 + parts::id_frag]);
+
+    // Runs moving left go first, in
+    // order, then runs moving right, in
+    // reverse order, so that no run is
+    // overwritten before it is moved.
+    for(std::size_t i = 0; i < nk; ++i)
+        if(ks[i].dest < ks[i].src)
+            op.move(u.s_ + ks[i].dest,
+                u.s_ + ks[i].src, ks[i].n);
+    for(std::size_t i = nk; i-- > 0;)
+        if(ks[i].dest > ks[i].src)
+            op.move(u.s_ + ks[i].dest,
+                u.s_ + ks[i].src, ks[i].n);
+
+    //--------------------------------------------
+    //
+    // Write the new parts
+    //
+
+    auto const at = [&u, &off](int id)
+    {
+        return u.s_ + off[1 + id];
+    };
+    auto const end = [&u, &off](int id)
+    {
+        return u.s_ + off[2 + id];
+    };
+
+    if(scheme_.how != keep)
+    {
+        auto dest = at(parts::id_scheme);
+        scheme.copy(dest, scheme.size());
+        dest[scheme.size()] = ':';
+        impl.scheme_ = scheme_id_;
+    }
+
+    if(! had_auth && has_auth)
+    {
+        auto dest = at(parts::id_user);
+        dest[0] = '/';
+        dest[1] = '/';
+        impl.decoded_[parts::id_user] = 0;
+        impl.decoded_[parts::id_pass] = 0;
+    }
+
+    if(host_.how != keep)
+    {
+        auto dest = at(parts::id_host);
+        switch(host_.how)
+        {
+        case bracket:
+            *dest++ = '[';
+            dest += host.copy(dest, host.size());
+            *dest = ']';
+            break;
+        case plain:
+            encode_unsafe(
+                dest,
+                end(parts::id_host) - dest,
+                host,
+                detail::host_chars,
+                opt);
+            break;
+        case encoded:
+            detail::re_encode_unsafe(
+                dest,
+                end(parts::id_host),
+                host,
+                detail::host_chars);
+            break;
+        default:
+            host.copy(dest, host.size());
+            break;
+        }
+        impl.decoded_[parts::id_host] =
+            host_.dn;
+        impl.host_type_ = host_type_;
+        if( host_type_ == urls::host_type::ipv4 ||
+            host_type_ == urls::host_type::ipv6)
+            std::memcpy(impl.ip_addr_,
+                ip_addr_, sizeof(ip_addr_));
+    }
+
+    if(port_.how != keep)
+    {
+        auto dest = at(parts::id_port);
+        *dest++ = ':';
+        port.copy(dest, port.size());
+        impl.port_number_ = port_number_;
+    }
+
+    if(path_.how == keep)
+    {
+        if(path_slash)
+            *at(parts::id_path) = '/';
+        impl.decoded_[parts::id_path] -=
+            static_cast<detail::offset_type>(
+                path_strip);
+        impl.decoded_[parts::id_path] +=
+            path_slash;
+    }
+    else
+    {
+        auto dest = at(parts::id_path);
+        auto const last = end(parts::id_path);
+        std::size_t dn = path_.dn;
+        if (make_absolute)
+        {
+            *dest++ = '/';
+            dn += 1;
+        }
+        else if (add_dot_segment)
+        {
+            *dest++ = '/';
+            *dest++ = '.';
+            dn += 2;
+        }
+        if(path_.how == plain)
+        {
+            dest += encode_unsafe(
+                dest,
+                last - dest,
+                first_seg,
+                detail::segment_chars - ':',
+                opt);
+            dest += encode_unsafe(
+                dest,
+                last - dest,
+                path.substr(first_seg.size()),
+                detail::path_chars,
+                opt);
+        }
+        else
+        {
+            detail::re_encode_unsafe(
+                dest,
+                last,
+                first_seg,
+                detail::segment_chars - ':');
+            detail::re_encode_unsafe(
+                dest,
+                last,
+                path.substr(first_seg.size()),
+                detail::path_chars);
+        }
+        BOOST_ASSERT(dest == last);
+        impl.decoded_[parts::id_path] = dn;
+
+        if (path == "/")
+        {
+            // "/" maps to sequence {}
+            impl.nseg_ = 0;
+        }
+        else if (!path.empty())
+        {
+            if (path.starts_with("/./"))
+                path = path.substr(2);
+            // count segments as number of '/'s + 1
+            impl.nseg_ = std::count(
+                path.begin() + 1, path.end(), '/') + 1;
+        }
+        else
+        {
+            // an empty relative path maps to sequence {}
+            impl.nseg_ = 0;
+        }
+    }
+
+    if(query_.how == erase)
+    {
+        impl.nparam_ = 0;
+        impl.decoded_[parts::id_query] = 0;
+    }
+    else if(query_.how != keep)
+    {
+        auto dest = at(parts::id_query);
+        *dest++ = '?';
+        if(query_.how == plain)
+            encode_unsafe(
+                dest,
+                end(parts::id_query) - dest,
+                query,
+                detail::query_chars,
+                query_opt);
+        else
+            detail::re_encode_unsafe(
+                dest,
+                end(parts::id_query),
+                query,
+                detail::query_chars);
+        impl.nparam_ = std::count(
+            query.begin(), query.end(), '&') + 1;
+        impl.decoded_[parts::id_query] =
+            query_.dn;
+    }
+
+    if(frag_.how == erase)
+    {
+        impl.decoded_[parts::id_frag] = 0;
+    }
+    else if(frag_.how != keep)
+    {
+        auto dest = at(parts::id_frag);
+        *dest++ = '#';
+        if(frag_.how == plain)
+            encode_unsafe(
+                dest,
+                end(parts::id_frag) - dest,
+                frag,
+                detail::fragment_chars,
+                opt);
+        else
+            detail::re_encode_unsafe(
+                dest,
+                end(parts::id_frag),
+                frag,
+                detail::fragment_chars);
+        impl.decoded_[parts::id_frag] =
+            frag_.dn;
+    }
+
+    //--------------------------------------------
+    //
+    // Update the offsets
+    //
+
+    for(int i = 0; i <= parts::id_end; ++i)
+        impl.offset_[i] =
+            static_cast<detail::offset_type>(
+                off[1 + i]);
+    if(u.s_)
+        u.s_[new_size] = '\0';
+
+    *this = url_editor(u);
+    return u;
+}
+
+} // urls
+} // boost
@@ -0,0 +1,455 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/url_parser.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/rfc/authority_rule.hpp>
+#include <boost/url/rfc/pchars.hpp>
+#include <boost/url/grammar/alpha_chars.hpp>
+#include <boost/url/grammar/charset.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/url/grammar/lut_chars.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include "rfc/detail/charsets.hpp"
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+// The parser moves through these states
+// in order, skipping some of them. The
+// pending part starts at pos_.
+enum : unsigned char
+{
+    st_start,   // nothing received
+    st_scheme,  // maybe a scheme
+    st_hier,    // after the scheme
+    st_slash,   // one slash at the start of the path
+    st_auth,    // authority, after "//"
+    st_seg_nc,  // first segment of a relative-ref
+    st_path,
+    st_query,   // query, after '?'
+    st_frag,    // fragment, after '#'
+    st_done
+};
+
+constexpr
+grammar::lut_chars scheme_chars(
+    "0123456789" "+-."
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz");
+
+} // (anon)
+
+url_parser::
+url_parser() noexcept = default;
+
+url_parser::
+url_parser(
+    std::size_t n)
+{
+    buf_.reserve(n);
+}
+
+void
+url_parser::
+end_authority(
+    std::size_t n) noexcept
+{
+    // the authority is short, and its end
+    // is only known once a delimiter is
+    // received, so it is parsed in one go
+    char const* it = buf_.data() + pos_;
+    char const* const end = buf_.data() + n;
+    auto rv = grammar::parse(
+        it, end, authority_rule);
+    if(! rv)
+    {
+        ec_ = rv.error();
+        return;
+    }
+    u_.apply_authority(*rv);
+    pos_ = it - buf_.data();
+    if(u_.len(detail::parts_base::id_scheme) != 0)
+    {
+        // path-abempty
+        if(it != end)
+        {
+            ec_ = BOOST_URL_ERR(
+                grammar::error::leftover);
+            return;
+        }
+        st_ = st_path;
+        return;
+    }
+    // like relative_part_rule, the first
+    // segment of a relative-ref may follow
+    // the authority without a '/', so the
+    // rest is scanned again
+    st_ = st_seg_nc;
+}
+
+void
+url_parser::
+end_path(
+    std::size_t n) noexcept
+{
+    auto const len = n - pos_;
+    char const* p = buf_.data() + pos_;
+    std::size_t nseg = nsep_;
+    if( len != 0 &&
+        *p != '/')
+        ++nseg;
+    u_.apply_path(
+        make_pct_string_view_unsafe(
+            p, len, len - 2 * npct_),
+        nseg);
+    pos_ = n;
+    npct_ = 0;
+    nsep_ = 0;
+}
+
+void
+url_parser::
+end_query(
+    std::size_t n) noexcept
+{
+    // skip '?'
+    auto const len = n - pos_ - 1;
+    u_.apply_query(
+        make_pct_string_view_unsafe(
+            buf_.data() + pos_ + 1,
+            len, len - 2 * npct_),
+        nsep_ + 1);
+    pos_ = n;
+    npct_ = 0;
+    nsep_ = 0;
+}
+
+void
+url_parser::
+end_frag(
+    std::size_t n) noexcept
+{
+    // skip '#'
+    auto const len = n - pos_ - 1;
+    u_.apply_frag(
+        make_pct_string_view_unsafe(
+            buf_.data() + pos_ + 1,
+            len, len - 2 * npct_));
+    pos_ = n;
+    npct_ = 0;
+}
+
+void
+url_parser::
+scan(
+    char const* it,
+    char const* const end) noexcept
+{
+    char const* const base = buf_.data();
+    while(it != end)
+    {
+        if(hex_ != 0)
+        {
+            // inside a percent-escape
+            if(! grammar::hexdig_chars(*it))
+            {
+                ec_ = BOOST_URL_ERR(
+                    error::bad_pct_hexdig);
+                return;
+            }
+            --hex_;
+            ++it;
+            continue;
+        }
+        switch(st_)
+        {
+        case st_start:
+            if(grammar::alpha_chars(*it))
+            {
+                st_ = st_scheme;
+                ++it;
+                continue;
+            }
+            st_ = st_hier;
+            continue;
+
+        case st_scheme:
+            it = grammar::find_if_not(
+                it, end, scheme_chars);
+            if(it == end)
+                return;
+            if(*it == ':')
+            {
+                u_.apply_scheme(core::string_view(
+                    base, it - base));
+                ++it;
+                pos_ = it - base;
+                st_ = st_hier;
+                continue;
+            }
+            // no scheme, the characters so far
+            // are the start of the first segment
+            st_ = st_seg_nc;
+            continue;
+
+        case st_hier:
+            if(*it == '/')
+            {
+                ++nsep_;
+                ++it;
+                st_ = st_slash;
+                continue;
+            }
+            // a relative-ref has no scheme
+            st_ = pos_ == 0
+                ? st_seg_nc
+                : st_path;
+            continue;
+
+        case st_slash:
+            if(*it == '/')
+            {
+                nsep_ = 0;
+                ++it;
+                pos_ = it - base;
+                st_ = st_auth;
+                continue;
+            }
+            st_ = st_path;
+            continue;
+
+        case st_auth:
+            while(
+                *it != '/' &&
+                *it != '?' &&
+                *it != '#')
+            {
+                if(++it == end)
+                    return;
+            }
+            end_authority(it - base);
+            if(ec_.failed())
+                return;
+            it = base + pos_;
+            continue;
+
+        case st_seg_nc:
+        case st_path:
+            for(; it != end; ++it)
+            {
+                if(*it == '/')
+                {
+                    ++nsep_;
+                    st_ = st_path;
+                    continue;
+                }
+                if(! pchars(*it))
+                    break;
+                if( *it == ':' &&
+                    st_ == st_seg_nc)
+                {
+                    // ':' in the first segment
+                    // of a relative-ref
+                    ec_ = BOOST_URL_ERR(
+                        grammar::error::mismatch);
+                    return;
+                }
+            }
+            if(it == end)
+                return;
+            if(*it == '?')
+            {
+                end_path(it - base);
+                ++it;
+                st_ = st_query;
+                continue;
+            }
+            if(*it == '#')
+            {
+                end_path(it - base);
+                ++it;
+                st_ = st_frag;
+                continue;
+            }
+            break;
+
+        case st_query:
+            for(; it != end; ++it)
+            {
+                if(*it == '&')
+                {
+                    ++nsep_;
+                    continue;
+                }
+                if(! detail::query_chars(*it))
+                    break;
+            }
+            if(it == end)
+                return;
+            if(*it == '#')
+            {
+                end_query(it - base);
+                ++it;
+                st_ = st_frag;
+                continue;
+            }
+            break;
+
+        case st_frag:
+            it = grammar::find_if_not(
+                it, end, detail::fragment_chars);
+            if(it == end)
+                return;
+            break;
+
+        default:
+            BOOST_ASSERT(false);
+            return;
+        }
+
+        // only a percent-escape
+        // can continue the part
+        if(*it != '%')
+        {
+            ec_ = BOOST_URL_ERR(
+                grammar::error::mismatch);
+            return;
+        }
+        ++npct_;
+        hex_ = 2;
+        ++it;
+    }
+}
+
+system::result<void>
+url_parser::
+write(core::string_view s)
+{
+    if(ec_.failed())
+        return ec_;
+    if(st_ == st_done)
+    {
+        BOOST_URL_RETURN_EC(
+            grammar::error::leftover);
+    }
+    if(s.size() > url_view::max_size() - buf_.size())
+        detail::throw_length_error();
+    auto const n = buf_.size();
+    buf_.append(s.data(), s.size());
+    scan(
+        buf_.data() + n,
+        buf_.data() + buf_.size());
+    if(ec_.failed())
+        return ec_;
+    return {};
+}
+
+system::result<url_view>
+url_parser::
+finish() noexcept
+{
+    if(ec_.failed())
+        return ec_;
+    if(st_ == st_done)
+        return result();
+    if(hex_ != 0)
+    {
+        ec_ = BOOST_URL_ERR(
+            error::incomplete_encoding);
+        return ec_;
+    }
+    auto const n = buf_.size();
+    switch(st_)
+    {
+    case st_auth:
+        end_authority(n);
+        if(ec_.failed())
+            return ec_;
+        if(pos_ != n)
+        {
+            scan(buf_.data() + pos_,
+                buf_.data() + n);
+            if(ec_.failed())
+                return ec_;
+            if(hex_ != 0)
+            {
+                ec_ = BOOST_URL_ERR(
+                    error::incomplete_encoding);
+                return ec_;
+            }
+        }
+        end_path(n);
+        break;
+
+    case st_query:
+        end_query(n);
+        break;
+
+    case st_frag:
+        end_frag(n);
+        break;
+
+    default:
+        end_path(n);
+        break;
+    }
+    st_ = st_done;
+    return result();
+}
+
+system::result<url_view>
+url_parser::
+result() const noexcept
+{
+    if(ec_.failed())
+        return ec_;
+    if(st_ != st_done)
+    {
+        BOOST_URL_RETURN_EC(
+            grammar::error::need_more);
+    }
+    // the buffer moves when
+    // the parser is copied
+    auto u = u_;
+    u.cs_ = buf_.data();
+    return u.construct();
+}
+
+bool
+url_parser::
+is_done() const noexcept
+{
+    return st_ == st_done;
+}
+
+void
+url_parser::
+reset() noexcept
+{
+    buf_.clear();
+    u_ = detail::url_impl(
+        detail::url_impl::from::string);
+    ec_ = {};
+    pos_ = 0;
+    npct_ = 0;
+    nsep_ = 0;
+    hex_ = 0;
+    st_ = st_start;
+}
+
+} // urls
+} // boost
+
@@ -38,23 +38,48 @@ url_view_base(
 
 //------------------------------------------------
 
+namespace {
+
+using parts = detail::parts_base;
+
+template<class Hasher>
 std::size_t
-url_view_base::
-digest(std::size_t salt) const noexcept
-{
-    detail::fnv_1a h(salt);
-    detail::ci_digest(pi_->get(id_scheme), h);
-    detail::digest_encoded(pi_->get(id_user), h);
-    detail::digest_encoded(pi_->get(id_pass), h);
-    detail::ci_digest_encoded(pi_->get(id_host), h);
-    h.put(pi_->get(id_port));
+digest_impl(
+    detail::url_impl const& u,
+    bool is_path_absolute,
+    Hasher& h) noexcept
+{
+    detail::ci_digest(u.get(parts::id_scheme), h);
+    detail::digest_encoded(u.get(parts::id_user), h);
+    detail::digest_encoded(u.get(parts::id_pass), h);
+    detail::ci_digest_encoded(u.get(parts::id_host), h);
+    h.put(u.get(parts::id_port));
     detail::normalized_path_digest(
-        pi_->get(id_path), is_path_absolute(), h);
-    detail::digest_encoded(pi_->get(id_query), h);
-    detail::digest_encoded(pi_->get(id_frag), h);
+        u.get(parts::id_path), is_path_absolute, h);
+    detail::digest_encoded(u.get(parts::id_query), h);
+    detail::digest_encoded(u.get(parts::id_frag), h);
     return h.digest();
 }
 
+} // (anon)
+
+std::size_t
+url_view_base::
+digest(
+    std::size_t salt,
+    hash_algorithm alg) const noexcept
+{
+    if(alg == hash_algorithm::fnv_1a)
+    {
+        detail::fnv_1a h(salt);
+        return digest_impl(
+            *pi_, is_path_absolute(), h);
+    }
+    detail::block_hash h(salt);
+    return digest_impl(
+        *pi_, is_path_absolute(), h);
+}
+
 //------------------------------------------------
 //
 // Observers
@@ -616,7 +641,7 @@ pct_string_view
 url_view_base::
 encoded_resource() const noexcept
 {
-    auto n =
+    std::size_t n =
         pi_->decoded_[id_path] +
         pi_->decoded_[id_query] +
         pi_->decoded_[id_frag];
@@ -636,7 +661,7 @@ pct_string_view
 url_view_base::
 encoded_target() const noexcept
 {
-    auto n =
+    std::size_t n =
         pi_->decoded_[id_path] +
         pi_->decoded_[id_query];
     if(has_query())
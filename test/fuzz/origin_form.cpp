@@ -6,8 +6,10 @@
 //
 
 #include <boost/url/parse.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include <boost/url/rfc/origin_form_rule.hpp>
 #include <boost/core/detail/string_view.hpp>
-#include <boost/core/ignore_unused.hpp>
+#include <cstdlib>
 
 using namespace boost::urls;
 namespace core = boost::core;
@@ -20,7 +22,28 @@ LLVMFuzzerTestOneInput(
 {
     core::string_view s{reinterpret_cast<
         const char*>(data), size};
-    boost::ignore_unused(parse_origin_form(s));
+
+    // parse_origin_form does not use the
+    // rule, so compare the two
+    auto const rv0 = parse_origin_form(s);
+    auto const rv1 = grammar::parse(
+        s, origin_form_rule);
+    if(rv0.has_value() != rv1.has_value())
+        std::abort();
+    if(! rv0 && rv0.error() != rv1.error())
+        std::abort();
+    if(rv0 && (
+        rv0->encoded_path() != rv1->encoded_path() ||
+        rv0->encoded_path().decoded_size() !=
+            rv1->encoded_path().decoded_size() ||
+        rv0->encoded_segments().size() !=
+            rv1->encoded_segments().size() ||
+        rv0->has_query() != rv1->has_query() ||
+        rv0->encoded_query() != rv1->encoded_query() ||
+        rv0->encoded_query().decoded_size() !=
+            rv1->encoded_query().decoded_size() ||
+        rv0->encoded_params().size() !=
+            rv1->encoded_params().size()))
+        std::abort();
     return 0;
 }
-
@@ -18,9 +18,50 @@ struct limits_test
 {
     // VFALCO class url needs limit tests
 
+    void
+    testParse()
+    {
+        BOOST_TEST_EQ(url_view::max_size(), 16u);
+
+        // 16 chars
+        core::string_view s = "http://x.com/abc";
+        BOOST_TEST(parse_uri(s).has_value());
+        BOOST_TEST(parse_uri_reference(s).has_value());
+
+        // 17 chars
+        s = "http://x.com/abcd";
+        BOOST_TEST_THROWS(parse_uri(s),
+            system::system_error);
+        BOOST_TEST_THROWS(parse_uri_reference(s),
+            system::system_error);
+        BOOST_TEST_THROWS(parse_absolute_uri(s),
+            system::system_error);
+        BOOST_TEST_THROWS(parse_relative_ref(
+            "/abcdefghijklmnop"), system::system_error);
+        BOOST_TEST_THROWS(parse_origin_form(
+            "/abcdefghijklmnop"), system::system_error);
+    }
+
+    void
+    testOffsets()
+    {
+        // offsets are stored in the narrow type
+        BOOST_TEST(sizeof(detail::offset_type) == 2);
+
+        url u("http://x.com");
+        u.set_path("/abc");
+        BOOST_TEST_EQ(u.buffer(), "http://x.com/abc");
+        BOOST_TEST_EQ(u.encoded_path(), "/abc");
+        BOOST_TEST_THROWS(u.set_path("/abcd"),
+            system::system_error);
+        BOOST_TEST_EQ(u.buffer(), "http://x.com/abc");
+    }
+
     void
     run()
     {
+        testParse();
+        testOffsets();
     }
 };
 
@@ -0,0 +1,408 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/basic_url.hpp>
+
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/static_assert.hpp>
+
+#include "test_suite.hpp"
+
+#include <memory>
+#include <sstream>
+#include <type_traits>
+
+namespace boost {
+namespace urls {
+
+namespace {
+
+// Counts the bytes outstanding in an arena
+struct arena
+{
+    std::size_t used = 0;
+    std::size_t count = 0;
+};
+
+template<class T, bool Propagate = false>
+struct arena_allocator
+{
+    using value_type = T;
+    using propagate_on_container_copy_assignment =
+        std::integral_constant<bool, Propagate>;
+    using propagate_on_container_move_assignment =
+        std::integral_constant<bool, Propagate>;
+    using propagate_on_container_swap =
+        std::integral_constant<bool, Propagate>;
+
+    template<class U>
+    struct rebind
+    {
+        using other = arena_allocator<U, Propagate>;
+    };
+
+    arena* a;
+
+    explicit
+    arena_allocator(arena& a_) noexcept
+        : a(&a_)
+    {
+    }
+
+    template<class U>
+    arena_allocator(
+        arena_allocator<U, Propagate> const& other) noexcept
+        : a(other.a)
+    {
+    }
+
+    T*
+    allocate(std::size_t n)
+    {
+        a->used += n * sizeof(T);
+        ++a->count;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void
+    deallocate(T* p, std::size_t n) noexcept
+    {
+        BOOST_TEST_GE(a->used, n * sizeof(T));
+        a->used -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    friend
+    bool
+    operator==(
+        arena_allocator const& lhs,
+        arena_allocator const& rhs) noexcept
+    {
+        return lhs.a == rhs.a;
+    }
+
+    friend
+    bool
+    operator!=(
+        arena_allocator const& lhs,
+        arena_allocator const& rhs) noexcept
+    {
+        return lhs.a != rhs.a;
+    }
+};
+
+using arena_url = basic_url<
+    arena_allocator<char>>;
+
+using propagating_allocator =
+    arena_allocator<char, true>;
+
+using propagating_url = basic_url<
+    propagating_allocator>;
+
+} // (anon)
+
+struct basic_url_test
+{
+    BOOST_STATIC_ASSERT(
+        std::is_default_constructible<
+            basic_url<std::allocator<char>>>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_nothrow_move_constructible<
+            basic_url<std::allocator<char>>>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_convertible<
+            basic_url<std::allocator<char>>, url_view>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_convertible<
+            basic_url<std::allocator<char>>, url>::value);
+
+    BOOST_STATIC_ASSERT(
+        sizeof(basic_url<std::allocator<char>>) ==
+        sizeof(url) + sizeof(std::size_t));
+
+    void
+    testSpecial()
+    {
+        // basic_url()
+        {
+            basic_url<std::allocator<char>> u;
+            BOOST_TEST_EQ(*u.c_str(), '\0');
+            BOOST_TEST(u.buffer().empty());
+            BOOST_TEST_EQ(u.capacity(), 0u);
+        }
+
+        // basic_url(Allocator)
+        {
+            arena ar;
+            {
+                arena_url u{arena_allocator<char>(ar)};
+                BOOST_TEST(u.buffer().empty());
+                BOOST_TEST_EQ(ar.count, 0u);
+                BOOST_TEST(u.get_allocator() ==
+                    arena_allocator<char>(ar));
+            }
+            BOOST_TEST_EQ(ar.used, 0u);
+        }
+
+        // basic_url(core::string_view, Allocator)
+        {
+            arena ar;
+            {
+                arena_url u("http://www.example.com",
+                    arena_allocator<char>(ar));
+                BOOST_TEST_EQ(u.buffer(), "http://www.example.com");
+                BOOST_TEST_EQ(ar.count, 1u);
+                BOOST_TEST_EQ(ar.used, u.capacity() + 1);
+
+                BOOST_TEST_THROWS(
+                    arena_url("$:$", arena_allocator<char>(ar)),
+                    system::system_error);
+            }
+            BOOST_TEST_EQ(ar.used, 0u);
+        }
+
+        // basic_url(basic_url const&)
+        // basic_url(url_view_base const&, Allocator)
+        {
+            arena ar0;
+            arena ar1;
+            {
+                arena_url u0("/path/to/file.txt",
+                    arena_allocator<char>(ar0));
+                arena_url u1(u0);
+                BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+                BOOST_TEST_NE(u0.buffer().data(), u1.buffer().data());
+                BOOST_TEST(u1.get_allocator() == u0.get_allocator());
+                BOOST_TEST_EQ(ar0.count, 2u);
+
+                arena_url u2(u0, arena_allocator<char>(ar1));
+                BOOST_TEST_EQ(u2.buffer(), "/path/to/file.txt");
+                BOOST_TEST_EQ(ar1.count, 1u);
+
+                arena_url u3(url_view("/x"),
+                    arena_allocator<char>(ar1));
+                BOOST_TEST_EQ(u3.buffer(), "/x");
+                BOOST_TEST_EQ(ar1.count, 2u);
+            }
+            BOOST_TEST_EQ(ar0.used, 0u);
+            BOOST_TEST_EQ(ar1.used, 0u);
+        }
+
+        // basic_url(basic_url&&)
+        // basic_url(basic_url&&, Allocator)
+        {
+            arena ar0;
+            arena ar1;
+            {
+                arena_url u0("/path/to/file.txt",
+                    arena_allocator<char>(ar0));
+                char const* p = u0.c_str();
+                arena_url u1(std::move(u0));
+                BOOST_TEST_EQ(u1.c_str(), p);
+                BOOST_TEST(u0.buffer().empty());
+                BOOST_TEST_EQ(u0.capacity(), 0u);
+
+                // equal allocators, no copy
+                arena_url u2(std::move(u1),
+                    arena_allocator<char>(ar0));
+                BOOST_TEST_EQ(u2.c_str(), p);
+                BOOST_TEST_EQ(ar0.count, 1u);
+
+                // different allocators, copy
+                arena_url u3(std::move(u2),
+                    arena_allocator<char>(ar1));
+                BOOST_TEST_EQ(u3.buffer(), "/path/to/file.txt");
+                BOOST_TEST_NE(u3.c_str(), p);
+                BOOST_TEST_EQ(ar1.count, 1u);
+            }
+            BOOST_TEST_EQ(ar0.used, 0u);
+            BOOST_TEST_EQ(ar1.used, 0u);
+        }
+
+        // operator=(basic_url const&)
+        // operator=(url_view_base const&)
+        {
+            arena ar0;
+            arena ar1;
+            {
+                arena_url u0("/path/to/file.txt",
+                    arena_allocator<char>(ar0));
+                arena_url u1{arena_allocator<char>(ar1)};
+                u1 = u0;
+                BOOST_TEST_EQ(u1.buffer(), "/path/to/file.txt");
+                BOOST_TEST(u1.get_allocator() ==
+                    arena_allocator<char>(ar1));
+                u1 = u1;
+                BOOST_TEST_EQ(u1.buffer(), "/path/to/file.txt");
+                u1 = url_view("http://www.example.com");
+                BOOST_TEST_EQ(u1.buffer(), "http://www.example.com");
+
+                propagating_url p0("/path/to/file.txt",
+                    propagating_allocator(ar0));
+                propagating_url p1("/x",
+                    propagating_allocator(ar1));
+                p1 = p0;
+                BOOST_TEST_EQ(p1.buffer(), "/path/to/file.txt");
+                BOOST_TEST(p1.get_allocator() ==
+                    propagating_allocator(ar0));
+            }
+            BOOST_TEST_EQ(ar0.used, 0u);
+            BOOST_TEST_EQ(ar1.used, 0u);
+        }
+
+        // operator=(basic_url&&)
+        {
+            arena ar0;
+            arena ar1;
+            {
+                arena_url u0("/path/to/file.txt",
+                    arena_allocator<char>(ar0));
+                arena_url u1("/x",
+                    arena_allocator<char>(ar0));
+                char const* p = u0.c_str();
+                u1 = std::move(u0);
+                BOOST_TEST_EQ(u1.c_str(), p);
+                BOOST_TEST(u0.buffer().empty());
+
+                // different allocators, copy
+                arena_url u2{arena_allocator<char>(ar1)};
+                u2 = std::move(u1);
+                BOOST_TEST_EQ(u2.buffer(), "/path/to/file.txt");
+                BOOST_TEST_NE(u2.c_str(), p);
+                BOOST_TEST(u2.get_allocator() ==
+                    arena_allocator<char>(ar1));
+
+                // propagating allocators, move
+                propagating_url p0("/path/to/file.txt",
+                    propagating_allocator(ar0));
+                propagating_url p1("/x",
+                    propagating_allocator(ar1));
+                p = p0.c_str();
+                p1 = std::move(p0);
+                BOOST_TEST_EQ(p1.c_str(), p);
+                BOOST_TEST(p1.get_allocator() ==
+                    propagating_allocator(ar0));
+            }
+            BOOST_TEST_EQ(ar0.used, 0u);
+            BOOST_TEST_EQ(ar1.used, 0u);
+        }
+    }
+
+    void
+    testUrlBase()
+    {
+        // growth goes through the allocator
+        {
+            arena ar;
+            {
+                arena_url u("http://example.com",
+                    arena_allocator<char>(ar));
+                u.reserve(100);
+                BOOST_TEST_GE(u.capacity(), 100u);
+                BOOST_TEST_EQ(ar.used, u.capacity() + 1);
+                BOOST_TEST_EQ(u.buffer(), "http://example.com");
+                u.set_path("/path/to/a/file/which/is/rather/long.txt");
+                u.set_query("key=value&key2=value2");
+                u.set_fragment("frag");
+                for(int i = 0; i < 20; ++i)
+                    u.params().append({"k", "v"});
+                u.segments().push_back("more");
+                BOOST_TEST_EQ(ar.used, u.capacity() + 1);
+                BOOST_TEST_EQ(u.params().size(), 22u);
+                BOOST_TEST(u.has_fragment());
+            }
+            BOOST_TEST_EQ(ar.used, 0u);
+        }
+
+        // clear keeps the capacity
+        {
+            arena ar;
+            arena_url u("http://example.com",
+                arena_allocator<char>(ar));
+            auto const cap = u.capacity();
+            u.clear();
+            BOOST_TEST_EQ(u.buffer(), "");
+            BOOST_TEST_EQ(u.capacity(), cap);
+        }
+
+        // fluent api
+        {
+            basic_url<std::allocator<char>> u;
+            u.set_scheme("https")
+                .set_host("www.example.com")
+                .set_path("/index.htm")
+                .set_query("q")
+                .set_fragment("f");
+            BOOST_TEST_EQ(u.buffer(),
+                "https://www.example.com/index.htm?q#f");
+        }
+    }
+
+    void
+    testSwap()
+    {
+        arena ar;
+        {
+            arena_url u0("https://www.example.com",
+                arena_allocator<char>(ar));
+            arena_url u1("https://www.boost.org",
+                arena_allocator<char>(ar));
+            swap(u0, u1);
+            BOOST_TEST_EQ(u0.buffer(), "https://www.boost.org");
+            BOOST_TEST_EQ(u1.buffer(), "https://www.example.com");
+            u0.swap(u0);
+            BOOST_TEST_EQ(u0.buffer(), "https://www.boost.org");
+            u0.set_path("/path");
+            BOOST_TEST_EQ(u0.buffer(), "https://www.boost.org/path");
+        }
+        BOOST_TEST_EQ(ar.used, 0u);
+    }
+
+    void
+    testHash()
+    {
+        using U = basic_url<std::allocator<char>>;
+        U u0("http://example.com/%41");
+        U u1("HTTP://EXAMPLE.COM/A");
+        std::hash<U> h;
+        BOOST_TEST_EQ(h(u0), h(u1));
+        BOOST_TEST_EQ(h(u0), std::hash<url_view>()(u0));
+        h = std::hash<U>(10);
+        BOOST_TEST_EQ(h(u0), std::hash<url_view>(10)(u0));
+        h = std::hash<U>(10, hash_algorithm::fnv_1a);
+        BOOST_TEST_EQ(h(u0), h(u1));
+        BOOST_TEST_EQ(h(u0), std::hash<url_view>(
+            10, hash_algorithm::fnv_1a)(u0));
+        std::stringstream ss;
+        ss << u0;
+        BOOST_TEST_EQ(ss.str(), "http://example.com/%41");
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testUrlBase();
+        testSwap();
+        testHash();
+    }
+};
+
+TEST_SUITE(
+    basic_url_test,
+    "boost.url.basic_url");
+
+} // urls
+} // boost
@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/compiled_format.hpp>
+
+#include <boost/url/static_url.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+struct compiled_format_test
+{
+    // formatting with the compiled format
+    // gives the same url as the string
+    template <class... Args>
+    static
+    void
+    check(
+        core::string_view fmt,
+        Args const&... args)
+    {
+        url const u0 = format(fmt, args...);
+        compiled_format const cf(fmt);
+        BOOST_TEST_EQ(cf.buffer(), fmt);
+        {
+            url u1 = format(cf, args...);
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+            BOOST_TEST_EQ(u0.encoded_host(), u1.encoded_host());
+            BOOST_TEST(u0.host_type() == u1.host_type());
+            BOOST_TEST_EQ(u0.encoded_path(), u1.encoded_path());
+            BOOST_TEST_EQ(
+                u0.encoded_segments().size(),
+                u1.encoded_segments().size());
+            BOOST_TEST_EQ(
+                u0.encoded_params().size(),
+                u1.encoded_params().size());
+            BOOST_TEST_EQ(
+                u0.encoded_path().decoded_size(),
+                u1.encoded_path().decoded_size());
+        }
+        {
+            // copies of the compiled format
+            compiled_format const cf1(cf);
+            BOOST_TEST_EQ(
+                u0.buffer(),
+                format(cf1, args...).buffer());
+        }
+        {
+            // reuse a url which holds other parts
+            url u1("x://u:p@h:1/a/b?c#d");
+            format_to(u1, cf, args...);
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+            format_to(u1, cf, args...);
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+        }
+        {
+            static_url<256> u1("//host/path?query#frag");
+            format_to(u1, cf, args...);
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+        }
+        {
+            // both overloads replace the url
+            url u1("/path?query#frag");
+            url u2(u1);
+            format_to(u1, fmt, args...);
+            format_to(u2, cf, args...);
+            BOOST_TEST_EQ(u1.buffer(), u2.buffer());
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+            BOOST_TEST_EQ(
+                u0.encoded_path().decoded_size(),
+                u1.encoded_path().decoded_size());
+        }
+    }
+
+    void
+    testFormat()
+    {
+        check("");
+        check("http:");
+        check("{}:", "http");
+        check("{}://", "http");
+        check("{}:///", "http");
+        check("{}://{}", "http", "a.b");
+        check("{}://[{}]", "http", "fe80::1ff:fe23:4567:890a");
+        check("{}://[{}]:{}/{}", "http", "::1", 80, "a b");
+        check("{}:?q", "http");
+        check("{}:path:to:joe", "mailto");
+        check("{}:{}/a/{}/b", "http", 'a', 'b');
+        check("{}://{}:{}@{}:{}", "http", 'u', 'p', "a.b", 80);
+        check("{}://{}:{}@{}:{}/{}/{}/{}?{}", "http", 'u', 'p', "a.b", 80, 'a', 'b', 'c', "k=v");
+        check("{}://{}?{}#{}", "http", "a.b", 'q', 'f');
+        check("{}://{}?{}#{}", "http", "a.b", 'q');
+        check("/{}/b/{}/d?q", 'a', 'c');
+        check("a?{}#{}", 'q', 'f');
+        check("{}", "::joe:/b:");
+        check("{}:{}", "http", "//joe");
+        check("//{}", ':');
+        check("user/{}", 5678);
+        check("http{}://{}.{}.com:{}/{}/file.txt?k={}#frag-{}",
+            "s", "www", "boost", 443, "path to", "v w", "f g");
+
+        // literals with escapes
+        check("{}://h/%41/{}?%42#%43", "http", "%41");
+
+        // named and indexed arguments
+        check("{1}://{0}/{1}", "a.b", "http");
+        check("/{}/{}/{}", 'a', 'b');
+        {
+            compiled_format const cf(
+                "{scheme}://{host}:{port}/{dir}/{file}");
+            url u = format(cf,
+                arg("scheme", "https"), arg("port", 80),
+                arg("host", "example.com"), arg("dir", "path/to"),
+                arg("file", "file.txt"));
+            BOOST_TEST_EQ(u.buffer(),
+                "https://example.com:80/path/to/file.txt");
+        }
+
+        // format specs
+        check("{:^3s}", 'a');
+        check("{:.>{}s}", 'a', 5);
+        check("{:.>{1}s}", 'a', 5);
+        check("{0:.>{2}s}/{1}", 'a', 'b', 5);
+        {
+            compiled_format const cf("{:.>{b}s}/{b}");
+            BOOST_TEST_EQ(
+                format(cf, 'a', arg("b", 5)).buffer(),
+                "....a/5");
+        }
+        check("/{:.>{}d}/{}", 99, 6, 'x');
+        check("{}://{:>06d}?{:+d}#{: d}", "http", 99, 1, 2);
+
+        // initializer lists
+        {
+            compiled_format const cf(
+                "{scheme}://{host}:{port}/{dir}/{file}");
+            url u = format(cf, {
+                {"scheme", "https"}, {"port", 80},
+                {"host", "example.com"}, {"dir", "path/to"},
+                {"file", "file.txt"}});
+            BOOST_TEST_EQ(u.buffer(),
+                "https://example.com:80/path/to/file.txt");
+            static_url<64> su("a:b");
+            format_to(su, cf, {
+                {"scheme", "http"}, {"port", 8080},
+                {"host", "a.b"}, {"dir", "x"},
+                {"file", "y"}});
+            BOOST_TEST_EQ(su.buffer(),
+                "http://a.b:8080/x/y");
+        }
+    }
+
+    void
+    testErrors()
+    {
+        BOOST_TEST_THROWS(compiled_format("{:"), system::system_error);
+        BOOST_TEST_THROWS(compiled_format("{://"), system::system_error);
+        BOOST_TEST_THROWS(compiled_format("http:%"), system::system_error);
+        BOOST_TEST_THROWS(compiled_format("{}://["), system::system_error);
+        BOOST_TEST_THROWS(compiled_format("{}://{}:{}@{}:a"), system::system_error);
+
+        compiled_format const cf("{}://www.a.com");
+        BOOST_TEST_THROWS(format(cf, "1nvalid scheme"), system::system_error);
+
+        // too large
+        static_url<16> u;
+        compiled_format const cf2("http://{}");
+        BOOST_TEST_THROWS(
+            format_to(u, cf2, "a.very.long.host.name"), std::exception);
+
+        // a length error leaves the url unchanged
+        static_url<16> u2("/path?q#f");
+        BOOST_TEST_THROWS(
+            format_to(u2, cf2, "a.very.long.host.name"), std::exception);
+        BOOST_TEST_EQ(u2.buffer(), "/path?q#f");
+    }
+
+    void
+    testJavadocs()
+    {
+        // compiled_format
+        {
+        compiled_format const fmt( "https://{}/api/v1/users/{id}" );
+
+        url u = format( fmt, "example.com", arg( "id", 42 ) );
+        assert( u.buffer() == "https://example.com/api/v1/users/42" );
+
+        format_to( u, fmt, "example.org", arg( "id", 43 ) );
+        assert( u.buffer() == "https://example.org/api/v1/users/43" );
+        }
+
+        // compiled_format::compiled_format
+        {
+        compiled_format fmt( "{scheme}://{host}:{port}/{path}" );
+        boost::ignore_unused(fmt);
+        }
+
+        // format
+        {
+        compiled_format const fmt( "user/{}" );
+        assert( format( fmt, 1 ).buffer() == "user/1" );
+        }
+
+        // format_to
+        {
+        compiled_format const fmt( "user/{}" );
+        static_url<30> u;
+        format_to( u, fmt, 1 );
+        assert( u.buffer() == "user/1" );
+        }
+
+        // format, initializer_list
+        {
+        compiled_format const fmt( "user/{id}" );
+        assert( format( fmt, {{"id", 1}} ).buffer() == "user/1" );
+        }
+
+        // format_to, initializer_list
+        {
+        compiled_format const fmt( "user/{id}" );
+        static_url<30> u;
+        format_to( u, fmt, {{"id", 1}} );
+        assert( u.buffer() == "user/1" );
+        }
+    }
+
+    void
+    run()
+    {
+        testFormat();
+        testErrors();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    compiled_format_test,
+    "boost.url.compiled_format");
+
+} // urls
+} // boost
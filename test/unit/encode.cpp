@@ -12,11 +12,13 @@
 #include <boost/url/encode.hpp>
 
 #include <boost/url/rfc/pchars.hpp>
+#include <boost/url/rfc/unreserved_chars.hpp>
 #include <boost/core/ignore_unused.hpp>
 
 #include "test_suite.hpp"
 
 #include <memory>
+#include <string>
 
 #ifdef assert
 #undef assert
@@ -138,6 +140,104 @@ public:
         }
     }
 
+    // encode one character at a time
+    template<class CharSet>
+    static
+    std::string
+    reference_encode(
+        core::string_view s,
+        CharSet const& cs,
+        encoding_opts opt)
+    {
+        char const* const hex = opt.lower_case ?
+            "0123456789abcdef" : "0123456789ABCDEF";
+        std::string r;
+        for(char c : s)
+        {
+            if(cs(c))
+            {
+                r.push_back(c);
+            }
+            else if(opt.space_as_plus && c == ' ')
+            {
+                r.push_back('+');
+            }
+            else
+            {
+                auto const u =
+                    static_cast<unsigned char>(c);
+                r.push_back('%');
+                r.push_back(hex[u >> 4]);
+                r.push_back(hex[u & 0xf]);
+            }
+        }
+        return r;
+    }
+
+    template<class CharSet>
+    void
+    check_runs(
+        core::string_view s,
+        CharSet const& cs)
+    {
+        for(int i = 0; i < 4; ++i)
+        {
+            encoding_opts opt(
+                (i & 1) != 0, (i & 2) != 0);
+            std::string const m =
+                reference_encode(s, cs, opt);
+            BOOST_TEST_EQ(
+                encoded_size(s, cs, opt), m.size());
+            BOOST_TEST_EQ(
+                encode(s, cs, opt, {}), m);
+
+            // every buffer size up to the
+            // full size stops on a character
+            if(m.size() > 40)
+                continue;
+            std::string buf(m.size() + 1, '\0');
+            for(std::size_t n = 0; n <= m.size(); ++n)
+            {
+                auto const k = encode(
+                    &buf[0], n, s, cs, opt);
+                BOOST_TEST_LE(k, n);
+                BOOST_TEST_GE(k + 2, n);
+                BOOST_TEST_EQ(
+                    core::string_view(buf.data(), k),
+                    core::string_view(m).substr(0, k));
+            }
+        }
+    }
+
+    void
+    testRuns()
+    {
+        // long runs of unreserved characters
+        // with reserved ones planted at every
+        // position, for a lut_chars and for
+        // an arbitrary predicate
+        std::string s;
+        for(std::size_t n = 0; n <= 70; ++n)
+        {
+            s.assign(n, 'A');
+            check_runs(s, unreserved_chars);
+            check_runs(s, test_chars{});
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                for(char c : { ' ', '%', '\xe2' })
+                {
+                    s[i] = c;
+                    check_runs(s, pchars);
+                    s[i] = 'A';
+                }
+            }
+        }
+        check_runs(
+            "caf\xc3\xa9 au lait, s'il vous pla\xc3\xaet "
+            "| \xe2\x82\xac 3.50 + tip ~ 10% ok?",
+            unreserved_chars);
+    }
+
     void
     testJavadocs()
     {
@@ -160,6 +260,7 @@ public:
     {
         testEncode();
         testEncodeExtras();
+        testRuns();
         testJavadocs();
     }
 };
@@ -16,6 +16,8 @@
 
 #include "test_suite.hpp"
 
+#include <string>
+
 namespace boost {
 namespace urls {
 
@@ -249,10 +251,123 @@ struct router_test
         BOOST_TEST_THROWS(r.insert(pattern, 0), system::system_error);
     };
 
+    static
+    void
+    testManyRoutes()
+    {
+        // literal children are searched
+        // among many siblings
+        router<int> r;
+        for (int i = 0; i < 300; ++i)
+        {
+            r.insert("api/res" + std::to_string(i), 3 * i);
+            r.insert("api/res" + std::to_string(i) + "/{id}", 3 * i + 1);
+            r.insert("api/res" + std::to_string(i) + "/{id}/{rest+}", 3 * i + 2);
+        }
+        r.insert("api/%E2%82%AC", 1000);
+        r.insert("api/a%20b", 1001);
+        r.insert("api/{name}/x", 1002);
+
+        matches m;
+        for (int i = 0; i < 300; i += 7)
+        {
+            auto const res = "/api/res" + std::to_string(i);
+            int const* v = r.find(parse_path(res).value(), m);
+            if (BOOST_TEST(v))
+                BOOST_TEST_EQ(*v, 3 * i);
+            auto const id = res + "/42";
+            v = r.find(parse_path(id).value(), m);
+            if (BOOST_TEST(v))
+            {
+                BOOST_TEST_EQ(*v, 3 * i + 1);
+                BOOST_TEST_EQ(m["id"], "42");
+            }
+            auto const rest = res + "/42/a/b";
+            v = r.find(parse_path(rest).value(), m);
+            if (BOOST_TEST(v))
+            {
+                BOOST_TEST_EQ(*v, 3 * i + 2);
+                BOOST_TEST_EQ(m["rest"], "a/b");
+            }
+        }
+
+        // decoded comparisons
+        int const* v = r.find(parse_path("/api/%E2%82%AC").value(), m);
+        if (BOOST_TEST(v))
+            BOOST_TEST_EQ(*v, 1000);
+        v = r.find(parse_path("/api/a%20b").value(), m);
+        if (BOOST_TEST(v))
+            BOOST_TEST_EQ(*v, 1001);
+        v = r.find(parse_path("/api/%72es1").value(), m);
+        if (BOOST_TEST(v))
+            BOOST_TEST_EQ(*v, 3);
+
+        // a literal which is not found
+        // falls back to the fields
+        v = r.find(parse_path("/api/res1000/x").value(), m);
+        if (BOOST_TEST(v))
+        {
+            BOOST_TEST_EQ(*v, 1002);
+            BOOST_TEST_EQ(m["name"], "res1000");
+        }
+        v = r.find(parse_path("/api/res1000").value(), m);
+        BOOST_TEST_NOT(v);
+        BOOST_TEST(m.empty());
+    }
+
+    static
+    void
+    testSnapshot()
+    {
+        // empty
+        {
+            router_snapshot<int> s;
+            matches m;
+            BOOST_TEST_NOT(s.find(parse_path("/a").value(), m));
+            router<int> r;
+            BOOST_TEST_NOT(r.find(parse_path("/a").value(), m));
+            BOOST_TEST_NOT(r.find(parse_path("").value(), m));
+            BOOST_TEST_NOT(r.snapshot().find(parse_path("/a").value(), m));
+        }
+
+        // snapshots do not see later
+        // insertions and outlive the router
+        {
+            router_snapshot<int> s1;
+            router_snapshot<int> s2;
+            {
+                router<int> r;
+                r.insert("user/{name}", 1);
+                s1 = r.snapshot();
+                r.insert("user/view", 2);
+                s2 = r.snapshot();
+                matches m;
+                int const* v = r.find(parse_path("/user/view").value(), m);
+                if (BOOST_TEST(v))
+                    BOOST_TEST_EQ(*v, 2);
+            }
+            matches m;
+            int const* v = s1.find(parse_path("/user/view").value(), m);
+            if (BOOST_TEST(v))
+            {
+                BOOST_TEST_EQ(*v, 1);
+                BOOST_TEST_EQ(m["name"], "view");
+            }
+            v = s2.find(parse_path("/user/view").value(), m);
+            if (BOOST_TEST(v))
+            {
+                BOOST_TEST_EQ(*v, 2);
+                BOOST_TEST(m.empty());
+            }
+        }
+    }
+
     void
     run()
     {
         testPatterns();
+        testManyRoutes();
+        testSnapshot();
     }
 };
 
@@ -0,0 +1,343 @@
+//
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include "public_suffix_list.hpp"
+
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+
+#include "test_suite.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+struct public_suffix_list_test
+{
+    // an excerpt of public_suffix_list.dat
+    static
+    core::string_view
+    rules()
+    {
+        return
+            "// This Source Code Form is subject to the terms of the Mozilla Public\n"
+            "// ===BEGIN ICANN DOMAINS===\n"
+            "\n"
+            "// ck : https://en.wikipedia.org/wiki/.ck\n"
+            "*.ck\n"
+            "!www.ck\n"
+            "\n"
+            "// cn : https://en.wikipedia.org/wiki/.cn\n"
+            "cn\n"
+            "com.cn\n"
+            "\xe5\x85\xac\xe5\x8f\xb8.cn\r\n"
+            "\n"
+            "com\n"
+            "jp\n"
+            "ac.jp\n"
+            "*.kobe.jp\n"
+            "!city.kobe.jp\n"
+            "us\n"
+            "ak.us\n"
+            "k12.ak.us\n"
+            "uk\n"
+            "co.uk\n"
+            "// ===END ICANN DOMAINS===\n"
+            "// ===BEGIN PRIVATE DOMAINS===\n"
+            "uk.com  trailing text is ignored\n"
+            "github.io\n"
+            "// ===END PRIVATE DOMAINS===";
+    }
+
+    static
+    void
+    check(
+        public_suffix_list const& psl,
+        core::string_view host,
+        core::string_view suffix,
+        core::string_view domain)
+    {
+        BOOST_TEST_EQ(psl.public_suffix(host), suffix);
+        BOOST_TEST_EQ(psl.registrable_domain(host), domain);
+    }
+
+    void
+    testLookup()
+    {
+        public_suffix_list const psl(rules());
+        BOOST_TEST_EQ(psl.size(), 17u);
+
+        // unlisted
+        check(psl, "example", "example", "");
+        check(psl, "example.example", "example", "example.example");
+        check(psl, "b.example.example", "example", "example.example");
+
+        // listed
+        check(psl, "com", "com", "");
+        check(psl, "example.com", "com", "example.com");
+        check(psl, "a.b.example.com", "com", "example.com");
+        check(psl, "uk.com", "uk.com", "");
+        check(psl, "example.uk.com", "uk.com", "example.uk.com");
+        check(psl, "www.example.co.uk", "co.uk", "example.co.uk");
+        check(psl, "github.io", "github.io", "");
+        check(psl, "foo.github.io", "github.io", "foo.github.io");
+        check(psl, "ac.jp", "ac.jp", "");
+        check(psl, "test.ac.jp", "ac.jp", "test.ac.jp");
+        check(psl, "us", "us", "");
+        check(psl, "k12.ak.us", "k12.ak.us", "");
+        check(psl, "test.k12.ak.us", "k12.ak.us", "test.k12.ak.us");
+
+        // wildcard and exception rules
+        check(psl, "ck", "ck", "");
+        check(psl, "test.ck", "test.ck", "");
+        check(psl, "b.test.ck", "test.ck", "b.test.ck");
+        check(psl, "www.ck", "ck", "www.ck");
+        check(psl, "www.www.ck", "ck", "www.ck");
+        check(psl, "kobe.jp", "jp", "kobe.jp");
+        check(psl, "c.kobe.jp", "c.kobe.jp", "");
+        check(psl, "b.c.kobe.jp", "c.kobe.jp", "b.c.kobe.jp");
+        check(psl, "city.kobe.jp", "kobe.jp", "city.kobe.jp");
+        check(psl, "www.city.kobe.jp", "kobe.jp", "city.kobe.jp");
+
+        // case
+        check(psl, "COM", "COM", "");
+        check(psl, "WwW.Example.Co.UK", "Co.UK", "Example.Co.UK");
+
+        // internationalized names
+        check(psl,
+            "\xe9\xa3\x9f\xe7\x8b\xae.com.cn",
+            "com.cn",
+            "\xe9\xa3\x9f\xe7\x8b\xae.com.cn");
+        check(psl,
+            "www.\xe9\xa3\x9f\xe7\x8b\xae.\xe5\x85\xac\xe5\x8f\xb8.cn",
+            "\xe5\x85\xac\xe5\x8f\xb8.cn",
+            "\xe9\xa3\x9f\xe7\x8b\xae.\xe5\x85\xac\xe5\x8f\xb8.cn");
+        check(psl,
+            "a.%E5%85%AC%e5%8f%b8.cn",
+            "%E5%85%AC%e5%8f%b8.cn",
+            "a.%E5%85%AC%e5%8f%b8.cn");
+        check(psl, "a.%63om", "%63om", "a.%63om");
+
+        // empty labels
+        check(psl, "", "", "");
+        check(psl, ".", "", "");
+        check(psl, "..", "", "");
+        check(psl, ".com", "com", "");
+        check(psl, "a..com", "com", "");
+        check(psl, "www.example.com.", "com", "example.com");
+    }
+
+    void
+    testRules()
+    {
+        // no rules
+        {
+            public_suffix_list const psl;
+            BOOST_TEST_EQ(psl.size(), 0u);
+            check(psl, "a.b.c", "c", "b.c");
+            check(psl, "c", "c", "");
+        }
+
+        // duplicate and unsupported rules
+        {
+            public_suffix_list const psl(
+                "com\nCOM\n*.com\n*.com\n"
+                "a.*.b\n*\n!\n.c\nd.\ne..f\n");
+            BOOST_TEST_EQ(psl.size(), 2u);
+            check(psl, "x.com", "x.com", "");
+            check(psl, "y.x.com", "x.com", "y.x.com");
+            check(psl, "a.x.b", "b", "x.b");
+            check(psl, "c.d", "d", "c.d");
+        }
+
+        // no trailing newline
+        {
+            public_suffix_list const psl("a.b");
+            BOOST_TEST_EQ(psl.size(), 1u);
+            check(psl, "x.a.b", "a.b", "x.a.b");
+        }
+    }
+
+    void
+    testImage()
+    {
+        public_suffix_list const psl0(rules());
+        std::vector<std::uint32_t> buf;
+        auto const copy = [&buf](core::string_view s)
+        {
+            buf.assign((s.size() + 3) / 4, 0);
+            std::memcpy(buf.data(), s.data(), s.size());
+            return buf.data();
+        };
+
+        // round trip
+        {
+            auto const s = psl0.image();
+            auto rv = public_suffix_list::load(
+                copy(s), s.size());
+            if(BOOST_TEST(rv.has_value()))
+            {
+                public_suffix_list const& psl = *rv;
+                BOOST_TEST_EQ(psl.size(), psl0.size());
+                BOOST_TEST_EQ(psl.image(), s);
+                BOOST_TEST(
+                    psl.image().data() ==
+                    reinterpret_cast<char const*>(buf.data()));
+                check(psl, "www.example.co.uk", "co.uk", "example.co.uk");
+                check(psl, "b.c.kobe.jp", "c.kobe.jp", "b.c.kobe.jp");
+                check(psl, "www.city.kobe.jp", "kobe.jp", "city.kobe.jp");
+
+                // copies refer to the same image
+                public_suffix_list const psl1(psl);
+                BOOST_TEST(
+                    psl1.image().data() == psl.image().data());
+                check(psl1, "www.ck", "ck", "www.ck");
+            }
+        }
+
+        // copies of an owned image
+        {
+            public_suffix_list psl1(psl0);
+            BOOST_TEST(
+                psl1.image().data() != psl0.image().data());
+            check(psl1, "www.ck", "ck", "www.ck");
+            public_suffix_list psl2(std::move(psl1));
+            check(psl2, "www.ck", "ck", "www.ck");
+            psl1 = psl2;
+            check(psl1, "www.ck", "ck", "www.ck");
+        }
+
+        // empty list
+        {
+            public_suffix_list const psl1;
+            auto const s = psl1.image();
+            auto rv = public_suffix_list::load(
+                copy(s), s.size());
+            if(BOOST_TEST(rv.has_value()))
+            {
+                BOOST_TEST_EQ(rv->size(), 0u);
+                check(*rv, "a.b.c", "c", "b.c");
+            }
+        }
+
+        // invalid images
+        {
+            auto const s = psl0.image();
+            auto const p = copy(s);
+            auto const b = reinterpret_cast<char*>(p);
+
+            // truncated
+            BOOST_TEST(public_suffix_list::load(
+                p, 0).has_error());
+            BOOST_TEST(public_suffix_list::load(
+                p, 31).has_error());
+            BOOST_TEST(public_suffix_list::load(
+                p, s.size() - 1).has_error());
+
+            // misaligned
+            BOOST_TEST(public_suffix_list::load(
+                b + 1, s.size() - 1).has_error());
+
+            // every byte of the image
+            // is covered by the header
+            // or by the checksum
+            for(std::size_t i = 0; i < s.size(); ++i)
+            {
+                b[i] ^= 0x40;
+                BOOST_TEST(public_suffix_list::load(
+                    p, s.size()).has_error());
+                b[i] ^= 0x40;
+            }
+            BOOST_TEST(public_suffix_list::load(
+                p, s.size()).has_value());
+        }
+    }
+
+    void
+    testUrl()
+    {
+        public_suffix_list const psl(rules());
+        {
+            url_view u("https://user@www.example.co.uk:443/index.htm");
+            BOOST_TEST_EQ(psl.public_suffix(u), "co.uk");
+            BOOST_TEST_EQ(psl.registrable_domain(u), "example.co.uk");
+            BOOST_TEST(
+                psl.registrable_domain(u).data() >=
+                u.buffer().data());
+        }
+        {
+            url u("https://a.b.github.io/");
+            BOOST_TEST_EQ(psl.public_suffix(u), "github.io");
+            BOOST_TEST_EQ(psl.registrable_domain(u), "b.github.io");
+        }
+        {
+            url_view u("https://127.0.0.1/");
+            BOOST_TEST(psl.public_suffix(u).empty());
+            BOOST_TEST(psl.registrable_domain(u).empty());
+        }
+        {
+            url_view u("https://[::1]/");
+            BOOST_TEST(psl.public_suffix(u).empty());
+            BOOST_TEST(psl.registrable_domain(u).empty());
+        }
+        {
+            url_view u("/path/to/file.txt");
+            BOOST_TEST(psl.public_suffix(u).empty());
+            BOOST_TEST(psl.registrable_domain(u).empty());
+        }
+    }
+
+    void
+    testJavadocs()
+    {
+        // public_suffix_list
+        {
+        public_suffix_list const psl( "com\nuk\nco.uk\n" );
+        url_view u( "https://www.example.co.uk/index.htm" );
+        assert( psl.public_suffix( u ) == "co.uk" );
+        assert( psl.registrable_domain( u ) == "example.co.uk" );
+        }
+
+        // load
+        {
+        public_suffix_list const psl0( "com\nuk\nco.uk\n" );
+        std::string const s( psl0.image() );
+        // ... save s, and later
+        auto rv = public_suffix_list::load( s.data(), s.size() );
+        assert( rv->public_suffix( "www.example.co.uk" ) == "co.uk" );
+        }
+    }
+
+    void
+    run()
+    {
+        testLookup();
+        testRules();
+        testImage();
+        testUrl();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    public_suffix_list_test,
+    "boost.url.public_suffix_list");
+
+} // urls
+} // boost
@@ -765,6 +765,24 @@ struct format_test
             static_url<10> u;
             BOOST_TEST_THROWS(urls::format_to(u, "{}://{}", "https", "www.boost.org"), system::system_error);
         }
+        {
+            // previous contents are replaced
+            static_url<64> u("/path?query#frag");
+            urls::format_to(u, "{}://{}", "https", "www.boost.org");
+            BOOST_TEST_CSTR_EQ(u.buffer(), "https://www.boost.org");
+            BOOST_TEST_NOT(u.has_query());
+            BOOST_TEST_NOT(u.has_fragment());
+        }
+        {
+            // the url is unchanged on error
+            static_url<16> u("/path?query#frag");
+            BOOST_TEST_THROWS(urls::format_to(u, "{}://{}", "https", "www.boost.org"), system::system_error);
+            BOOST_TEST_CSTR_EQ(u.buffer(), "/path?query#frag");
+            url u2("/path?query#frag");
+            BOOST_TEST_THROWS(urls::format_to(u2, "{}://{}", "1nvalid scheme", "www.boost.org"), system::system_error);
+            BOOST_TEST_CSTR_EQ(u2.buffer(), "/path?query#frag");
+            BOOST_TEST_CSTR_EQ(u2.query(), "query");
+        }
 
 
         // escaped '{' always throws because '{'s are not allowed in URLs
@@ -864,6 +882,55 @@ struct format_test
                 "https://joe.gigantic-server.com:80/v2/index.html");
         }
 
+        // output larger than the inline buffer
+        {
+            std::string s(300, ' ');
+            std::string e;
+            for (int i = 0; i < 300; ++i)
+                e += "%20";
+            url u = urls::format("http://{}.com/{}?{}#{}", s, s, s, s);
+            BOOST_TEST_CSTR_EQ(u.encoded_host(), e + ".com");
+            BOOST_TEST_CSTR_EQ(u.encoded_path(), "/" + e);
+            BOOST_TEST_CSTR_EQ(u.encoded_query(), e);
+            BOOST_TEST_CSTR_EQ(u.encoded_fragment(), e);
+            BOOST_TEST_EQ(u.host().size(), 304u);
+            BOOST_TEST_EQ(u.query().size(), 300u);
+        }
+        {
+            url u = urls::format("/{:^400s}/{:0>{}}", 'a', 7, 300);
+            BOOST_TEST_EQ(u.encoded_path().size(), 1 + 3 * 399 + 1 + 1 + 300);
+            BOOST_TEST(u.encoded_path().ends_with("0007"));
+        }
+        {
+            std::string t;
+            for (int i = 0; i < 50; ++i)
+                t += "/{}-{}";
+            url u = urls::format(t,
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5,
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5,
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5,
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5,
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5,
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5,
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5,
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5,
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5,
+                "a", 1, "b", 2, "c", 3, "d", 4, "e", 5);
+            BOOST_TEST_EQ(u.segments().size(), 50u);
+            BOOST_TEST(u.encoded_path().starts_with("/a-1/b-2/c-3/d-4/e-5/a-1"));
+        }
+        {
+            url u = urls::format("http://h?{}", "");
+            BOOST_TEST_CSTR_EQ(u.buffer(), "http://h?");
+            BOOST_TEST_EQ(u.params().size(), 1u);
+            BOOST_TEST_EQ(u.encoded_params().size(), 1u);
+        }
+        {
+            url u = urls::format("http://[{}]:{}/", "v1.x", 8080);
+            BOOST_TEST_CSTR_EQ(u.buffer(), "http://[v1.x]:8080/");
+            BOOST_TEST(u.host_type() == host_type::ipvfuture);
+            BOOST_TEST_EQ(u.port_number(), 8080);
+        }
     }
 
     void
@@ -12,6 +12,10 @@
 
 #include <boost/url/grammar/parse.hpp>
 #include <boost/url/grammar/token_rule.hpp>
+#include <boost/url/rfc/pchars.hpp>
+#include <boost/url/rfc/unreserved_chars.hpp>
+#include <cstdint>
+#include <string>
 
 #include "test_rule.hpp"
 
@@ -71,6 +75,142 @@ struct lut_chars_test
         }
     }
 
+    // rebuild the mask from the public interface
+    static
+    void
+    make_mask(
+        lut_chars const& cs,
+        std::uint64_t* mask)
+    {
+        for(int i = 0; i < 4; ++i)
+            mask[i] = 0;
+        for_each_char(
+        [&](char c)
+        {
+            auto const u = static_cast<
+                unsigned char>(c);
+            if(cs(c))
+                mask[detail::lut_word(u)] |=
+                    detail::lut_bit(u);
+        });
+    }
+
+    // compare each kernel with the
+    // byte-by-byte predicate loop
+    void
+    check_kernels(
+        lut_chars const& cs,
+        core::string_view s)
+    {
+        std::uint64_t mask[4];
+        make_mask(cs, mask);
+        auto const first = s.data();
+        auto const last = first + s.size();
+        std::size_t n = 0;
+        for(char c : s)
+            n += cs(c);
+        BOOST_TEST_EQ(cs.count(first, last), n);
+        for(auto isa : {
+            detail::lut_isa::scalar,
+            detail::lut_isa::ssse3,
+            detail::lut_isa::avx2,
+            detail::lut_isa::neon })
+        {
+            auto f0 = detail::lut_find_if_kernel(isa);
+            auto f1 = detail::lut_find_if_not_kernel(isa);
+            auto f2 = detail::lut_count_kernel(isa);
+            if(! f0 || ! f1 || ! f2)
+            {
+                BOOST_TEST(isa != detail::lut_isa::scalar);
+                continue;
+            }
+            BOOST_TEST_EQ(f2(mask, first, last), n);
+            BOOST_TEST(f0(mask, first, last) ==
+                detail::find_if(first, last, cs,
+                    std::false_type{}));
+            BOOST_TEST(f1(mask, first, last) ==
+                detail::find_if_not(first, last, cs,
+                    std::false_type{}));
+        }
+        BOOST_TEST(grammar::find_if(first, last, cs) ==
+            detail::find_if(first, last, cs,
+                std::false_type{}));
+        BOOST_TEST(grammar::find_if_not(first, last, cs) ==
+            detail::find_if_not(first, last, cs,
+                std::false_type{}));
+    }
+
+    void
+    testKernels()
+    {
+        // lut_chars layout
+        {
+            std::uint64_t mask[4];
+            make_mask(pchars, mask);
+            for_each_char(
+            [&](char c)
+            {
+                auto const u = static_cast<
+                    unsigned char>(c);
+                BOOST_TEST_EQ(pchars(c), (
+                    mask[detail::lut_word(u)] &
+                        detail::lut_bit(u)) != 0);
+            });
+        }
+
+        constexpr lut_chars high_chars(
+            "\x80\x9f\xa0\xff");
+        lut_chars const sets[] = {
+            pchars,
+            unreserved_chars,
+            lut_chars("aeiou"),
+            high_chars,
+            ~high_chars,
+            ~lut_chars(""),
+            lut_chars("") };
+
+        std::uint32_t seed = 1;
+        auto rand = [&seed]
+        {
+            seed = seed * 1103515245u + 12345u;
+            return static_cast<unsigned>(seed >> 16);
+        };
+
+        // every length up to a few blocks, with
+        // one planted byte at every position
+        std::string s;
+        for(auto const& cs : sets)
+        {
+            for(std::size_t n = 0; n <= 80; ++n)
+            {
+                s.assign(n, 'a');
+                check_kernels(cs, s);
+                for(std::size_t i = 0; i < n; ++i)
+                {
+                    for(char c : {
+                        '%', '/', '\0', '\x80', '\xff' })
+                    {
+                        s[i] = c;
+                        check_kernels(cs, s);
+                        s[i] = 'a';
+                    }
+                }
+            }
+        }
+
+        // random bytes, at unaligned offsets
+        s.resize(300);
+        for(int i = 0; i < 2000; ++i)
+        {
+            for(auto& c : s)
+                c = static_cast<char>(rand() & 0xff);
+            auto const& cs = sets[i % 7];
+            std::size_t const off = rand() % 33;
+            check_kernels(cs, core::string_view(
+                s).substr(off, rand() % (s.size() - off)));
+        }
+    }
+
     void
     run()
     {
@@ -84,6 +224,7 @@ struct lut_chars_test
         }
 
         test_lut_chars();
+        testKernels();
 
         // C++11
 #if 1
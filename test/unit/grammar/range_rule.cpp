@@ -18,8 +18,11 @@
 
 #include "test_rule.hpp"
 
+#include <boost/static_assert.hpp>
+
 #include <algorithm>
 #include <initializer_list>
+#include <type_traits>
 
 namespace boost {
 namespace urls {
@@ -213,6 +216,155 @@ struct range_rule_test
         }
     }
 
+    void
+    testTypedRange()
+    {
+        constexpr auto r0 = typed_range_rule(
+            tuple_rule(
+                squelch(
+                    delim_rule(';')),
+                token_rule(alpha_chars)));
+
+        using R0 = decltype(r0)::value_type;
+        BOOST_STATIC_ASSERT(
+            std::is_same<
+                R0::value_type,
+                core::string_view>::value);
+        BOOST_STATIC_ASSERT(
+            std::is_nothrow_copy_constructible<
+                R0>::value);
+
+        // copy
+        {
+            auto v0 = parse(";a;b;c", r0).value();
+            R0 v(v0);
+            BOOST_TEST_EQ(v.size(), 3);
+            BOOST_TEST_EQ(v.string(), ";a;b;c");
+            v = parse(";x", r0).value();
+            BOOST_TEST_EQ(v.size(), 1);
+            BOOST_TEST_EQ(*v.begin(), "x");
+            BOOST_TEST_EQ(v0.size(), 3);
+        }
+
+        // empty
+        {
+            auto v = parse("", r0).value();
+            BOOST_TEST(v.empty());
+            BOOST_TEST_EQ(v.begin(), v.end());
+        }
+
+        // default constructible rules
+        {
+            typed_range<big_rule> v;
+            BOOST_TEST(v.empty());
+            BOOST_TEST_EQ(v.size(), 0);
+            BOOST_TEST_EQ(v.begin(), v.end());
+        }
+
+        // iterator
+        {
+            auto v = parse(";a;b", r0).value();
+            auto it = v.begin();
+            BOOST_TEST_EQ(*it++, "a");
+            BOOST_TEST_EQ(*it, "b");
+            BOOST_TEST(++it == v.end());
+        }
+
+        // lower limit
+        // upper limit
+        {
+            {
+                constexpr auto r = typed_range_rule(
+                    tuple_rule(
+                        squelch(
+                            delim_rule(';')),
+                        token_rule(alpha_chars)),
+                    2, 3);
+
+                bad(r, "", error::mismatch);
+                bad(r, ";x", error::mismatch);
+                check(r, ";x;y", {"x","y"});
+                check(r, ";x;y;z", {"x","y","z"});
+                bad(r, ";a;b;c;d", error::mismatch);
+                bad(r, ";a;b;c;d;e", error::mismatch);
+            }
+            {
+                constexpr auto r = typed_range_rule(
+                    token_rule(alpha_chars),
+                    tuple_rule(
+                        squelch(
+                            delim_rule('+')),
+                        token_rule(alpha_chars)),
+                    2, 3);
+
+                bad(r, "", error::mismatch);
+                bad(r, "x", error::mismatch);
+                check(r, "x+y", {"x","y"});
+                check(r, "x+y+z", {"x","y","z"});
+                bad(r, "a+b+c+d", error::mismatch);
+                bad(r, "a+b+c+d+e", error::mismatch);
+            }
+        }
+
+        // big rules
+        {
+            {
+                constexpr auto r = typed_range_rule(
+                    big_rule{},
+                    2, 3);
+
+                bad(r, "", error::mismatch);
+                check(r, ";x;y", {"x","y"});
+                check(r, ";x;y;z", {"x","y","z"});
+                bad(r, ";a;b;c;d", error::mismatch);
+            }
+            {
+                constexpr auto r = typed_range_rule(
+                    big_rule{}, big_rule{},
+                    2, 3);
+
+                bad(r, "x", error::mismatch);
+                check(r, ";x;y", {"x","y"});
+                check(r, ";x;y;z", {"x","y","z"});
+                bad(r, ";a;b;c;d", error::mismatch);
+            }
+        }
+
+        // same elements as range
+        {
+            constexpr auto r1 = range_rule(
+                token_rule(alpha_chars),
+                tuple_rule(
+                    squelch(
+                        delim_rule(',')),
+                    token_rule(alpha_chars)));
+            constexpr auto r2 = typed_range_rule(
+                token_rule(alpha_chars),
+                tuple_rule(
+                    squelch(
+                        delim_rule(',')),
+                    token_rule(alpha_chars)));
+            for(core::string_view s : {
+                "", "a", "a,b", "a,b,", "a,,b", ",a",
+                "abc,def,ghi,jkl,mno,pqr,stu,vwx,yz" })
+            {
+                char const* it1 = s.data();
+                char const* it2 = s.data();
+                auto rv1 = parse(it1, s.data() + s.size(), r1);
+                auto rv2 = parse(it2, s.data() + s.size(), r2);
+                BOOST_TEST_EQ(rv1.has_value(), rv2.has_value());
+                BOOST_TEST_EQ(it1, it2);
+                if(! rv1 || ! rv2)
+                    continue;
+                BOOST_TEST_EQ(rv1->size(), rv2->size());
+                BOOST_TEST_EQ(rv1->string(), rv2->string());
+                BOOST_TEST(std::equal(
+                    rv1->begin(), rv1->end(),
+                    rv2->begin()));
+            }
+        }
+    }
+
     void
     run()
     {
@@ -252,7 +404,31 @@ struct range_rule_test
             (void)rv;
         }
 
+        // javadoc
+        {
+            auto rv = parse( ";alpha;xray;charlie",
+                typed_range_rule(
+                    tuple_rule(
+                        squelch( delim_rule( ';' ) ),
+                        token_rule( alpha_chars ) ),
+                    1 ) );
+            (void)rv;
+        }
+
+        // javadoc
+        {
+            auto rv = parse( "whiskey,tango,foxtrot",
+                typed_range_rule(
+                    token_rule( alpha_chars ),          // first
+                    tuple_rule(                      // next
+                        squelch( delim_rule(',') ),
+                        token_rule( alpha_chars ) ) ) );
+
+            (void)rv;
+        }
+
         testRange();
+        testTypedRange();
     }
 };
 
@@ -12,6 +12,7 @@
 
 #include "test_suite.hpp"
 #include <string>
+#include <vector>
 
 namespace boost {
 namespace urls {
@@ -48,6 +49,31 @@ struct recycled_test
             BOOST_TEST(sp2->capacity() >= 1000);
         }
 
+        // bounded retention
+        {
+            std::size_t const n =
+                BOOST_URL_RECYCLED_CAPACITY + 4;
+            recycled<std::string> bin;
+            {
+                std::vector<recycled_ptr<std::string>> v;
+                for(std::size_t i = 0; i < n; ++i)
+                {
+                    v.emplace_back(bin);
+                    v.back()->assign("recycled");
+                }
+            }
+            std::vector<recycled_ptr<std::string>> v;
+            std::size_t reused = 0;
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                v.emplace_back(bin);
+                if(*v.back() == "recycled")
+                    ++reused;
+            }
+            BOOST_TEST_EQ(reused,
+                std::size_t(BOOST_URL_RECYCLED_CAPACITY));
+        }
+
         // coverage
         {
             see_below::recycled_add_impl(1);
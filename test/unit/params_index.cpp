@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/params_index.hpp>
+
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/static_assert.hpp>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+BOOST_STATIC_ASSERT(
+    std::is_copy_constructible<
+        params_index>::value);
+
+BOOST_STATIC_ASSERT(
+    std::is_nothrow_constructible<
+        params_index, params_view>::value);
+
+struct params_index_test
+{
+    // check the index against the linear
+    // lookups of params_view
+    static
+    void
+    check(
+        url_view u,
+        core::string_view key,
+        ignore_case_param ic = {})
+    {
+        params_view ps = u.params();
+        params_index idx(u.encoded_params(), ic);
+        auto const it0 = ps.find(key, ic);
+        auto const it1 = idx.find(key);
+        BOOST_TEST_EQ(
+            std::distance(ps.begin(), it0),
+            std::distance(idx.begin(), it1));
+        auto const it2 = ps.find_last(key, ic);
+        auto const it3 = idx.find_last(key);
+        BOOST_TEST_EQ(
+            std::distance(ps.begin(), it2),
+            std::distance(idx.begin(), it3));
+        BOOST_TEST_EQ(
+            idx.count(key), ps.count(key, ic));
+        BOOST_TEST_EQ(
+            idx.contains(key), ps.contains(key, ic));
+
+        // walk the matches
+        std::size_t n = 0;
+        auto it = it1;
+        while(it != idx.end())
+        {
+            ++n;
+            BOOST_TEST_EQ(
+                std::distance(ps.begin(), it0) <=
+                std::distance(idx.begin(), it), true);
+            it = idx.find_next(it);
+        }
+        BOOST_TEST_EQ(n, idx.count(key));
+    }
+
+    void
+    testJavadocs()
+    {
+        // class
+        {
+        url_view u( "?id=42&sort=asc&Page=3&id=43" );
+        params_index idx( u.encoded_params(), ignore_case );
+
+        assert( idx.count( "id" ) == 2 );
+        assert( (*idx.find( "page" )).value == "3" );
+        assert( (*idx.find_last( "id" )).value == "43" );
+        assert( ! idx.contains( "limit" ) );
+        }
+
+        // params_index(params_encoded_base const&, ignore_case_param)
+        {
+        url_view u( "?first=John&last=Doe" );
+        params_index idx( u.encoded_params() );
+        assert( idx.size() == 2 );
+        }
+
+        // params_index(params_base const&, ignore_case_param)
+        {
+        url_view u( "?first=John&last=Doe" );
+        params_index idx( u.params() );
+        assert( idx.size() == 2 );
+        }
+
+        // contains
+        {
+        assert( params_index( url_view( "?first=John&last=Doe" ).params() ).contains( "first" ) );
+        }
+
+        // count
+        {
+        assert( params_index( url_view( "?a=1&b=2&a=3" ).params() ).count( "a" ) == 2 );
+        }
+
+        // find
+        {
+        assert( (*params_index( url_view( "?first=John&last=Doe" ).params() ).find( "first" )).value == "John" );
+        }
+
+        // find_last
+        {
+        assert( (*params_index( url_view( "?a=1&b=2&a=3" ).params() ).find_last( "a" )).value == "3" );
+        }
+
+        // find_next
+        {
+        url_view u( "?a=1&b=2&a=3" );
+        params_index idx( u.params() );
+        assert( (*idx.find_next( idx.find( "a" ) )).value == "3" );
+        }
+    }
+
+    void
+    testLookup()
+    {
+        // empty
+        {
+            url_view u;
+            params_index idx(u.params());
+            BOOST_TEST_EQ(idx.size(), 0u);
+            BOOST_TEST(idx.find("a") == idx.end());
+            BOOST_TEST(idx.find_last("a") == idx.end());
+            BOOST_TEST_EQ(idx.count("a"), 0u);
+            BOOST_TEST(! idx.contains(""));
+        }
+
+        core::string_view const keys[] = {
+            "", "a", "A", "b", "c", "a=",
+            "a b", "a+b", "A+b", "first",
+            "FIRST", "last", "x", "z",
+            "\xff", core::string_view("\0", 1) };
+
+        for(core::string_view s : {
+            "?",
+            "?&",
+            "?=",
+            "?a",
+            "?a=1&b=2&a=3&A=4&c&c=&=x&&",
+            "?%61=1&a=2&%41=3&a%3D=4&a=",
+            "?a+b=1&a%20b=2&A+B=3",
+            "?first=John&last=Doe&First=Jane",
+            "?x=%00&%00=1&%FF=2&%ff=3",
+            })
+        {
+            url_view u(s);
+            for(core::string_view key : keys)
+            {
+                check(u, key);
+                check(u, key, ignore_case);
+            }
+        }
+
+        // many params and collisions
+        {
+            url u;
+            auto ps = u.params();
+            for(int i = 0; i < 200; ++i)
+                ps.append({
+                    "key" + std::to_string(i % 67),
+                    std::to_string(i)});
+            for(int i = 0; i < 70; ++i)
+            {
+                auto const key =
+                    "key" + std::to_string(i);
+                check(u, key);
+                check(u, key, ignore_case);
+                auto const key2 =
+                    "KEY" + std::to_string(i);
+                check(u, key2);
+                check(u, key2, ignore_case);
+            }
+            params_index idx(u.params());
+            BOOST_TEST_EQ(idx.count("key0"), 3u);
+            BOOST_TEST_EQ(
+                (*idx.find_last("key0")).value, "134");
+        }
+
+        // build is idempotent, copies share nothing
+        {
+            url_view u("?a=1&b=2");
+            params_index idx(u.params());
+            idx.build();
+            idx.build();
+            params_index idx2(idx);
+            BOOST_TEST_EQ(
+                (*idx2.find("b")).value, "2");
+            BOOST_TEST_EQ(
+                (*idx.find("a")).value, "1");
+        }
+    }
+
+    void
+    run()
+    {
+        testJavadocs();
+        testLookup();
+    }
+};
+
+TEST_SUITE(
+    params_index_test,
+    "boost.url.params_index");
+
+} // urls
+} // boost
@@ -0,0 +1,235 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/params_offsets.hpp>
+
+#include <boost/url/parse_query.hpp>
+#include <boost/url/static_url.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/static_assert.hpp>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+BOOST_STATIC_ASSERT(
+    std::is_copy_constructible<
+        params_offsets>::value);
+
+BOOST_STATIC_ASSERT(
+    std::is_nothrow_constructible<
+        params_offsets, params_view>::value);
+
+struct params_offsets_test
+{
+    // check every position against
+    // iterating from the beginning
+    static
+    void
+    check(params_encoded_view ps)
+    {
+        params_offsets idx(ps);
+        BOOST_TEST_EQ(idx.size(), ps.size());
+        BOOST_TEST(idx.begin() == ps.begin());
+        BOOST_TEST(idx.end() == ps.end());
+        BOOST_TEST(idx.nth(ps.size()) == ps.end());
+        auto it = ps.begin();
+        for(std::size_t i = 0; i < ps.size(); ++i, ++it)
+        {
+            BOOST_TEST(idx.nth(i) == it);
+            BOOST_TEST_EQ((*idx.nth(i)).key, (*it).key);
+            BOOST_TEST_EQ(idx[i].key, (*it).key);
+            BOOST_TEST_EQ(idx[i].value, (*it).value);
+            BOOST_TEST_EQ(idx[i].has_value, (*it).has_value);
+            // iterators are usable both ways
+            auto jt = idx.nth(i);
+            BOOST_TEST(++jt == std::next(it));
+            if(i > 0)
+            {
+                jt = idx.nth(i);
+                BOOST_TEST(--jt == std::prev(it));
+            }
+        }
+    }
+
+    void
+    testJavadocs()
+    {
+        // class
+        {
+        url u( "?first=John&last=Doe&age=42" );
+        params_offsets idx( u.encoded_params() );
+
+        assert( idx[2].key == "age" );
+
+        u.params().erase( u.params().begin() );
+
+        assert( idx.size() == 2 );
+        assert( idx[1].key == "age" );
+        }
+
+        // params_offsets(params_encoded_base const&)
+        {
+        url_view u( "?first=John&last=Doe" );
+        params_offsets idx( u.encoded_params() );
+        (void)idx;
+        }
+
+        // params_offsets(params_base const&)
+        {
+        url_view u( "?first=John&last=Doe" );
+        params_offsets idx( u.params() );
+        (void)idx;
+        }
+
+        // nth
+        {
+        url_view u( "?a=1&b=2&c=3" );
+        params_offsets idx( u.params() );
+        assert( std::distance( idx.nth( 1 ), idx.end() ) == 2 );
+        }
+
+        // operator[]
+        {
+        assert( params_offsets( url_view( "?a=1&b=2" ).params() )[1].value == "2" );
+        }
+    }
+
+    void
+    testAccess()
+    {
+        check(url_view("").encoded_params());
+        check(url_view("?").encoded_params());
+        check(url_view("?&").encoded_params());
+        check(url_view("?a").encoded_params());
+        check(url_view("?a=").encoded_params());
+        check(url_view("?a=1&&b=%32&=3&c&d=4=4#f").encoded_params());
+        check(url_view("?%61=%31&b%20c=x+y&%2B=%26").encoded_params());
+        check(parse_query("a=1&b=2&c=3").value());
+        check(parse_query("").value());
+
+        // many params
+        {
+            std::string s = "?";
+            for(int i = 0; i < 500; ++i)
+            {
+                if(i > 0)
+                    s.push_back('&');
+                s += "key" + std::to_string(i) +
+                    "=value" + std::to_string(i);
+            }
+            url_view u(s);
+            check(u.encoded_params());
+            params_offsets idx(u.params());
+            for(std::size_t i = 500; i-- > 0;)
+                BOOST_TEST_EQ(idx[i].value,
+                    "value" + std::to_string(i));
+        }
+    }
+
+    void
+    testModify()
+    {
+        // the index follows changes
+        // made through a params_ref
+        {
+            url u("?a=1&b=2&c=3");
+            params_offsets idx(u.params());
+            BOOST_TEST_EQ(idx[2].value, "3");
+            u.params().append({"d", "4"});
+            BOOST_TEST_EQ(idx.size(), 4);
+            BOOST_TEST_EQ(idx[3].key, "d");
+            u.params().erase(u.params().begin());
+            BOOST_TEST_EQ(idx.size(), 3);
+            BOOST_TEST_EQ(idx[0].key, "b");
+            check(u.encoded_params());
+        }
+
+        // edits which keep the size and
+        // the number of params
+        {
+            url u("?ab&c");
+            params_offsets idx(u.encoded_params());
+            BOOST_TEST_EQ(idx[1].key, "c");
+            u.set_encoded_query("a&bc");
+            BOOST_TEST_EQ(idx.size(), 2);
+            BOOST_TEST_EQ(idx[1].key, "bc");
+        }
+
+        // other changes to the url
+        {
+            url u("?x=1&y=2");
+            params_offsets idx(u.encoded_params());
+            BOOST_TEST_EQ(idx[1].value, "2");
+            u.set_encoded_path("/a/very/long/path");
+            u.set_host("www.example.com");
+            BOOST_TEST_EQ(idx[1].value, "2");
+            u.set_encoded_query("yy=22&x=1");
+            BOOST_TEST_EQ(idx[0].value, "22");
+            u.clear();
+            BOOST_TEST_EQ(idx.size(), 0);
+            u = url("?p=1&q=2");
+            BOOST_TEST_EQ(idx[1].key, "q");
+            url u2("?q&p");
+            u.swap(u2);
+            BOOST_TEST_EQ(idx[0].key, "q");
+            u = std::move(u2);
+            BOOST_TEST_EQ(idx[0].key, "p");
+        }
+
+        // static_url
+        {
+            static_url<64> u("?a=1&bb=2");
+            params_offsets idx(u.params());
+            BOOST_TEST_EQ(idx[1].key, "bb");
+            u.set_encoded_query("aa=1&b=2");
+            BOOST_TEST_EQ(idx[1].key, "b");
+        }
+
+        // views of a url
+        {
+            url u("?ab&c");
+            url const& cu = u;
+            params_offsets idx(cu.encoded_params());
+            params_offsets idx2(url_view(u).params());
+            BOOST_TEST_EQ(idx[1].key, "c");
+            BOOST_TEST_EQ(idx2[1].key, "c");
+            u.set_encoded_query("a&bc");
+            BOOST_TEST_EQ(idx[1].key, "bc");
+            BOOST_TEST_EQ(idx2[1].key, "bc");
+        }
+    }
+
+    void
+    run()
+    {
+        testJavadocs();
+        testAccess();
+        testModify();
+    }
+};
+
+TEST_SUITE(
+    params_offsets_test,
+    "boost.url.params_offsets");
+
+} // urls
+} // boost
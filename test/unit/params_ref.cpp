@@ -20,6 +20,8 @@
 #include "test_suite.hpp"
 
 #include <iterator>
+#include <list>
+#include <vector>
 
 #ifdef assert
 #undef assert
@@ -892,6 +894,114 @@ struct params_ref_test
         }
     }
 
+    static
+    void
+    testRanges()
+    {
+        // ranges of random access iterators
+        // are encoded once, other ranges are
+        // measured and then copied
+        std::vector<param_view> const v = {
+            {"first", "John Doe"},
+            {"last", no_value},
+            {"", ""},
+            {"k&=", "v&#"},
+            {BIGSTR, BIGSTR} };
+        std::list<param_view> const l(
+            v.begin(), v.end());
+        auto const same = [](
+            core::string_view s0,
+            void(*f)(params_ref, std::vector<param_view> const&),
+            void(*g)(params_ref, std::list<param_view> const&),
+            std::vector<param_view> const& v,
+            std::list<param_view> const& l)
+        {
+            url u0(s0);
+            url u1(s0);
+            f(u0.params(), v);
+            g(u1.params(), l);
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+            BOOST_TEST_EQ(u0.params().size(), u1.params().size());
+            BOOST_TEST_EQ(u0.query(), u1.query());
+        };
+        for(core::string_view s0 : {
+            "", "?", "?a=1", "?a=1&b", "http://x/?a=1#f" })
+        {
+            same(s0,
+                [](params_ref p, std::vector<param_view> const& v)
+                { p.append(v.begin(), v.end()); },
+                [](params_ref p, std::list<param_view> const& l)
+                { p.append(l.begin(), l.end()); },
+                v, l);
+            same(s0,
+                [](params_ref p, std::vector<param_view> const& v)
+                { p.assign(v.begin(), v.end()); },
+                [](params_ref p, std::list<param_view> const& l)
+                { p.assign(l.begin(), l.end()); },
+                v, l);
+            same(s0,
+                [](params_ref p, std::vector<param_view> const& v)
+                { p.insert(p.begin(), v.begin(), v.end()); },
+                [](params_ref p, std::list<param_view> const& l)
+                { p.insert(p.begin(), l.begin(), l.end()); },
+                v, l);
+            same(s0,
+                [](params_ref p, std::vector<param_view> const& v)
+                { p.replace(p.begin(), p.end(), v.begin(), v.end()); },
+                [](params_ref p, std::list<param_view> const& l)
+                { p.replace(p.begin(), p.end(), l.begin(), l.end()); },
+                v, l);
+            same(s0,
+                [](params_ref p, std::vector<param_view> const& v)
+                { p.append(v.begin(), v.begin()); },
+                [](params_ref p, std::list<param_view> const& l)
+                { p.append(l.begin(), l.begin()); },
+                v, l);
+        }
+
+        // many params
+        {
+            std::vector<param> v1;
+            for(int i = 0; i < 50; ++i)
+                v1.emplace_back(
+                    "key " + std::to_string(i),
+                    std::string(i, '&'));
+            std::list<param> const l1(
+                v1.begin(), v1.end());
+            url u0("?x");
+            url u1("?x");
+            u0.params().append(v1.begin(), v1.end());
+            u1.params().append(l1.begin(), l1.end());
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+            BOOST_TEST_EQ(u0.params().size(), 51u);
+            BOOST_TEST_EQ(
+                (*std::next(u0.params().begin(), 50)).value,
+                std::string(49, '&'));
+        }
+
+        // encoded params
+        {
+            std::vector<param_pct_view> const v1 = {
+                {"a%20b", "c&d"}, {"%3D", no_value} };
+            std::list<param_pct_view> const l1(
+                v1.begin(), v1.end());
+            url u0("?x=1");
+            url u1("?x=1");
+            u0.encoded_params().append(v1.begin(), v1.end());
+            u1.encoded_params().append(l1.begin(), l1.end());
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+            BOOST_TEST_EQ(u0.encoded_query(), "x=1&a%20b=c%26d&%3D");
+
+            // invalid input leaves the url unchanged
+            std::vector<param_view> const bad = {
+                {"a", "b"}, {"%zz", "c"} };
+            BOOST_TEST_THROWS(
+                u0.encoded_params().append(bad.begin(), bad.end()),
+                system::system_error);
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+        }
+    }
+
     static
     void
     testAll()
@@ -899,6 +1009,7 @@ struct params_ref_test
         testSpecial();
         testObservers();
         testModifiers();
+        testRanges();
         testJavadocs();
     }
 
@@ -10,8 +10,13 @@
 // Test that header file is self-contained.
 #include <boost/url/pct_string_view.hpp>
 
+#include <boost/url/error.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+
 #include "test_suite.hpp"
 
+#include <string>
+
 namespace boost {
 namespace urls {
 
@@ -133,11 +138,134 @@ struct pct_string_view_test
 
     }
 
+    // decode one character at a time
+    static
+    std::string
+    reference_decode(
+        core::string_view s,
+        bool space_as_plus)
+    {
+        std::string r;
+        for(std::size_t i = 0; i < s.size(); ++i)
+        {
+            if(s[i] == '%')
+            {
+                r.push_back(static_cast<char>(
+                    grammar::hexdig_value(s[i + 1]) * 16 +
+                    grammar::hexdig_value(s[i + 2])));
+                i += 2;
+            }
+            else if(space_as_plus && s[i] == '+')
+            {
+                r.push_back(' ');
+            }
+            else
+            {
+                r.push_back(s[i]);
+            }
+        }
+        return r;
+    }
+
+    void
+    check_decode(core::string_view s)
+    {
+        auto rv = make_pct_string_view(s);
+        if(! BOOST_TEST(rv.has_value()))
+            return;
+        for(bool plus : { false, true })
+        {
+            std::string const r =
+                reference_decode(s, plus);
+            BOOST_TEST_EQ(rv->decoded_size(), r.size());
+            BOOST_TEST_EQ(rv->decode(encoding_opts(plus)), r);
+        }
+    }
+
+    void
+    testDecode()
+    {
+        // every length up to a few blocks,
+        // with escapes planted at every
+        // position, including across the
+        // block boundaries
+        std::string s;
+        for(std::size_t n = 0; n <= 80; ++n)
+        {
+            s.assign(n, 'a');
+            check_decode(s);
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                s[i] = '+';
+                check_decode(s);
+                s[i] = 'a';
+                if(i + 3 > n)
+                    continue;
+                s.replace(i, 3, "%2B");
+                check_decode(s);
+                s.replace(i, 3, "%fF");
+                check_decode(s);
+                s.replace(i, 3, "aaa");
+            }
+        }
+
+        // dense escapes
+        s.clear();
+        for(int i = 0; i < 256; ++i)
+        {
+            char const* const hex =
+                "0123456789ABCDEF";
+            s.push_back('%');
+            s.push_back(hex[i >> 4]);
+            s.push_back(hex[i & 15]);
+            if(i % 7 == 0)
+                s.push_back('+');
+            check_decode(s);
+        }
+    }
+
+    void
+    testValidate()
+    {
+        // a bad or truncated escape
+        // at every position
+        std::string s;
+        for(std::size_t n = 1; n <= 80; ++n)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                s.assign(n, 'a');
+                s[i] = '%';
+                if(i + 2 < n)
+                {
+                    BOOST_TEST(make_pct_string_view(s));
+                    s[i + 2] = 'g';
+                    BOOST_TEST(make_pct_string_view(s).error() ==
+                        error::bad_pct_hexdig);
+                    s[i + 2] = 'a';
+                    s[i + 1] = '%';
+                    BOOST_TEST(make_pct_string_view(s).error() ==
+                        error::bad_pct_hexdig);
+                    s[i + 1] = '/';
+                    BOOST_TEST(make_pct_string_view(s).error() ==
+                        error::bad_pct_hexdig);
+                }
+                else
+                {
+                    BOOST_TEST(make_pct_string_view(s).error() ==
+                        error::incomplete_encoding);
+                }
+            }
+        }
+    }
+
     void
     run()
     {
         testSpecial();
         testRelation();
+        testDecode();
+        testValidate();
     }
 };
 
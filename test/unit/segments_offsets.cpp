@@ -0,0 +1,217 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/segments_offsets.hpp>
+
+#include <boost/url/parse_path.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/static_assert.hpp>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+BOOST_STATIC_ASSERT(
+    std::is_copy_constructible<
+        segments_offsets>::value);
+
+BOOST_STATIC_ASSERT(
+    std::is_nothrow_constructible<
+        segments_offsets, segments_view>::value);
+
+struct segments_offsets_test
+{
+    // check every position against
+    // iterating from the beginning
+    static
+    void
+    check(segments_encoded_view ps)
+    {
+        segments_offsets idx(ps);
+        BOOST_TEST_EQ(idx.size(), ps.size());
+        BOOST_TEST(idx.begin() == ps.begin());
+        BOOST_TEST(idx.end() == ps.end());
+        BOOST_TEST(idx.nth(ps.size()) == ps.end());
+        auto it = ps.begin();
+        for(std::size_t i = 0; i < ps.size(); ++i, ++it)
+        {
+            BOOST_TEST(idx.nth(i) == it);
+            BOOST_TEST_EQ(*idx.nth(i), *it);
+            BOOST_TEST_EQ(idx[i], *it);
+            // iterators are usable both ways
+            auto jt = idx.nth(i);
+            BOOST_TEST(++jt == std::next(it));
+            if(jt != ps.end())
+                BOOST_TEST_EQ(*jt, *std::next(it));
+            if(i > 0)
+            {
+                jt = idx.nth(i);
+                BOOST_TEST(--jt == std::prev(it));
+                BOOST_TEST_EQ(*jt, *std::prev(it));
+            }
+        }
+    }
+
+    void
+    testJavadocs()
+    {
+        // class
+        {
+        url u( "/path/to/the/file.txt" );
+        segments_offsets idx( u.encoded_segments() );
+
+        assert( idx[3] == "file.txt" );
+
+        u.segments().pop_back();
+
+        assert( idx.size() == 3 );
+        assert( idx[2] == "the" );
+        }
+
+        // segments_offsets(segments_encoded_base const&)
+        {
+        url_view u( "/path/to/file.txt" );
+        segments_offsets idx( u.encoded_segments() );
+        (void)idx;
+        }
+
+        // segments_offsets(segments_base const&)
+        {
+        url_view u( "/path/to/file.txt" );
+        segments_offsets idx( u.segments() );
+        (void)idx;
+        }
+
+        // nth
+        {
+        url_view u( "/a/b/c" );
+        segments_offsets idx( u.segments() );
+        assert( std::distance( idx.nth( 1 ), idx.end() ) == 2 );
+        }
+
+        // operator[]
+        {
+        assert( segments_offsets( url_view( "/a/b" ).segments() )[1] == "b" );
+        }
+    }
+
+    void
+    testAccess()
+    {
+        for(core::string_view s : {
+            "", "/", "//", "a", "/a", "a/", "/a/",
+            "a/b/c", "/a//b/", "./a:b/c",
+            "/%2F/%61/x%20y", "x:/path/to/file",
+            "http://h", "http://h/", "http://h/a/b",
+            "http://h//a?q#f" })
+        {
+            check(url_view(s).encoded_segments());
+        }
+        check(parse_path("a/b/c").value());
+        check(parse_path("/a//b/").value());
+
+        // many segments
+        {
+            std::string s;
+            for(int i = 0; i < 500; ++i)
+                s += "/seg" + std::to_string(i);
+            url_view u(s);
+            check(u.encoded_segments());
+            segments_offsets idx(u.segments());
+            for(std::size_t i = 500; i-- > 0;)
+                BOOST_TEST_EQ(idx[i],
+                    "seg" + std::to_string(i));
+        }
+    }
+
+    void
+    testModify()
+    {
+        // the index follows changes
+        // made through a segments_ref
+        {
+            url u("/a/b/c");
+            segments_offsets idx(u.segments());
+            BOOST_TEST_EQ(idx[2], "c");
+            u.segments().push_back("d");
+            BOOST_TEST_EQ(idx.size(), 4);
+            BOOST_TEST_EQ(idx[3], "d");
+            u.segments().erase(u.segments().begin());
+            BOOST_TEST_EQ(idx.size(), 3);
+            BOOST_TEST_EQ(idx[0], "b");
+            check(u.encoded_segments());
+        }
+
+        // edits which keep the size and
+        // the number of segments
+        {
+            url u("/ab/c");
+            segments_offsets idx(u.encoded_segments());
+            BOOST_TEST_EQ(idx[1], "c");
+            u.set_encoded_path("/a/bc");
+            BOOST_TEST_EQ(idx.size(), 2);
+            BOOST_TEST_EQ(idx[1], "bc");
+        }
+
+        // other changes to the url
+        {
+            url u("/x/y");
+            segments_offsets idx(u.encoded_segments());
+            BOOST_TEST_EQ(idx[1], "y");
+            u.set_scheme("https");
+            u.set_host("www.example.com");
+            BOOST_TEST_EQ(idx[1], "y");
+            u.set_path_absolute(false);
+            BOOST_TEST_EQ(idx[1], "y");
+            u.normalize();
+            BOOST_TEST_EQ(idx[0], "x");
+            check(u.encoded_segments());
+        }
+
+        // views of a url
+        {
+            url u("/ab/c");
+            url const& cu = u;
+            segments_offsets idx(cu.encoded_segments());
+            segments_offsets idx2(url_view(u).segments());
+            BOOST_TEST_EQ(idx[1], "c");
+            BOOST_TEST_EQ(idx2[1], "c");
+            u.set_encoded_path("/a/bc");
+            BOOST_TEST_EQ(idx[1], "bc");
+            BOOST_TEST_EQ(idx2[1], "bc");
+        }
+    }
+
+    void
+    run()
+    {
+        testJavadocs();
+        testAccess();
+        testModify();
+    }
+};
+
+TEST_SUITE(
+    segments_offsets_test,
+    "boost.url.segments_offsets");
+
+} // urls
+} // boost
@@ -18,6 +18,10 @@
 
 #include "test_suite.hpp"
 
+#include <list>
+#include <string>
+#include <vector>
+
 #ifdef assert
 #undef assert
 #endif
@@ -843,6 +847,127 @@ struct segments_ref_test
 
     //--------------------------------------------
 
+    static
+    void
+    testRanges()
+    {
+        // ranges of random access iterators
+        // are encoded once, other ranges are
+        // measured and then copied
+        auto const same = [](
+            core::string_view s0,
+            std::vector<core::string_view> const& v,
+            bool encoded)
+        {
+            std::list<core::string_view> const l(
+                v.begin(), v.end());
+            auto const apply = [&](
+                int i, url& u0, url& u1)
+            {
+                auto ps0 = u0.segments();
+                auto ps1 = u1.segments();
+                auto es0 = u0.encoded_segments();
+                auto es1 = u1.encoded_segments();
+                switch(i)
+                {
+                case 0:
+                    if(encoded)
+                    {
+                        es0.assign(v.begin(), v.end());
+                        es1.assign(l.begin(), l.end());
+                        break;
+                    }
+                    ps0.assign(v.begin(), v.end());
+                    ps1.assign(l.begin(), l.end());
+                    break;
+                case 1:
+                    if(encoded)
+                    {
+                        es0.insert(es0.begin(), v.begin(), v.end());
+                        es1.insert(es1.begin(), l.begin(), l.end());
+                        break;
+                    }
+                    ps0.insert(ps0.begin(), v.begin(), v.end());
+                    ps1.insert(ps1.begin(), l.begin(), l.end());
+                    break;
+                default:
+                    if(encoded)
+                    {
+                        es0.insert(es0.end(), v.begin(), v.end());
+                        es1.insert(es1.end(), l.begin(), l.end());
+                        break;
+                    }
+                    ps0.insert(ps0.end(), v.begin(), v.end());
+                    ps1.insert(ps1.end(), l.begin(), l.end());
+                    break;
+                }
+            };
+            for(int i = 0; i < 3; ++i)
+            {
+                url u0(s0);
+                url u1(s0);
+                apply(i, u0, u1);
+                BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+                BOOST_TEST_EQ(u0.segments().size(), u1.segments().size());
+                BOOST_TEST_EQ(u0.path(), u1.path());
+            }
+        };
+        for(core::string_view s0 : {
+            "", "/", "a", "/a/b", "x:y", "//h", "http://h/a?q" })
+        {
+            same(s0, {}, false);
+            same(s0, {""}, false);
+            same(s0, {"a:b"}, false);
+            same(s0, {".", "a"}, false);
+            same(s0, {"", "b c", "d/e", BIGSTR}, false);
+            same(s0, {"a:b", "c:d", "%2F"}, false);
+            same(s0, {"a:b", "c:d", "%2F"}, true);
+            same(s0, {"", "b%20c", ".", BIGSTR}, true);
+        }
+
+        // empty range at the front
+        for(core::string_view s0 : {
+            "a", "/a/b", "x:y", "./a:b", "/.//b" })
+        {
+            std::vector<core::string_view> const v;
+            url u(s0);
+            auto ps = u.segments();
+            ps.insert(ps.begin(), v.begin(), v.end());
+            BOOST_TEST_EQ(u.buffer(), s0);
+            ps.erase(ps.begin(), ps.begin());
+            BOOST_TEST_EQ(u.buffer(), s0);
+        }
+
+        // many segments
+        {
+            std::vector<std::string> v;
+            for(int i = 0; i < 50; ++i)
+                v.push_back("seg /" + std::to_string(i));
+            std::list<std::string> const l(
+                v.begin(), v.end());
+            url u0("/x");
+            url u1("/x");
+            u0.segments().insert(
+                u0.segments().end(), v.begin(), v.end());
+            u1.segments().insert(
+                u1.segments().end(), l.begin(), l.end());
+            BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+            BOOST_TEST_EQ(u0.segments().size(), 51u);
+            BOOST_TEST_EQ(u0.segments().back(), "seg /49");
+        }
+
+        // invalid input leaves the url unchanged
+        {
+            std::vector<core::string_view> const bad = {
+                "a", "%zz" };
+            url u("/x/y");
+            BOOST_TEST_THROWS(
+                u.encoded_segments().assign(bad.begin(), bad.end()),
+                system::system_error);
+            BOOST_TEST_EQ(u.buffer(), "/x/y");
+        }
+    }
+
     static
     void
     testAll()
@@ -850,6 +975,7 @@ struct segments_ref_test
         testSpecial();
         testObservers();
         testModifiers();
+        testRanges();
         testJavadocs();
     }
 
@@ -0,0 +1,356 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/small_url.hpp>
+
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/static_assert.hpp>
+
+#include "test_suite.hpp"
+
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace urls {
+
+struct small_url_test
+{
+    using U = small_url<32>;
+
+    BOOST_STATIC_ASSERT(
+        std::is_default_constructible<U>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_nothrow_move_constructible<U>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_nothrow_move_assignable<U>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_copy_constructible<U>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_copy_assignable<U>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_convertible<U, url_view>::value);
+
+    BOOST_STATIC_ASSERT(
+        std::is_convertible<U, url>::value);
+
+    static constexpr char const* short_url =
+        "http://www.example.com/";
+    static constexpr char const* long_url =
+        "http://www.example.com/path/to/a/file.txt?q=1";
+
+    void
+    testSpecial()
+    {
+        // small_url()
+        {
+            U u;
+            BOOST_TEST_EQ(*u.c_str(), '\0');
+            BOOST_TEST(u.buffer().empty());
+            BOOST_TEST(u.is_inline());
+            BOOST_TEST_EQ(u.capacity(), 32u);
+        }
+
+        // small_url(core::string_view)
+        {
+            BOOST_TEST_THROWS(
+                U("$:$"),
+                system::system_error);
+
+            U u0(short_url);
+            BOOST_TEST_EQ(u0.buffer(), short_url);
+            BOOST_TEST(u0.is_inline());
+
+            // too large for the buffer
+            U u1(long_url);
+            BOOST_TEST_EQ(u1.buffer(), long_url);
+            BOOST_TEST(! u1.is_inline());
+            BOOST_TEST_GE(u1.capacity(), u1.size());
+        }
+
+        // small_url(small_url const&)
+        // small_url(url_view_base const&)
+        {
+            U u0(short_url);
+            U u1(u0);
+            BOOST_TEST_EQ(u1.buffer(), short_url);
+            BOOST_TEST(u1.is_inline());
+            BOOST_TEST_NE(u1.c_str(), u0.c_str());
+
+            U u2(long_url);
+            U u3(u2);
+            BOOST_TEST_EQ(u3.buffer(), long_url);
+            BOOST_TEST(! u3.is_inline());
+            BOOST_TEST_NE(u3.c_str(), u2.c_str());
+
+            U u4{url_view(short_url)};
+            BOOST_TEST_EQ(u4.buffer(), short_url);
+            BOOST_TEST(u4.is_inline());
+        }
+
+        // small_url(small_url&&)
+        {
+            U u0(short_url);
+            U u1(std::move(u0));
+            BOOST_TEST_EQ(u1.buffer(), short_url);
+            BOOST_TEST(u1.is_inline());
+            BOOST_TEST(u0.buffer().empty());
+            BOOST_TEST(u0.is_inline());
+
+            // the heap storage is transferred
+            U u2(long_url);
+            char const* p = u2.c_str();
+            U u3(std::move(u2));
+            BOOST_TEST(u3.c_str() == p);
+            BOOST_TEST_EQ(u3.buffer(), long_url);
+            BOOST_TEST(u2.buffer().empty());
+            BOOST_TEST(u2.is_inline());
+            BOOST_TEST_EQ(u2.capacity(), 32u);
+        }
+
+        // operator=(small_url const&)
+        // operator=(url_view_base const&)
+        {
+            U u0(long_url);
+            U u1;
+            u1 = u0;
+            BOOST_TEST_EQ(u1.buffer(), long_url);
+            u1 = u1;
+            BOOST_TEST_EQ(u1.buffer(), long_url);
+            u1 = url_view(short_url);
+            BOOST_TEST_EQ(u1.buffer(), short_url);
+            BOOST_TEST(! u1.is_inline());
+        }
+
+        // operator=(small_url&&)
+        {
+            U u0(long_url);
+            U u1(short_url);
+            char const* p = u0.c_str();
+            u1 = std::move(u0);
+            BOOST_TEST(u1.c_str() == p);
+            BOOST_TEST(u0.buffer().empty());
+
+            // the heap storage is released
+            U u2(short_url);
+            u1 = std::move(u2);
+            BOOST_TEST_EQ(u1.buffer(), short_url);
+            BOOST_TEST(u1.is_inline());
+            u1 = std::move(u1);
+            BOOST_TEST_EQ(u1.buffer(), short_url);
+        }
+    }
+
+    void
+    testUrlBase()
+    {
+        // modifications which fit stay inline
+        {
+            U u("http://a.b/c");
+            u.set_scheme("https")
+                .set_host("x.y")
+                .set_port_number(8080)
+                .set_path("/health");
+            u.params().append({"k", "v"});
+            BOOST_TEST_EQ(u.buffer(),
+                "https://x.y:8080/health?k=v");
+            BOOST_TEST(u.is_inline());
+        }
+
+        // growth spills to the heap
+        {
+            U u("/");
+            u.set_path("/a/b");
+            BOOST_TEST(u.is_inline());
+            for(int i = 0; i < 20; ++i)
+                u.segments().push_back("segment");
+            BOOST_TEST(! u.is_inline());
+            BOOST_TEST_EQ(u.segments().size(), 22u);
+            BOOST_TEST_EQ(u.segments().back(), "segment");
+
+            // the capacity is kept
+            auto const cap = u.capacity();
+            u.clear();
+            BOOST_TEST(u.buffer().empty());
+            BOOST_TEST(! u.is_inline());
+            BOOST_TEST_EQ(u.capacity(), cap);
+        }
+
+        // a modification which references
+        // the inline buffer while it spills
+        {
+            U u("/0123456789abcdef0123456789");
+            BOOST_TEST(u.is_inline());
+            u.set_encoded_query(u.encoded_path());
+            BOOST_TEST_EQ(u.buffer(),
+                "/0123456789abcdef0123456789"
+                "?/0123456789abcdef0123456789");
+            BOOST_TEST(! u.is_inline());
+        }
+
+        // reserve
+        {
+            U u;
+            u.reserve(32);
+            BOOST_TEST(u.is_inline());
+            u.reserve(33);
+            BOOST_TEST(! u.is_inline());
+            BOOST_TEST_GE(u.capacity(), 33u);
+        }
+    }
+
+    void
+    testSwap()
+    {
+        // inline and inline
+        {
+            U u0(short_url);
+            U u1("/path");
+            swap(u0, u1);
+            BOOST_TEST_EQ(u0.buffer(), "/path");
+            BOOST_TEST_EQ(u1.buffer(), short_url);
+            u0.swap(u0);
+            BOOST_TEST_EQ(u0.buffer(), "/path");
+        }
+
+        // heap and inline
+        {
+            U u0(long_url);
+            U u1(short_url);
+            char const* p = u0.c_str();
+            u0.swap(u1);
+            BOOST_TEST_EQ(u0.buffer(), short_url);
+            BOOST_TEST(u0.is_inline());
+            BOOST_TEST_EQ(u1.buffer(), long_url);
+            BOOST_TEST(u1.c_str() == p);
+        }
+
+        // heap and heap
+        {
+            U u0(long_url);
+            U u1("http://www.boost.org/path/to/another/file.txt");
+            char const* p0 = u0.c_str();
+            char const* p1 = u1.c_str();
+            u0.swap(u1);
+            BOOST_TEST(u0.c_str() == p1);
+            BOOST_TEST(u1.c_str() == p0);
+        }
+
+        // swap docs
+        {
+            small_url< 64 > u1( "https://www.example.com" );
+            small_url< 64 > u2( "https://www.boost.org" );
+            u1.swap(u2);
+            BOOST_TEST(u1.buffer() == "https://www.boost.org" );
+            BOOST_TEST(u2.buffer() == "https://www.example.com" );
+        }
+    }
+
+    void
+    testHash()
+    {
+        U u0("http://example.com/%41");
+        U u1("HTTP://EXAMPLE.COM/A");
+        std::hash<U> h;
+        BOOST_TEST_EQ(h(u0), h(u1));
+        BOOST_TEST_EQ(h(u0), std::hash<url_view>()(u0));
+        h = std::hash<U>(10);
+        BOOST_TEST_EQ(h(u0), std::hash<url_view>(10)(u0));
+        std::stringstream ss;
+        ss << u0;
+        BOOST_TEST_EQ(ss.str(), "http://example.com/%41");
+    }
+
+    void
+    testStats()
+    {
+        using V = small_url<16>;
+        V::reset_stats();
+        BOOST_TEST_EQ(V::stats().spills, 0u);
+        BOOST_TEST_EQ(V::stats().max_spill_size, 0u);
+        {
+            V u("/index.htm");
+            BOOST_TEST(u.is_inline());
+            BOOST_TEST_EQ(V::stats().spills, 0u);
+
+            // a spill
+            u.set_host("www.example.com");
+            BOOST_TEST(! u.is_inline());
+            BOOST_TEST_EQ(V::stats().spills, 1u);
+            BOOST_TEST_EQ(V::stats().max_spill_size,
+                u.size());
+
+            // growing on the heap is not a spill
+            u.set_path("/path/to/a/longer/file.txt");
+            BOOST_TEST_EQ(V::stats().spills, 1u);
+
+            // copies and moves
+            V u1(u);
+            BOOST_TEST_EQ(V::stats().spills, 2u);
+            V u2(std::move(u1));
+            BOOST_TEST_EQ(V::stats().spills, 2u);
+            V u3(url_view("http://www.example.com/?"
+                "a=1&b=2&c=3"));
+            BOOST_TEST_EQ(V::stats().spills, 3u);
+            BOOST_TEST_LT(u3.size(), u.size());
+            BOOST_TEST_EQ(V::stats().max_spill_size,
+                u.size());
+        }
+
+        // counters are separate for each capacity
+        BOOST_TEST_EQ(small_url<17>::stats().spills, 0u);
+
+        V::reset_stats();
+        BOOST_TEST_EQ(V::stats().spills, 0u);
+        BOOST_TEST_EQ(V::stats().max_spill_size, 0u);
+    }
+
+    void
+    testJavadocs()
+    {
+        // small_url
+        {
+            small_url< 64 > u( "https://www.example.com" );
+            u.set_path( "/index.htm" );
+            BOOST_TEST( u.is_inline() );
+        }
+
+        // stats
+        {
+            small_url< 16 > u( "https://www.example.com/index.htm" );
+            BOOST_TEST( small_url< 16 >::stats().spills > 0 );
+        }
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testUrlBase();
+        testSwap();
+        testHash();
+        testStats();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    small_url_test,
+    "boost.url.small_url");
+
+} // urls
+} // boost
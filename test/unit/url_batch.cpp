@@ -0,0 +1,210 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/url_batch.hpp>
+
+#include <boost/url/error.hpp>
+#include <boost/url/parse.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+struct url_batch_test
+{
+    // each item matches what the
+    // single-url parser produces
+    static
+    void
+    check(
+        url_batch const& b,
+        std::size_t i,
+        system::result<url_view> const& rv)
+    {
+        BOOST_TEST_EQ(b.has_value(i), rv.has_value());
+        if(! rv)
+        {
+            BOOST_TEST_EQ(b.error(i), rv.error());
+            return;
+        }
+        BOOST_TEST(! b.error(i));
+        url_view const& u = *rv;
+        BOOST_TEST_EQ(b.buffer(i), u.buffer());
+        BOOST_TEST_EQ(b.scheme(i), u.scheme());
+        BOOST_TEST(b.scheme_id(i) == u.scheme_id());
+        BOOST_TEST_EQ(b.has_authority(i), u.has_authority());
+        BOOST_TEST_EQ(b.encoded_userinfo(i), u.encoded_userinfo());
+        BOOST_TEST_EQ(
+            b.encoded_userinfo(i).decoded_size(),
+            u.encoded_userinfo().decoded_size());
+        BOOST_TEST_EQ(b.encoded_host(i), u.encoded_host());
+        BOOST_TEST(b.host_type(i) == u.host_type());
+        BOOST_TEST_EQ(b.has_port(i), u.has_port());
+        BOOST_TEST_EQ(b.port(i), u.port());
+        BOOST_TEST_EQ(b.port_number(i), u.port_number());
+        BOOST_TEST_EQ(b.encoded_path(i), u.encoded_path());
+        BOOST_TEST_EQ(
+            b.encoded_path(i).decoded_size(),
+            u.encoded_path().decoded_size());
+        BOOST_TEST_EQ(b.has_query(i), u.has_query());
+        BOOST_TEST_EQ(b.encoded_query(i), u.encoded_query());
+        BOOST_TEST_EQ(b.has_fragment(i), u.has_fragment());
+        BOOST_TEST_EQ(b.encoded_fragment(i), u.encoded_fragment());
+        BOOST_TEST_EQ(b.view(i).buffer(), u.buffer());
+        BOOST_TEST_EQ(b.view(i).encoded_host(), u.encoded_host());
+    }
+
+    void
+    testItems()
+    {
+        core::string_view const v[] = {
+            "https://www.example.com/path/to/file.txt?q=1#f",
+            "http://user:p%41ss@[::1]:8080/a%20b?x=%2F#frag",
+            "mailto:someone@example.com",
+            "file:///etc/hosts",
+            "urn:isbn:0451450523",
+            "ftp://1.2.3.4:21",
+            "/relative/path?k=v",
+            "?query",
+            "",
+            "not a url",
+            "http://[::1",
+            "x:%zz",
+        };
+        std::size_t const n = sizeof(v) / sizeof(v[0]);
+
+        // parse_uri_batch
+        {
+            url_batch b;
+            parse_uri_batch(v, n, b);
+            BOOST_TEST_EQ(b.size(), n);
+            std::size_t errors = 0;
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                auto rv = parse_uri(v[i]);
+                check(b, i, rv);
+                if(! rv)
+                    ++errors;
+            }
+            BOOST_TEST_EQ(b.error_count(), errors);
+            // failed items keep their string
+            BOOST_TEST_EQ(b.buffer(9), "not a url");
+        }
+
+        // parse_uri_reference_batch
+        {
+            url_batch b;
+            parse_uri_reference_batch(v, n, b);
+            BOOST_TEST_EQ(b.size(), n);
+            for(std::size_t i = 0; i < n; ++i)
+                check(b, i, parse_uri_reference(v[i]));
+        }
+
+        // append, clear
+        {
+            url_batch b;
+            BOOST_TEST(b.empty());
+            parse_uri_batch(v, 2, b);
+            parse_uri_reference_batch(v + 6, 2, b);
+            BOOST_TEST_EQ(b.size(), 4u);
+            check(b, 1, parse_uri(v[1]));
+            check(b, 2, parse_uri_reference(v[6]));
+            BOOST_TEST_EQ(b.view(3).buffer(), "?query");
+            b.clear();
+            BOOST_TEST(b.empty());
+            BOOST_TEST_EQ(b.error_count(), 0u);
+            parse_uri_batch(v + 8, 2, b);
+            BOOST_TEST_EQ(b.size(), 2u);
+            BOOST_TEST_EQ(b.error_count(), 2u);
+            BOOST_TEST_EQ(b.error(1), parse_uri(v[9]).error());
+        }
+    }
+
+    void
+    testLines()
+    {
+        {
+            url_batch b;
+            parse_uri_batch(
+                "https://www.example.com/\n"
+                "not a url\r\n"
+                "\n"
+                "http://a.b:80/c?d#e", b);
+            BOOST_TEST_EQ(b.size(), 4u);
+            BOOST_TEST_EQ(b.error_count(), 2u);
+            check(b, 0, parse_uri("https://www.example.com/"));
+            BOOST_TEST_EQ(b.buffer(1), "not a url");
+            BOOST_TEST(! b.has_value(2));
+            check(b, 3, parse_uri("http://a.b:80/c?d#e"));
+        }
+
+        // trailing newline
+        {
+            url_batch b;
+            parse_uri_reference_batch(
+                "/a\r\n/b\n", b);
+            BOOST_TEST_EQ(b.size(), 2u);
+            check(b, 0, parse_uri_reference("/a"));
+            check(b, 1, parse_uri_reference("/b"));
+        }
+
+        // empty
+        {
+            url_batch b;
+            parse_uri_batch("", b);
+            BOOST_TEST(b.empty());
+            parse_uri_reference_batch("\n", b);
+            BOOST_TEST_EQ(b.size(), 1u);
+            BOOST_TEST(b.has_value(0));
+        }
+    }
+
+    void
+    testJavadocs()
+    {
+        // url_batch
+        {
+        url_batch b;
+        parse_uri_batch( "https://www.example.com/\nnot a url\n", b );
+
+        assert( b.size() == 2 );
+        assert( b.encoded_host( 0 ) == "www.example.com" );
+        assert( ! b.has_value( 1 ) );
+        }
+
+        // parse_uri_batch
+        {
+        core::string_view v[] = { "https://a.com/", "mailto:b@c.com" };
+        url_batch b;
+        parse_uri_batch( v, 2, b );
+        }
+        {
+        url_batch b;
+        parse_uri_batch( "https://a.com/\r\nmailto:b@c.com\r\n", b );
+        assert( b.size() == 2 );
+        }
+    }
+
+    void
+    run()
+    {
+        testItems();
+        testLines();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    url_batch_test,
+    "boost.url.url_batch");
+
+} // urls
+} // boost
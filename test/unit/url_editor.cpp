@@ -0,0 +1,429 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/url_editor.hpp>
+
+#include <boost/url/static_url.hpp>
+#include <boost/url/url.hpp>
+#include <boost/static_assert.hpp>
+#include <string>
+#include <type_traits>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+BOOST_STATIC_ASSERT(
+    std::is_copy_constructible<
+        url_editor>::value);
+
+BOOST_STATIC_ASSERT(
+    ! std::is_default_constructible<
+        url_editor>::value);
+
+struct url_editor_test
+{
+    // the edits applied by one test case,
+    // through the editor or the modifiers
+    struct edits
+    {
+        char const* scheme = nullptr;
+        char const* host = nullptr;
+        char const* port = nullptr;
+        char const* path = nullptr;
+        char const* query = nullptr;
+        char const* frag = nullptr;
+        bool encoded = false;
+        bool no_query = false;
+        bool no_frag = false;
+    };
+
+    static
+    void
+    apply(url_editor& e, edits const& x)
+    {
+        if(x.scheme)
+            e.set_scheme(x.scheme);
+        if(x.host)
+        {
+            if(x.encoded)
+                e.set_encoded_host(x.host);
+            else
+                e.set_host(x.host);
+        }
+        if(x.port)
+            e.set_port(x.port);
+        if(x.path)
+        {
+            if(x.encoded)
+                e.set_encoded_path(x.path);
+            else
+                e.set_path(x.path);
+        }
+        if(x.no_query)
+            e.remove_query();
+        else if(x.query)
+        {
+            if(x.encoded)
+                e.set_encoded_query(x.query);
+            else
+                e.set_query(x.query);
+        }
+        if(x.no_frag)
+            e.remove_fragment();
+        else if(x.frag)
+        {
+            if(x.encoded)
+                e.set_encoded_fragment(x.frag);
+            else
+                e.set_fragment(x.frag);
+        }
+    }
+
+    static
+    void
+    apply(url_base& u, edits const& x)
+    {
+        if(x.scheme)
+            u.set_scheme(x.scheme);
+        if(x.host)
+        {
+            if(x.encoded)
+                u.set_encoded_host(x.host);
+            else
+                u.set_host(x.host);
+        }
+        if(x.port)
+            u.set_port(x.port);
+        if(x.path)
+        {
+            if(x.encoded)
+                u.set_encoded_path(x.path);
+            else
+                u.set_path(x.path);
+        }
+        if(x.no_query)
+            u.remove_query();
+        else if(x.query)
+        {
+            if(x.encoded)
+                u.set_encoded_query(x.query);
+            else
+                u.set_query(x.query);
+        }
+        if(x.no_frag)
+            u.remove_fragment();
+        else if(x.frag)
+        {
+            if(x.encoded)
+                u.set_encoded_fragment(x.frag);
+            else
+                u.set_fragment(x.frag);
+        }
+    }
+
+    static
+    void
+    check_eq(
+        url_view_base const& u0,
+        url_view_base const& u1)
+    {
+        BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+        BOOST_TEST(u0.scheme_id() == u1.scheme_id());
+        BOOST_TEST(u0.host_type() == u1.host_type());
+        BOOST_TEST_EQ(u0.encoded_host(), u1.encoded_host());
+        BOOST_TEST_EQ(
+            u0.encoded_host().decoded_size(),
+            u1.encoded_host().decoded_size());
+        BOOST_TEST(
+            u0.host_ipv6_address() ==
+            u1.host_ipv6_address());
+        BOOST_TEST(
+            u0.host_ipv4_address() ==
+            u1.host_ipv4_address());
+        BOOST_TEST_EQ(u0.port_number(), u1.port_number());
+        BOOST_TEST_EQ(u0.encoded_path(), u1.encoded_path());
+        BOOST_TEST_EQ(
+            u0.encoded_path().decoded_size(),
+            u1.encoded_path().decoded_size());
+        BOOST_TEST_EQ(
+            u0.encoded_segments().size(),
+            u1.encoded_segments().size());
+        BOOST_TEST_EQ(u0.has_query(), u1.has_query());
+        BOOST_TEST_EQ(u0.encoded_query(), u1.encoded_query());
+        BOOST_TEST_EQ(
+            u0.encoded_query().decoded_size(),
+            u1.encoded_query().decoded_size());
+        BOOST_TEST_EQ(
+            u0.encoded_params().size(),
+            u1.encoded_params().size());
+        BOOST_TEST_EQ(u0.has_fragment(), u1.has_fragment());
+        BOOST_TEST_EQ(
+            u0.encoded_fragment(), u1.encoded_fragment());
+        BOOST_TEST_EQ(
+            u0.encoded_fragment().decoded_size(),
+            u1.encoded_fragment().decoded_size());
+    }
+
+    // committing the edits gives the same
+    // url as calling the modifiers in order
+    static
+    void
+    check(
+        core::string_view s,
+        edits const& x)
+    {
+        url u0(s);
+        apply(u0, x);
+
+        {
+            url u1(s);
+            auto e = u1.edit();
+            apply(e, x);
+            BOOST_TEST_EQ(u1.buffer(), s);
+            e.commit();
+            check_eq(u0, u1);
+        }
+        {
+            // capacity already large enough
+            url u1(s);
+            u1.reserve(u0.size() + 16);
+            auto e = u1.edit();
+            apply(e, x);
+            e.commit();
+            check_eq(u0, u1);
+        }
+        {
+            static_url<256> u1(s);
+            auto e = u1.edit();
+            apply(e, x);
+            e.commit();
+            check_eq(u0, u1);
+        }
+    }
+
+    void
+    testCommit()
+    {
+        core::string_view const v[] = {
+            "",
+            "x",
+            "./a:b/c",
+            "a/b/c",
+            "/a/b",
+            "http:",
+            "http:./a/b",
+            "//",
+            "//host",
+            "//user:pass@host:80",
+            "http://www.example.com:8080/index.htm?id=1#top",
+            "https://user@[::1]:443/a%20b?x=%2F&y#f%23",
+            "mailto:someone@example.com",
+            "file:///etc/hosts",
+            "?q",
+            "#f",
+            };
+
+        edits xs[28];
+        xs[0].scheme = "https";
+        xs[1].host = "www.example.org";
+        xs[2].host = "a b";
+        xs[3].host = "a%20b";
+        xs[3].encoded = true;
+        xs[4].host = "[::ffff:1.2.3.4]";
+        xs[5].host = "10.0.0.1";
+        xs[6].host = "[v1.x]";
+        xs[7].host = "";
+        xs[8].port = "443";
+        xs[9].port = "";
+        xs[10].path = "/upstream/index.htm";
+        xs[11].path = "a:b/c d";
+        xs[12].path = "//x";
+        xs[13].path = "//x";
+        xs[13].encoded = true;
+        xs[14].path = "";
+        xs[15].path = "/";
+        xs[16].path = "/./a";
+        xs[17].query = "k=v&k2=v 2+";
+        xs[18].query = "a%26b&%20";
+        xs[18].encoded = true;
+        xs[19].no_query = true;
+        xs[20].frag = "top #2";
+        xs[21].no_frag = true;
+        xs[22].scheme = "https";
+        xs[22].host = "proxy.example.com";
+        xs[22].port = "443";
+        xs[22].path = "/upstream/index.htm";
+        xs[22].no_query = true;
+        xs[23].scheme = "ws";
+        xs[23].host = "h";
+        xs[24].scheme = "s";
+        xs[24].port = "1";
+        xs[24].query = "";
+        xs[24].frag = "";
+        xs[25].scheme = "http";
+        xs[25].host = "very.long.host.name.example.com";
+        xs[25].path = "p/q";
+        xs[25].query = "x";
+        xs[25].frag = "y";
+        xs[26].host = "[::1]";
+        xs[26].port = "8080";
+        xs[26].path = "a:b";
+        xs[27].path = "a:b";
+        xs[27].query = "%41";
+        xs[27].frag = "%42";
+        xs[27].encoded = true;
+
+        for(auto s : v)
+            for(auto const& x : xs)
+                check(s, x);
+    }
+
+    void
+    testAlias()
+    {
+        // strings may refer to the url
+        {
+            url u0("http://a.com/x/y?q#f");
+            url u1(u0);
+            auto e = u1.edit();
+            e.set_host(u1.encoded_path().substr(1, 1));
+            e.set_path(u1.encoded_query());
+            e.set_fragment(u1.encoded_host());
+            e.commit();
+            BOOST_TEST_EQ(u1.buffer(),
+                "http://x/q?q#a.com");
+        }
+        {
+            url u("//h/path?query#frag");
+            u.reserve(64);
+            auto e = u.edit();
+            e.set_scheme("s");
+            e.set_encoded_query(u.encoded_fragment());
+            e.set_encoded_fragment(u.encoded_path());
+            e.commit();
+            BOOST_TEST_EQ(u.buffer(),
+                "s://h/path?frag#/path");
+        }
+    }
+
+    void
+    testEditor()
+    {
+        // reuse after commit
+        {
+            url u("http://a.com/");
+            auto e = u.edit();
+            e.set_path("/1").commit();
+            BOOST_TEST_EQ(u.buffer(), "http://a.com/1");
+            e.set_query("q").commit();
+            BOOST_TEST_EQ(u.buffer(), "http://a.com/1?q");
+            e.commit();
+            BOOST_TEST_EQ(u.buffer(), "http://a.com/1?q");
+        }
+
+        // invalid input
+        {
+            url u("http://a.com/");
+            auto e = u.edit();
+            BOOST_TEST_THROWS(e.set_scheme("1x"), system::system_error);
+            BOOST_TEST_THROWS(e.set_port("x"), system::system_error);
+            BOOST_TEST_THROWS(
+                e.set_encoded_path("%"), system::system_error);
+            e.commit();
+            BOOST_TEST_EQ(u.buffer(), "http://a.com/");
+        }
+
+        // too large
+        {
+            static_url<16> u("http://a.com/");
+            auto e = u.edit();
+            e.set_path("/a/very/long/path");
+            BOOST_TEST_THROWS(e.commit(), std::exception);
+            BOOST_TEST_EQ(u.buffer(), "http://a.com/");
+        }
+
+        // port number
+        {
+            url u("http://a.com:80/");
+            u.edit().set_port_number(8080).commit();
+            BOOST_TEST_EQ(u.buffer(), "http://a.com:8080/");
+            BOOST_TEST_EQ(u.port_number(), 8080);
+            url u1("x");
+            u1.edit().set_port_number(1).commit();
+            BOOST_TEST_EQ(u1.buffer(), "//:1/x");
+        }
+
+        // copies hold the same changes
+        {
+            url u("http://a.com/");
+            auto e0 = u.edit();
+            e0.set_host("[::1]").set_port_number(1);
+            auto e1 = e0;
+            e0 = u.edit();
+            e1.commit();
+            BOOST_TEST_EQ(u.buffer(), "http://[::1]:1/");
+        }
+    }
+
+    void
+    testJavadocs()
+    {
+        // url_editor
+        {
+        url u( "http://www.example.com:8080/index.htm?id=1" );
+
+        u.edit()
+            .set_scheme( "https" )
+            .set_host( "proxy.example.com" )
+            .set_port_number( 443 )
+            .set_path( "/upstream/index.htm" )
+            .remove_query()
+            .commit();
+
+        assert( u.buffer() == "https://proxy.example.com:443/upstream/index.htm" );
+        }
+
+        // url_base::edit
+        {
+        url u( "http://www.example.com/index.htm?id=1" );
+
+        u.edit()
+            .set_scheme( "https" )
+            .set_host( "proxy.example.com" )
+            .set_path( "/upstream/index.htm" )
+            .commit();
+
+        assert( u.buffer() == "https://proxy.example.com/upstream/index.htm?id=1" );
+        }
+    }
+
+    void
+    run()
+    {
+        testCommit();
+        testAlias();
+        testEditor();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    url_editor_test,
+    "boost.url.url_editor");
+
+} // urls
+} // boost
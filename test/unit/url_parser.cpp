@@ -0,0 +1,336 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/url_parser.hpp>
+
+#include <boost/url/parse.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <string>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+#ifdef assert
+#undef assert
+#endif
+#define assert BOOST_TEST
+
+struct url_parser_test
+{
+    static
+    void
+    check_eq(
+        url_view const& u0,
+        url_view const& u1)
+    {
+        BOOST_TEST_EQ(u0.buffer(), u1.buffer());
+        BOOST_TEST(u0.scheme_id() == u1.scheme_id());
+        BOOST_TEST_EQ(u0.scheme(), u1.scheme());
+        BOOST_TEST_EQ(u0.has_authority(), u1.has_authority());
+        BOOST_TEST_EQ(u0.has_userinfo(), u1.has_userinfo());
+        BOOST_TEST_EQ(u0.has_password(), u1.has_password());
+        BOOST_TEST_EQ(u0.encoded_user(), u1.encoded_user());
+        BOOST_TEST_EQ(u0.encoded_password(), u1.encoded_password());
+        BOOST_TEST_EQ(
+            u0.encoded_userinfo().decoded_size(),
+            u1.encoded_userinfo().decoded_size());
+        BOOST_TEST(u0.host_type() == u1.host_type());
+        BOOST_TEST_EQ(u0.encoded_host(), u1.encoded_host());
+        BOOST_TEST_EQ(
+            u0.encoded_host().decoded_size(),
+            u1.encoded_host().decoded_size());
+        BOOST_TEST(
+            u0.host_ipv6_address() ==
+            u1.host_ipv6_address());
+        BOOST_TEST_EQ(u0.has_port(), u1.has_port());
+        BOOST_TEST_EQ(u0.port(), u1.port());
+        BOOST_TEST_EQ(u0.port_number(), u1.port_number());
+        BOOST_TEST_EQ(u0.encoded_path(), u1.encoded_path());
+        BOOST_TEST_EQ(
+            u0.encoded_path().decoded_size(),
+            u1.encoded_path().decoded_size());
+        BOOST_TEST_EQ(
+            u0.encoded_segments().size(),
+            u1.encoded_segments().size());
+        BOOST_TEST_EQ(u0.has_query(), u1.has_query());
+        BOOST_TEST_EQ(u0.encoded_query(), u1.encoded_query());
+        BOOST_TEST_EQ(
+            u0.encoded_query().decoded_size(),
+            u1.encoded_query().decoded_size());
+        BOOST_TEST_EQ(
+            u0.encoded_params().size(),
+            u1.encoded_params().size());
+        BOOST_TEST_EQ(u0.has_fragment(), u1.has_fragment());
+        BOOST_TEST_EQ(
+            u0.encoded_fragment(), u1.encoded_fragment());
+        BOOST_TEST_EQ(
+            u0.encoded_fragment().decoded_size(),
+            u1.encoded_fragment().decoded_size());
+    }
+
+    // parse s in the given chunks and
+    // compare with parse_uri_reference
+    static
+    void
+    check(
+        core::string_view s,
+        std::vector<std::size_t> const& cuts)
+    {
+        auto const rv0 = parse_uri_reference(s);
+        url_parser p;
+        std::size_t i = 0;
+        bool ok = true;
+        for(auto cut : cuts)
+        {
+            ok = ok && p.write(
+                s.substr(i, cut - i)).has_value();
+            i = cut;
+        }
+        ok = ok && p.write(s.substr(i)).has_value();
+        if(ok)
+            BOOST_TEST(p.result().error() ==
+                grammar::error::need_more);
+        auto const rv1 = p.finish();
+        BOOST_TEST_EQ(rv0.has_value(), rv1.has_value());
+        BOOST_TEST_EQ(rv1.has_value(), ok && p.is_done());
+        if(rv0 && rv1)
+        {
+            check_eq(*rv0, *rv1);
+            check_eq(*rv0, *p.result());
+        }
+    }
+
+    static
+    void
+    check(core::string_view s)
+    {
+        check(s, {});
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            check(s, {i});
+            for(std::size_t j = i; j <= s.size(); ++j)
+                check(s, {i, j});
+        }
+        std::vector<std::size_t> cuts;
+        for(std::size_t i = 1; i < s.size(); ++i)
+            cuts.push_back(i);
+        check(s, cuts);
+    }
+
+    void
+    testParse()
+    {
+        core::string_view const v[] = {
+            // valid
+            "",
+            "x",
+            "/",
+            "//",
+            "///",
+            "?",
+            "#",
+            "a:",
+            "a:/",
+            "a://",
+            "a:b",
+            "a:b:c",
+            "a+b.c-d:x",
+            "./a:b",
+            "/a:b",
+            "a/b:c",
+            "?a:b",
+            "#a:b",
+            "//host",
+            "//host:",
+            "//host:80",
+            "//@host",
+            "//user@host",
+            "//user:pass@host:8080/path?q#f",
+            "//[::1]/",
+            "//[v1.x]:1",
+            "//1.2.3.4:65535",
+            "//a%20b/c%2F?d%3D#e%25",
+            "http://www.example.com/index.htm?id=1&x=2#top",
+            "https://user@[::ffff:1.2.3.4]:443/a%20b?x=%2F&y&&#f#g",
+            "mailto:someone@example.com",
+            "file:///etc/hosts",
+            "urn:isbn:0451450523",
+            "/path/to/file.txt?k=v&k2=v2",
+            "a//b///c",
+            "http:?q",
+            "http:#f",
+            "http://h?#",
+            "//h#?",
+            "?q=[1]&r=?/",
+            // a relative-ref may have a
+            // segment right after the authority
+            "//host:x",
+            "//host:80x/y?q",
+            "//a@b@c",
+            "//a:b@c:d#f",
+            "//[::1]x",
+
+            // invalid
+            ":",
+            "1a:b",
+            "a%:b",
+            "%41:b",
+            "%",
+            "%4",
+            "%4g",
+            "a b",
+            "/a b",
+            "?q q",
+            "#f f",
+            "#f%",
+            "//host:x:y",
+            "//host:a%2",
+            "//[::1",
+            "http://host:x",
+            "http://a@b@c",
+            "//host\\",
+            "http://h%",
+            "http://h%2",
+            "http://host/%zz",
+            "a:b\"c",
+            "<>",
+            };
+        for(auto s : v)
+            check(s);
+    }
+
+    void
+    testParser()
+    {
+        // write after finish
+        {
+            url_parser p;
+            BOOST_TEST(p.write("/a").has_value());
+            BOOST_TEST(! p.is_done());
+            BOOST_TEST(p.finish().has_value());
+            BOOST_TEST(p.is_done());
+            BOOST_TEST(p.write("b").has_error());
+            BOOST_TEST_EQ(p.finish()->buffer(), "/a");
+        }
+
+        // errors are sticky
+        {
+            url_parser p;
+            BOOST_TEST(p.write("/a ").has_error());
+            BOOST_TEST(p.write("b").has_error());
+            BOOST_TEST(p.result().has_error());
+            BOOST_TEST(p.finish().has_error());
+            p.reset();
+            BOOST_TEST(p.write("b").has_value());
+            BOOST_TEST_EQ(p.finish()->buffer(), "b");
+        }
+
+        // reset
+        {
+            url_parser p(64);
+            BOOST_TEST(p.write("http://a.com/").has_value());
+            BOOST_TEST(p.finish().has_value());
+            p.reset();
+            BOOST_TEST(p.buffer().empty());
+            BOOST_TEST(p.write("//b.com/x?y").has_value());
+            auto rv = p.finish();
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(rv->encoded_host(), "b.com");
+            BOOST_TEST_EQ(rv->encoded_query(), "y");
+        }
+
+        // copies refer to their own buffer
+        {
+            url_parser p0;
+            BOOST_TEST(p0.write("http://a.com/x").has_value());
+            url_parser p1(p0);
+            p0.reset();
+            BOOST_TEST(p0.write("y").has_value());
+            BOOST_TEST_EQ(p1.finish()->buffer(), "http://a.com/x");
+            BOOST_TEST_EQ(p0.finish()->buffer(), "y");
+        }
+
+        // large input
+        {
+            std::string s = "http://example.com/";
+            for(int i = 0; i < 1000; ++i)
+                s += "segment/";
+            s += "?";
+            for(int i = 0; i < 1000; ++i)
+                s += "k=v&";
+            url_parser p;
+            for(std::size_t i = 0; i < s.size(); i += 7)
+                BOOST_TEST(p.write(
+                    core::string_view(s).substr(i, 7)).has_value());
+            auto rv = p.finish();
+            BOOST_TEST(rv.has_value());
+            check_eq(parse_uri_reference(s).value(), *rv);
+        }
+    }
+
+    void
+    testJavadocs()
+    {
+        // url_parser
+        {
+        url_parser p;
+        p.write( "https://www.exa" );
+        p.write( "mple.com/index.h" );
+        p.write( "tm?id=1" );
+        assert( p.result().error() == grammar::error::need_more );
+
+        system::result< url_view > rv = p.finish();
+        assert( rv->encoded_host() == "www.example.com" );
+        assert( rv->encoded_path() == "/index.htm" );
+        }
+
+        // write
+        {
+        url_parser p;
+        assert( p.write( "/path?" ).has_value() );
+        assert( p.write( "%zz" ).has_error() );
+        }
+
+        // finish
+        {
+        url_parser p;
+        p.write( "//example.com" );
+        assert( p.finish()->encoded_host() == "example.com" );
+        }
+
+        // reset
+        {
+        url_parser p;
+        p.write( "/a" );
+        p.finish();
+        p.reset();
+        p.write( "/b" );
+        assert( p.finish()->buffer() == "/b" );
+        }
+    }
+
+    void
+    run()
+    {
+        testParse();
+        testParser();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    url_parser_test,
+    "boost.url.url_parser");
+
+} // urls
+} // boost